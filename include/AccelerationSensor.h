@@ -1,41 +1,113 @@
 #ifndef ACCELERATION_SENSOR_H
 #define ACCELERATION_SENSOR_H
 
-#include <Python.h>
-
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "Device.h"
 
+// 가속도 샘플 1개 (m/s^2, 할당 없는 고정 크기)
+struct AccelerationSample {
+	int64_t timestampUs = 0;	// steady_clock 기준 측정 시각
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	bool activity = false;	// 이 샘플까지 activity 인터럽트가 발생했는지
+};
+
 // Interface for acceleration sensor to allow mocking
 class IAccelerationSensor {
 public:
 	virtual ~IAccelerationSensor() = default;
-	virtual std::vector<float> getAcceleration() = 0;
+
+	// 장치 연결/설정 (실패하면 false)
+	virtual bool open() { return true; }
+
+	// 가장 최근 샘플
+	virtual AccelerationSample getAcceleration() = 0;
+
+	// 센서에 쌓인 샘플을 오래된 순서로 최대 capacity 개 읽음 (기본 구현은 최신 샘플 1개)
+	virtual size_t readSamples(AccelerationSample* samples, size_t capacity);
+
+	// 마지막 호출 이후 움직임(activity)이 감지되었는지
 	virtual bool isMoving() = 0;
 };
 
-// Real implementation of acceleration sensor using Python adafruit_adxl34x
-class RealAccelerationSensor : public IAccelerationSensor {
+// ADXL345 네이티브 드라이버 (/dev/i2c-N ioctl)
+// FIFO 를 stream 모드로 두어 샘플이 센서 안에 쌓이고, 한 번의 I2C_RDWR 트랜잭션으로 여러 개를 읽음
+// 움직임은 센서의 activity 인터럽트(INT_SOURCE, 읽으면 해제) 로 판단하며, 한 번 읽은 activity 를
+// 샘플 스트림(다음으로 읽힌 샘플 1개) 과 isMoving() 이 각자 한 번씩 소비하므로 어느 쪽도 놓치지 않고 남지도 않음
+class Adxl345Sensor : public IAccelerationSensor {
 private:
-	float xAcceleration;
-	float yAcceleration;
-	float zAcceleration;
+	static constexpr int FIFO_DEPTH = 32;
+	static constexpr int ENTRIES_PER_TRANSFER = 16;	// I2C_RDWR 메시지 수 제한 (주소 쓰기 + 읽기 한 쌍씩)
+
+	const std::string busPath;
+	const int address;
+	const int sampleRateHz;
+	const int activityThreshold;	// 62.5mg/LSB
+	int fd;
+	bool pendingActivity;		 // isMoving() 이 아직 소비하지 않은 activity
+	bool unreportedActivity;	// 샘플에 아직 붙이지 않은 activity (FIFO 가 비어 있던 경우)
+	AccelerationSample latest;
+	uint64_t ioErrors;	// 처음 한 번만 출력
+
+	bool writeRegister(uint8_t reg, uint8_t value);
+	bool pollActivity();
+
+protected:
+	// 레지스터 접근 (시험에서 센서 동작을 흉내 낼 수 있도록 재정의 가능)
+	virtual bool isConnected() const { return fd >= 0; }
+	virtual bool readRegisters(uint8_t reg, uint8_t* data, size_t length);
+	virtual int readFifoEntries(AccelerationSample* samples, int count);
 
-	PyObject* pModule;
-	PyObject* pSensorClass;
-	PyObject* pSensorInstance;
+public:
+	Adxl345Sensor(const std::string& busPath = "/dev/i2c-1", int address = 0x53,
+								int sampleRateHz = 100, int activityThreshold = 18);
+	~Adxl345Sensor() override;
+
+	bool open() override;
+	void close();
+
+	AccelerationSample getAcceleration() override;
+	size_t readSamples(AccelerationSample* samples, size_t capacity) override;
+	bool isMoving() override;
+
+	uint64_t getIoErrors() const { return ioErrors; }
+};
 
-	bool initPython();
-	void cleanupPython();
+// 기록된 가속도 궤적을 재생하는 센서 (시험용)
+// 파일 형식: 줄마다 "timestamp_ms,x,y,z[,moving]" (# 주석, 숫자가 아닌 헤더 줄은 무시)
+// moving 열이 없으면 ADXL345 의 DC activity 판정과 같은 기준(축 하나라도 임계값 초과) 으로 계산
+// realtime 이면 open() 이후 경과 시간만큼만 샘플을 내보내고, 아니면 호출마다 다음 샘플을 바로 내보냄
+class ReplayAccelerationSensor : public IAccelerationSensor {
+private:
+	const std::string path;
+	const bool realtime;
+	const bool loop;
+	std::vector<AccelerationSample> trace;
+	size_t position;
+	int64_t loopOffsetUs;	 // 반복 재생 시 타임스탬프가 계속 증가하도록 더하는 값
+	std::chrono::steady_clock::time_point startedAt;
+	bool pendingActivity;
+	AccelerationSample latest;
+
+	bool nextSample(AccelerationSample& sample);
 
 public:
-	RealAccelerationSensor();
-	~RealAccelerationSensor() override;
+	ReplayAccelerationSensor(const std::string& path, bool realtime = true, bool loop = true);
+
+	bool open() override;
 
-	std::vector<float> getAcceleration() override;
+	AccelerationSample getAcceleration() override;
+	size_t readSamples(AccelerationSample* samples, size_t capacity) override;
 	bool isMoving() override;
+
+	size_t getTraceLength() const { return trace.size(); }
 };
 
 // Mock implementation remains the same
@@ -52,7 +124,7 @@ public:
 	MockAccelerationSensor();
 	~MockAccelerationSensor() override;
 
-	std::vector<float> getAcceleration() override;
+	AccelerationSample getAcceleration() override;
 	bool isMoving() override;
 
 	// Additional methods for testing
@@ -60,20 +132,26 @@ public:
 	void setAcceleration(float x, float y, float z);
 };
 
-// AccelerationSensor class remains the same
+// 가속도 센서 장치
+// useMock 이 아니면 ACCEL_SOURCE 로 공급원 선택: 비어 있거나 "i2c" 면 ADXL345 (버스는 ACCEL_I2C_BUS),
+// 그 외 값은 재생할 궤적 파일 경로
 class AccelerationSensor : public Device {
 private:
 	std::unique_ptr<IAccelerationSensor> sensor;
 	bool useMock;
 
+	static std::unique_ptr<IAccelerationSensor> createSensor();
+
 public:
 	AccelerationSensor(bool useMock = false);
+	explicit AccelerationSensor(std::unique_ptr<IAccelerationSensor> sensor);
 	~AccelerationSensor() override;
 
 	void initialize() override;
 
 	bool isMoving();
-	std::vector<float> getAcceleration();
+	AccelerationSample getAcceleration();
+	size_t readSamples(AccelerationSample* samples, size_t capacity);
 };
 
-#endif	// ACCELERATION_SENSOR_H
\ No newline at end of file
+#endif	// ACCELERATION_SENSOR_H
@@ -0,0 +1,147 @@
+#ifndef BACKEND_CLIENT_H
+#define BACKEND_CLIENT_H
+
+#include <cpr/cpr.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 요청을 보낼 서버
+enum class BackendServer {
+	Backend,	// SERVER_IP (장치 상태, 졸음 근거 영상, 인증 필요)
+	AiServer	// AI_SERVER_IP (프레임 전송, 졸음 진단)
+};
+
+// 엔드포인트별 요청 정책
+struct BackendEndpoint {
+	std::string name;	// 세션 풀 키 (같은 형태의 요청끼리만 연결 재사용)
+	BackendServer server;
+	std::string path;
+	std::chrono::milliseconds timeout;
+	int maxAttempts;												// 통신 오류/5xx/429 일 때 총 시도 횟수
+	std::chrono::milliseconds retryDelay;	// 재시도 간격 (시도마다 두 배)
+};
+
+namespace BackendEndpoints {
+// 장치 상태는 다음 보고 때 다시 보내므로 한 번만 재시도
+inline const BackendEndpoint DeviceStatus{"device-status", BackendServer::Backend, "/vehicles/status",
+																					std::chrono::milliseconds(5000), 2,
+																					std::chrono::milliseconds(500)};
+// 근거 영상 재전송은 업로드 대기함의 백오프가 담당
+inline const BackendEndpoint EvidenceUpload{"evidence-upload", BackendServer::Backend, "/sleep",
+																						std::chrono::milliseconds(10000), 1,
+																						std::chrono::milliseconds(0)};
+// 진단은 응답 기한이 있으므로 재시도하지 않음
+inline const BackendEndpoint Diagnosis{"diagnosis", BackendServer::AiServer, "/diagnosis/drowsiness",
+																			 std::chrono::milliseconds(2000), 1, std::chrono::milliseconds(0)};
+// 실시간 프레임은 다음 프레임이 곧 오므로 재시도하지 않음
+inline const BackendEndpoint DriverFrame{"driver-frame", BackendServer::AiServer, "/save/frame",
+																				 std::chrono::milliseconds(5000), 1,
+																				 std::chrono::milliseconds(0)};
+inline const BackendEndpoint DriverFrameBatch{"driver-frame-batch", BackendServer::AiServer,
+																							"/save/frames", std::chrono::milliseconds(5000), 1,
+																							std::chrono::milliseconds(0)};
+}	 // namespace BackendEndpoints
+
+// 백엔드 요청 통계
+struct BackendClientStats {
+	uint64_t requests;
+	uint64_t retries;
+	uint64_t failures;					// 마지막 시도까지 통신 오류/5xx 인 요청
+	uint64_t sessionsCreated;		// 새 연결(TLS 핸드셰이크)이 필요했던 세션 수
+	uint64_t sessionsReused;
+	uint64_t asyncDropped;			// 비동기 대기열이 가득 차 버린 요청
+};
+
+// 모든 서버 통신을 담당하는 공용 HTTP 클라이언트 (싱글톤)
+// 서버 주소/장치 UID/인증 해시는 시작 시 한 번만 읽고, 엔드포인트별 keep-alive 세션을 풀에 보관해
+// 요청마다 새 TLS 연결을 맺지 않음 (지원되는 경우 HTTPS 는 HTTP/2 로 협상)
+// 동기 요청은 호출 스레드에서, 비동기 요청은 내부 워커 스레드에서 처리
+class BackendClient {
+public:
+	using Callback = std::function<void(const cpr::Response&)>;
+
+	static BackendClient& getInstance();
+
+	// 환경 변수에서 설정을 다시 읽음 (DEVICE_UID 등을 설정한 뒤 호출)
+	void reloadConfig();
+	bool isConfigured(BackendServer server) const;
+	std::string getDeviceUid() const;
+
+	// 동기 요청 (query 는 인코딩된 "key=value&..." 문자열)
+	cpr::Response get(const BackendEndpoint& endpoint, const std::string& query = "");
+	cpr::Response post(const BackendEndpoint& endpoint, std::string body,
+										 const std::string& contentType);
+	cpr::Response post(const BackendEndpoint& endpoint, const cpr::Multipart& multipart);
+	cpr::Response patch(const BackendEndpoint& endpoint, std::string body,
+											const std::string& contentType);
+
+	// 비동기 POST (대기열이 가득 차면 가장 오래된 요청을 버림). 콜백은 워커 스레드에서 호출
+	void postAsync(const BackendEndpoint& endpoint, std::string body, const std::string& contentType,
+								 Callback callback = nullptr);
+
+	BackendClientStats getStats() const;
+	void logStats() const;
+
+	BackendClient(const BackendClient&) = delete;
+	BackendClient& operator=(const BackendClient&) = delete;
+
+private:
+	static const size_t MAX_IDLE_SESSIONS = 4;	// 엔드포인트별 보관 세션 수
+	static const int ASYNC_WORKER_COUNT = 2;
+	static const size_t MAX_ASYNC_PENDING = 16;
+
+	struct Config {
+		std::string serverIp;
+		std::string aiServerIp;
+		std::string deviceUid;
+		std::string authHash;
+	};
+
+	enum class Method { Get, Post, Patch };
+
+	BackendClient();
+	~BackendClient();
+
+	Config loadConfig() const;
+	std::unique_ptr<cpr::Session> acquireSession(const BackendEndpoint& endpoint);
+	void releaseSession(const BackendEndpoint& endpoint, std::unique_ptr<cpr::Session> session);
+
+	// 세션을 빌려 요청 구성 후 정책에 따라 재시도
+	cpr::Response perform(const BackendEndpoint& endpoint, Method method, const std::string& query,
+												const std::function<void(cpr::Session&)>& setBody,
+												const std::string& contentType);
+	static bool shouldRetry(const cpr::Response& response);
+	void asyncLoop();
+
+	mutable std::mutex configMutex;
+	Config config;
+
+	std::mutex poolMutex;
+	std::map<std::string, std::vector<std::unique_ptr<cpr::Session>>> idleSessions;
+
+	std::mutex asyncMutex;
+	std::condition_variable asyncCondition;
+	std::deque<std::function<void()>> asyncQueue;
+	std::vector<std::thread> asyncWorkers;
+	bool terminate;
+
+	std::atomic<uint64_t> requestCount;
+	std::atomic<uint64_t> retryCount;
+	std::atomic<uint64_t> failureCount;
+	std::atomic<uint64_t> sessionsCreated;
+	std::atomic<uint64_t> sessionsReused;
+	std::atomic<uint64_t> asyncDropped;
+};
+
+#endif	// BACKEND_CLIENT_H
@@ -0,0 +1,23 @@
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// base64 인코딩 결과 길이 (패딩 포함)
+inline size_t base64EncodedSize(size_t inputSize) {
+	return (inputSize + 2) / 3 * 4;
+}
+
+// output 에 base64EncodedSize(inputSize) 바이트를 기록 (널 문자는 붙이지 않음)
+// ARM(aarch64) 은 NEON, x86 은 SSSE3(실행 시 확인) 로 48/12 바이트씩 처리하고 나머지는 테이블로 처리
+void base64Encode(const uint8_t* input, size_t inputSize, char* output);
+
+// output 뒤에 base64 문자열을 이어 붙임 (필요한 크기만큼 한 번만 늘림)
+void base64Append(const uint8_t* input, size_t inputSize, std::string& output);
+
+// 사용 중인 구현 이름 ("neon", "ssse3", "scalar")
+const char* base64Implementation();
+
+#endif	// BASE64_H
@@ -0,0 +1,202 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// 큐가 가득 찼을 때의 처리 방식
+enum class DropPolicy {
+	DropNewest,	 // 새로 들어온 항목을 버림
+	DropOldest	 // 가장 오래된 항목을 버리고 새 항목을 저장 (최신 프레임 우선)
+};
+
+// 파이프라인 단계별 큐 상태 (모니터링용)
+struct QueueStats {
+	std::string name;
+	size_t depth;
+	size_t capacity;
+	uint64_t pushed;
+	uint64_t popped;
+	uint64_t dropped;
+};
+
+// 고정 크기 lock-free MPMC 링 버퍼 (Dmitry Vyukov 방식)
+// push/pop 경로는 락을 잡지 않으며, 소비자가 잠들 때만 condition_variable 사용
+template <typename T>
+class BoundedQueue {
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	const std::string name;
+	const DropPolicy policy;
+	const size_t mask;
+	std::unique_ptr<Cell[]> buffer;
+
+	alignas(64) std::atomic<size_t> enqueuePos;
+	alignas(64) std::atomic<size_t> dequeuePos;
+
+	std::atomic<uint64_t> pushedCount;
+	std::atomic<uint64_t> poppedCount;
+	std::atomic<uint64_t> droppedCount;
+
+	// 빈 큐에서 대기하는 소비자 깨우기용
+	std::mutex waitMutex;
+	std::condition_variable waitCondition;
+	std::atomic<int> waiters;
+
+	static size_t roundUpToPowerOfTwo(size_t value) {
+		size_t result = 2;
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+	bool tryPush(T& item) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell& cell = buffer[pos & mask];
+			size_t seq = cell.sequence.load(std::memory_order_acquire);
+			intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					cell.data = std::move(item);
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				return false;	 // 가득 참
+			} else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void notifyWaiters() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters.load(std::memory_order_relaxed) > 0) {
+			std::lock_guard<std::mutex> lock(waitMutex);
+			waitCondition.notify_one();
+		}
+	}
+
+public:
+	BoundedQueue(const std::string& queueName, size_t capacity, DropPolicy dropPolicy)
+			: name(queueName),
+				policy(dropPolicy),
+				mask(roundUpToPowerOfTwo(capacity) - 1),
+				buffer(new Cell[mask + 1]),
+				enqueuePos(0),
+				dequeuePos(0),
+				pushedCount(0),
+				poppedCount(0),
+				droppedCount(0),
+				waiters(0) {
+		for (size_t i = 0; i <= mask; ++i) {
+			buffer[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+	// 항목 추가. 드롭 정책에 따라 항목이 버려졌으면 false 반환
+	bool push(T item) {
+		pushedCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (tryPush(item)) {
+			notifyWaiters();
+			return true;
+		}
+
+		if (policy == DropPolicy::DropNewest) {
+			droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// DropOldest: 가장 오래된 항목을 꺼내 버리고 다시 시도 (경쟁 시 몇 번만 재시도)
+		for (int attempt = 0; attempt < 4; ++attempt) {
+			T oldest;
+			if (tryPop(oldest)) {
+				poppedCount.fetch_sub(1, std::memory_order_relaxed);
+				droppedCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (tryPush(item)) {
+				notifyWaiters();
+				return false;
+			}
+		}
+
+		droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	bool tryPop(T& item) {
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell& cell = buffer[pos & mask];
+			size_t seq = cell.sequence.load(std::memory_order_acquire);
+			intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					item = std::move(cell.data);
+					cell.data = T();
+					cell.sequence.store(pos + mask + 1, std::memory_order_release);
+					poppedCount.fetch_add(1, std::memory_order_relaxed);
+					return true;
+				}
+			} else if (diff < 0) {
+				return false;	 // 비어 있음
+			} else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// 항목이 들어올 때까지 최대 timeout 동안 대기
+	bool popWait(T& item, std::chrono::milliseconds timeout) {
+		if (tryPop(item)) {
+			return true;
+		}
+
+		std::unique_lock<std::mutex> lock(waitMutex);
+		waiters.fetch_add(1, std::memory_order_seq_cst);
+		bool result = waitCondition.wait_for(lock, timeout, [this, &item] { return tryPop(item); });
+		waiters.fetch_sub(1, std::memory_order_relaxed);
+		return result;
+	}
+
+	// 종료 시 대기 중인 소비자를 모두 깨움
+	void wakeAll() {
+		std::lock_guard<std::mutex> lock(waitMutex);
+		waitCondition.notify_all();
+	}
+
+	size_t size() const {
+		size_t enq = enqueuePos.load(std::memory_order_relaxed);
+		size_t deq = dequeuePos.load(std::memory_order_relaxed);
+		return enq > deq ? enq - deq : 0;
+	}
+
+	size_t capacity() const { return mask + 1; }
+
+	QueueStats getStats() const {
+		return {name,
+						size(),
+						capacity(),
+						pushedCount.load(std::memory_order_relaxed),
+						poppedCount.load(std::memory_order_relaxed),
+						droppedCount.load(std::memory_order_relaxed)};
+	}
+};
+
+#endif	// BOUNDED_QUEUE_H
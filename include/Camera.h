@@ -1,23 +1,40 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include <chrono>
+#include <memory>
 #include <opencv2/opencv.hpp>
 #include <string>
 
+#include "CaptureSource.h"
 #include "Device.h"
 
 class Camera : public Device {
 private:
-	cv::VideoCapture cap;
-	std::vector<int> resolution;
+	std::unique_ptr<CaptureSource> source;
+	std::vector<int> resolution;					// 판별용 스트림 해상도
+	std::vector<int> evidenceResolution;	// 근거 영상용 스트림 해상도
 	std::string cameraName;
-	std::string gstreamerPipeline;
+	int framerate;
+
+	// CAMERA_SOURCE 가 설정되어 있으면 해당 파일/장치를 반복 재생, 아니면 카메라 사용
+	std::unique_ptr<CaptureSource> createSource() const;
 
 public:
 	Camera();
 	~Camera();
 
 	void initialize() override;
+
+	// 파이프라인용 캡처 (가능하면 캡처 버퍼를 복사하지 않은 뷰, frame.owner 가 버퍼를 붙잡음)
+	// 다음 프레임이 도착하면 바로 반환하고, timeout 안에 도착하지 않으면 실패
+	bool capture(CapturedFrame& frame,
+							 std::chrono::milliseconds timeout = CaptureSource::DEFAULT_READ_TIMEOUT);
+
+	// 카메라가 프레임 주기를 정하는지 (파일 재생이면 호출하는 쪽이 주기를 맞춤)
+	bool isLive() const;
+
+	// 호출자가 소유하는 프레임 (뷰였다면 복사)
 	cv::Mat captureFrame();
 	void setCameraStatus(bool status);
 	bool getCameraStatus() const;
@@ -25,4 +42,4 @@ public:
 	std::vector<int> getResolution() const;
 };
 
-#endif	// CAMERA_H
\ No newline at end of file
+#endif	// CAMERA_H
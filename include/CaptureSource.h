@@ -0,0 +1,116 @@
+#ifndef CAPTURE_SOURCE_H
+#define CAPTURE_SOURCE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+
+// 캡처된 프레임 1장
+// image/evidence 는 캡처 버퍼를 직접 가리키는 뷰일 수 있으며, owner 의 마지막 참조가 사라질 때 버퍼가 반환됨
+struct CapturedFrame {
+	cv::Mat image;								 // 판별용 영상 (GStreamer 경로는 Y 평면 = 그레이스케일)
+	cv::Mat evidence;							 // 근거 영상용 NV12 프레임 (두 스트림 중 근거 프레임을 놓치면 비어 있음)
+	std::shared_ptr<void> owner;	 // 캡처 버퍼 소유권 (복사된 프레임이면 비어 있음)
+	int64_t sensorTimestampNs = 0;	// 파이프라인 기준 버퍼 타임스탬프
+};
+
+// 카메라 프레임 공급원
+class CaptureSource {
+public:
+	static constexpr std::chrono::milliseconds DEFAULT_READ_TIMEOUT{1000};
+
+	virtual ~CaptureSource() = default;
+	virtual bool open() = 0;
+	virtual void close() = 0;
+	virtual bool isOpened() const = 0;
+	// 다음 프레임이 도착할 때까지 최대 timeout 대기 (시간 제한을 지원하지 않는 공급원은 읽기가 끝날 때까지)
+	virtual bool read(CapturedFrame& frame, std::chrono::milliseconds timeout) = 0;
+	bool read(CapturedFrame& frame) { return read(frame, DEFAULT_READ_TIMEOUT); }
+	// 카메라처럼 스스로 프레임 주기에 맞춰 프레임을 내보내는지 (파일 재생은 읽는 쪽이 속도를 맞춰야 함)
+	virtual bool isLive() const = 0;
+	virtual std::string describe() const = 0;
+};
+
+// cv::VideoCapture 기반 공급원 (영상 파일/이미지 시퀀스 반복 재생, 또는 OpenCV GStreamer 파이프라인)
+// 카메라 없이 파이프라인을 시험하는 용도와 GStreamer 개발 패키지가 없는 빌드의 대체 경로
+class VideoCaptureSource : public CaptureSource {
+private:
+	const std::string location;
+	const int apiPreference;
+	const bool loop;	// 파일 끝에 도달하면 처음부터 다시 재생
+	cv::VideoCapture cap;
+	int64_t frameCount;
+	bool live;	// 전체 프레임 수를 알 수 없으면 장치/파이프라인으로 봄
+
+public:
+	VideoCaptureSource(const std::string& location, int apiPreference = cv::CAP_ANY,
+										 bool loop = true);
+	using CaptureSource::read;
+	bool open() override;
+	void close() override;
+	bool isOpened() const override;
+	bool read(CapturedFrame& frame, std::chrono::milliseconds timeout) override;
+	bool isLive() const override { return live && cap.isOpened(); }
+	std::string describe() const override;
+};
+
+#ifdef USE_GSTREAMER
+typedef struct _GstElement GstElement;
+
+typedef struct _GstSample GstSample;
+
+// GStreamer appsink 에서 직접 버퍼를 받아 복사 없이 cv::Mat 뷰로 감싸는 공급원
+// 카메라가 기본 출력하는 NV12 를 그대로 받아 Y 평면을 판별용 그레이스케일 영상으로 사용 (색 변환 없음)
+// 파이프라인에 "evidence" appsink 가 있으면 ISP 가 함께 출력한 고해상도 스트림을 근거 영상으로 사용하고,
+// 같은 요청에서 나온 버퍼끼리 타임스탬프로 짝을 맞춤
+// 파이프라인에 있는 버퍼 수가 한정되어 있으므로, 반환되지 않은 버퍼가 maxOutstanding 개를 넘으면
+// 해당 프레임은 복사 후 즉시 반환하여 캡처가 멈추지 않도록 함
+// (libcamera 버퍼 4 개 중 2 개는 카메라가 채우는 중이어야 하므로 기본 2 개. 펌웨어는 전처리/저장이
+// 끝나는 즉시 버퍼를 놓으므로 평소에는 캡처 중인 프레임과 저장 중인 프레임만 남음)
+class GstCaptureSource : public CaptureSource {
+private:
+	static const int64_t TIMESTAMP_TOLERANCE_NS = 5000000;	// 같은 프레임으로 보는 타임스탬프 차이
+
+	const std::string pipelineDescription;	// 판별용 appsink 이름은 "sink"
+	const int maxOutstanding;
+	GstElement* pipeline;
+	GstElement* sink;
+	GstElement* evidenceSink;			// 없으면 단일 스트림
+	GstSample* pendingEvidence;		// 판별 프레임보다 앞서 도착한 근거 프레임
+	// 버퍼 반환이 소스 종료 이후일 수 있으므로 공유
+	std::shared_ptr<std::atomic<int>> outstanding;
+	std::shared_ptr<std::atomic<int>> evidenceOutstanding;
+
+	uint64_t zeroCopyFrames;
+	uint64_t copiedFrames;
+	uint64_t unmatchedFrames;	 // 짝이 되는 근거 프레임이 없던 판별 프레임
+
+	GstSample* pullMatchingEvidence(int64_t timestampNs);
+
+public:
+	explicit GstCaptureSource(const std::string& pipelineDescription, int maxOutstanding = 2);
+	~GstCaptureSource() override;
+
+	// libcamerasrc 에서 NV12 를 요청하는 기본 파이프라인
+	// evidenceSize 가 비어 있지 않으면 같은 센서에서 판별용/근거용 두 스트림을 ISP 로 동시에 출력
+	static std::string libcameraPipeline(const std::string& cameraName, const cv::Size& analysisSize,
+																			 const cv::Size& evidenceSize, int framerate);
+
+	using CaptureSource::read;
+	bool open() override;
+	void close() override;
+	bool isOpened() const override;
+	bool read(CapturedFrame& frame, std::chrono::milliseconds timeout) override;
+	bool isLive() const override { return sink != nullptr; }
+	std::string describe() const override;
+
+	uint64_t getZeroCopyFrames() const { return zeroCopyFrames; }
+	uint64_t getCopiedFrames() const { return copiedFrames; }
+	uint64_t getUnmatchedFrames() const { return unmatchedFrames; }
+};
+#endif
+
+#endif	// CAPTURE_SOURCE_H
@@ -1,33 +1,35 @@
 #ifndef DBTHREAD_H
 #define DBTHREAD_H
 
+#include <memory>
 #include <string>
-#include <filesystem>
 #include <vector>
 #include <opencv2/core.hpp> 
+#include "SleepinessEvidence.h"
+#include "UploadOutbox.h"
 #include "VideoEncoder.h"
 
 class DBThreadMonitoring;
 
 class DBThread {
 private:
-    std::filesystem::file_time_type time;
     std::string deviceUid;
-    std::string folderPath;
+    std::shared_ptr<SleepinessEvidence> evidence;
     DBThreadMonitoring* monitoring;
 
-    void deleteFolderSafe(const std::string& path);
-
 public:
-    DBThread(const std::string& uid, const std::string& folder, DBThreadMonitoring* monitor);
+    DBThread(const std::string& uid, std::shared_ptr<SleepinessEvidence> evidence,
+             DBThreadMonitoring* monitor);
     ~DBThread();
     bool sendDataToDB();
-    bool sendVideoToBackend(const std::vector<uchar>& videoData);
     void setIsDBThreadRunningFalse();
-    std::string getDetectedAtFromFolder() const;
+    std::string getDetectedAt() const;
+
+    // 업로드 대기함의 영상 1건을 백엔드로 1회 전송 (재시도는 대기함의 백오프에 맡김)
+    static UploadResult uploadVideo(const OutboxEntry& entry, const std::vector<uchar>& videoData);
 
     const std::string& getDeviceUid() const { return deviceUid; }
-    const std::string& getFolderPath() const { return folderPath; }
+    const std::string& getEvidenceId() const { return evidence->getId(); }
 };
 
 #endif
@@ -9,33 +9,116 @@
 #include <string>
 #include <atomic>
 #include <memory>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "UploadOutbox.h"
 
 class DBThread;
 
+// 업로드 작업 우선순위 (값이 클수록 먼저 처리)
+// AI 진단 요청은 기한 내 응답이 필요해 DiagnosisClient 전용 스레드에서 보내므로 풀을 거치지 않음
+enum class UploadPriority {
+    Telemetry = 0,  // 장치 상태 등 유실되어도 다음 주기에 다시 보내는 데이터
+    Evidence = 1    // 졸음 근거 영상 (종료 시에도 끝까지 처리)
+};
+
+// 우선순위별 업로드 작업 통계 (모니터링용)
+struct UploadPoolStats {
+    UploadPriority priority;
+    size_t pending;
+    uint64_t completed;
+    uint64_t dropped;
+    double averageWaitMs;      // 큐 대기 시간
+    double maxWaitMs;
+    double averageDurationMs;  // 작업 수행 시간
+    double maxDurationMs;
+};
+
+// 백엔드 업로드 워커 풀
+// 고정 개수의 워커 스레드가 우선순위 큐에서 작업을 꺼내 처리함 (작업마다 스레드를 만들지 않음)
 class DBThreadMonitoring {
 private:
+    static const int WORKER_COUNT = 2;
+    static const int PRIORITY_COUNT = 2;
+    // 우선순위별 대기 작업 한도 (상태 작업이 밀려도 근거 영상 작업 자리는 남도록 따로 셈)
+    static constexpr size_t MAX_PENDING_JOBS[PRIORITY_COUNT] = {8, 16};
+
+    struct UploadJob {
+        UploadPriority priority;
+        uint64_t sequence;  // 같은 우선순위 안에서는 먼저 들어온 작업부터
+        std::chrono::steady_clock::time_point enqueuedAt;
+        std::string name;
+        std::function<void()> work;
+    };
+
+    struct UploadJobOrder {
+        bool operator()(const UploadJob& a, const UploadJob& b) const {
+            if (a.priority != b.priority) {
+                return a.priority < b.priority;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    struct PriorityMetrics {
+        uint64_t completed = 0;
+        uint64_t dropped = 0;
+        double totalWaitMs = 0.0;
+        double maxWaitMs = 0.0;
+        double totalDurationMs = 0.0;
+        double maxDurationMs = 0.0;
+    };
+
     std::atomic<bool> isDBThreadRunning = false;
-    std::atomic<bool> terminate = false;
+    bool terminate = false;
 
-    std::queue<std::shared_ptr<DBThread>> threadQueue;
+    std::priority_queue<UploadJob, std::vector<UploadJob>, UploadJobOrder> jobQueue;
     std::unordered_set<std::string> activeThreadKeys;
-    std::mutex queueMutex;
+    uint64_t jobSequence = 0;
+    size_t pendingCounts[PRIORITY_COUNT] = {0, 0};
+    PriorityMetrics metrics[PRIORITY_COUNT];
+    mutable std::mutex queueMutex;
     std::condition_variable condition;
-    std::thread monitoringThread;
+    std::vector<std::thread> workerThreads;
 
-    void processThreadQueue();
-    std::string generateThreadKey(const std::string& deviceUid, const std::string& folderPath);
+    // 졸음 근거 영상 업로드 대기함 (전송 시각이 되면 워커 풀에 전송 작업을 넣음)
+    UploadOutbox outbox;
+    std::thread outboxThread;
+    std::condition_variable outboxCondition;
+    bool outboxDrainScheduled = false;
+    bool outboxStateChanged = false;  // 새 영상/전송 완료 알림 (queueMutex 로 보호, 알림 유실 방지)
+
+    void workerLoop();
+    void outboxLoop();
+    void drainOutbox();
+    std::string generateThreadKey(const std::string& deviceUid, const std::string& evidenceId);
 
 public:
-    DBThreadMonitoring();
+    DBThreadMonitoring(const std::string& outboxDirectory = "./frames/outbox");
     ~DBThreadMonitoring();
     void startDBMonitoring();
+
+    // 진행 중인 작업은 끝까지 처리하고, 시작하지 않은 상태 작업은 버린 뒤 워커 종료
+    // 전송하지 못한 근거 영상은 업로드 대기함에 남아 다음 부팅 때 이어서 전송
+    void shutdown();
+
+    // 작업 추가 (종료 중이거나 같은 우선순위의 대기 작업이 가득 차면 false)
+    bool submitJob(UploadPriority priority, const std::string& name, std::function<void()> work);
     void addDBThread(std::shared_ptr<DBThread> thread);
+
+    // 인코딩된 근거 영상을 업로드 대기함에 저장하고 전송 예약
+    bool enqueueEvidence(const std::string& id, const std::string& detectedAt,
+                         const std::string& checksum, std::vector<uchar> video);
     void removeActiveThread(const std::string& key);
 
     bool getIsDBThreadRunning() const;
     void setIsDBThreadRunning(bool value);
-    
+
+    std::vector<UploadPoolStats> getStats() const;
+    void logStats() const;
 };
 
 #endif
@@ -0,0 +1,95 @@
+#ifndef DIAGNOSIS_CLIENT_H
+#define DIAGNOSIS_CLIENT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 파이프라인으로 전달되는 진단 결과 1건
+struct DiagnosisResult {
+	std::string timestamp;		 // 진단 요청 시각 yyyyMMdd_HHmmss_fff (근거 영상 id)
+	int64_t requestedAtMs = 0;	// 진단 요청 시각 (steady_clock 밀리초, 근거 영상 구간 계산용)
+	bool success = false;			 // false 면 서버 결과가 없으므로 로컬 판별로 대체
+	bool isDrowsy = false;
+	std::string message;
+};
+
+// 진단 요청 통계 (지연 백분위는 최근 응답 기준)
+struct DiagnosisStats {
+	uint64_t requested;
+	uint64_t skipped;					// 이전 요청 응답 대기 중이라 보내지 않은 요청
+	uint64_t failed;					// 통신/서버 오류 응답
+	uint64_t deadlineMissed;	// 기한 내 응답이 없어 로컬 판별로 대체한 요청
+	uint64_t late;						// 로컬 판별 이후 도착해 버린 응답
+	double p50Ms;
+	double p90Ms;
+	double p99Ms;
+	double maxMs;
+};
+
+// AI 서버 졸음 진단 비동기 클라이언트
+// 전용 요청 스레드 하나가 공용 BackendClient 로 요청을 보내므로 동시에 하나의 요청만 진행되고,
+// 결과는 poll() 을 호출하는 파이프라인 스레드에서 꺼내 처리함
+// 응답이 기한(deadline) 안에 오지 않으면 HTTP 타임아웃을 기다리지 않고 바로 실패 결과를 전달함
+class DiagnosisClient {
+private:
+	static const size_t LATENCY_SAMPLE_COUNT = 256;
+
+	struct PendingRequest {
+		std::string timestamp;
+		int64_t requestedAtMs = 0;
+		std::chrono::steady_clock::time_point sentAt;
+	};
+
+	const std::chrono::milliseconds deadline;
+	std::string query;	// deviceUid 쿼리 (초기화 시 구성)
+
+	mutable std::mutex clientMutex;
+	std::condition_variable requestCondition;
+	std::thread requestThread;
+	bool terminate;
+
+	PendingRequest current;
+	bool hasRequest;				 // 요청 스레드가 아직 가져가지 않은 요청
+	bool inFlight;					 // 응답(또는 타임아웃)을 기다리는 요청이 있음
+	bool resultDelivered;		 // current 결과를 이미 파이프라인에 넘김 (기한 초과 포함)
+	std::deque<DiagnosisResult> completed;
+
+	// 통계 (clientMutex 로 보호)
+	uint64_t requestedCount;
+	uint64_t skippedCount;
+	uint64_t failedCount;
+	uint64_t deadlineMissedCount;
+	uint64_t lateCount;
+	std::vector<double> latencySamples;	// 최근 응답 왕복 시간 (원형 버퍼)
+	size_t latencyNext;
+
+	void requestLoop();
+	DiagnosisResult performRequest(const PendingRequest& request);
+	static DiagnosisResult makeFailure(const PendingRequest& request, const std::string& message);
+
+public:
+	DiagnosisClient(std::chrono::milliseconds deadline = std::chrono::milliseconds(800));
+	~DiagnosisClient();
+
+	// 서버 설정 확인 후 요청 스레드 시작
+	bool initialize();
+	void shutdown();
+
+	// 진단 요청 (이전 요청이 진행 중이면 보내지 않고 false)
+	// 초기화되지 않았거나 이전 요청이 이미 기한을 넘긴 경우 실패 결과를 바로 전달해 로컬 판별로 넘어가게 함
+	bool request(const std::string& timestamp, int64_t requestedAtMs);
+
+	// 파이프라인 스레드에서 주기적으로 호출. 전달할 결과가 있으면 true
+	bool poll(DiagnosisResult& result);
+
+	DiagnosisStats getStats() const;
+	void logStats() const;
+};
+
+#endif	// DIAGNOSIS_CLIENT_H
@@ -0,0 +1,104 @@
+#ifndef EAR_CALIBRATOR_H
+#define EAR_CALIBRATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 운전자별 EAR 분포 (저장/복원 단위)
+struct EarProfile {
+	std::string driverId;
+	float openEar = 0.0f;		 // 눈 뜬 상태 EAR 중심
+	float closedEar = 0.0f;	 // 눈 감은 상태 EAR 중심
+	float threshold = 0.0f;	 // 두 중심의 중간값
+	uint64_t samples = 0;		 // 지금까지 반영된 EAR 표본 수
+	float baselineOpenEar = 0.0f;		 // 최초 보정 시 중심 (주행 간 적응은 이 값 ± MAX_DRIFT 안에서만)
+	float baselineClosedEar = 0.0f;
+};
+
+// 운전자별 적응형 EAR 임계값
+// 주행 초반 calibrationMs 동안 얼굴이 검출된 프레임의 EAR 을 모아 2-means 로 뜬 눈/감은 눈 중심을 구하고
+// (python/eye_closed_detection/detectBlink.py::initialize_adaptive_ear 와 같은 중간값 임계값),
+// 주행 중에는 임계값을 고정하고 1분 구간별 평균만 모았다가 주행 종료(endTrip) 시 한 번 중심을 옮김
+// 졸음으로 EAR 이 서서히 내려가는 것을 학습하지 않도록 졸음 신호가 있던 구간은 버리고,
+// 주행 중 EAR 이 한 방향으로 흘러간 주행은 반영하지 않으며, 최초 보정값에서 MAX_DRIFT 이상 벗어나지 않음
+// 운전자별 프로필을 파일로 저장해 다음 주행에서는 보정 없이 바로 사용
+// 보정이 끝나기 전이나 두 분포가 구분되지 않으면 기본 임계값 사용
+class EarCalibrator {
+private:
+	static constexpr float DEFAULT_THRESHOLD = 0.25f;
+	static constexpr float MIN_THRESHOLD = 0.12f;
+	static constexpr float MAX_THRESHOLD = 0.35f;
+	static constexpr float MIN_SEPARATION = 0.05f;	// 뜬 눈/감은 눈 중심의 최소 차이
+	static const size_t MAX_CALIBRATION_SAMPLES = 8192;
+
+	// 주행 간 적응
+	static const int64_t ADAPT_WINDOW_MS = 60000;					// 구간 평균 단위
+	// 구간 평균을 쓸 최소 관측 시간 (표본 수가 아닌 시간 기준이라 처리 모드별 캡처 fps 와 무관)
+	static const int64_t MIN_WINDOW_OPEN_MS = 25000;			// 뜬 눈으로 관측된 시간
+	static const int64_t MIN_WINDOW_CLOSED_MS = 400;			// 감은 눈으로 관측된 시간
+	static constexpr int64_t MAX_SAMPLE_SPAN_MS = 500;	// 표본 1개가 대표하는 최대 시간 (긴 공백 제외)
+	static const size_t MIN_TRIP_WINDOWS = 5;							// 주행 종료 시 적응에 필요한 구간 수
+	static const size_t MAX_TRIP_WINDOWS = 600;
+	static constexpr float TRIP_ADAPT_RATE = 0.25f;				// 주행 1회에 중앙값 쪽으로 옮기는 비율
+	static constexpr float MAX_DRIFT = 0.03f;							// 최초 보정 중심에서 벗어날 수 있는 한계
+	static constexpr float MAX_TRIP_TREND = 0.015f;				// 주행 앞/뒤 1/3 구간 평균 차이 허용치
+
+	const std::string profilePath;
+	const int64_t calibrationMs;
+	const size_t minCalibrationSamples;
+
+	mutable std::mutex calibratorMutex;
+	EarProfile profile;
+	bool calibrated;
+	std::vector<float> calibrationSamples;
+	int64_t calibrationStartMs;
+
+	// 이번 주행의 1분 구간 누적값
+	struct AdaptWindow {
+		int64_t startMs = -1;
+		int64_t lastSampleMs = -1;
+		double openSum = 0.0;
+		double closedSum = 0.0;
+		size_t openCount = 0;
+		size_t closedCount = 0;
+		int64_t openMs = 0;		 // 직전 표본과의 간격으로 누적한 관측 시간
+		int64_t closedMs = 0;
+		bool frozen = false;	// 졸음 신호가 있었으면 버림
+	};
+	AdaptWindow window;
+	std::vector<float> tripOpenMeans;	 // 주행 중 완료된 구간 평균 (시간 순)
+	std::vector<float> tripClosedMeans;
+
+	// 표본에서 두 중심을 구함 (구분되지 않으면 false)
+	static bool fitTwoMeans(std::vector<float> samples, float& closedEar, float& openEar);
+	void updateThreshold();
+	void closeWindow();
+	// 구간 평균들로 중심을 옮김 (주행 중 추세가 있거나 구간이 부족하면 그대로)
+	bool adaptCenter(std::vector<float>& means, float& center, float baseline);
+
+public:
+	EarCalibrator(const std::string& driverId, const std::string& profileDirectory,
+								int64_t calibrationMs = 180000, size_t minCalibrationSamples = 600);
+
+	// DRIVER_ID, EAR_PROFILE_DIR 환경 변수로 생성 후 저장된 프로필 복원
+	static std::unique_ptr<EarCalibrator> fromEnvironment();
+
+	bool load();
+	bool save() const;
+
+	// 판별 결과 1건 반영 (얼굴 미검출 또는 EAR 이 없는 프레임은 무시)
+	// drowsySignal: 긴 감김/PERCLOS 상승/졸음 상태 중이면 true (보정/적응 표본에서 제외)
+	void addSample(int64_t timestampMs, float ear, bool faceFound, bool drowsySignal = false);
+
+	// 주행 종료: 이번 주행 구간 평균으로 중심을 한 번 옮기고 프로필 저장
+	bool endTrip();
+
+	float getThreshold() const;
+	bool isCalibrated() const;
+	EarProfile getProfile() const;
+};
+
+#endif	// EAR_CALIBRATOR_H
@@ -0,0 +1,140 @@
+#ifndef EYE_CLOSURE_DETECTOR_H
+#define EYE_CLOSURE_DETECTOR_H
+
+#include <Python.h>
+
+#include <array>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+#include "PyBridge.h"
+
+#ifdef USE_DLIB
+#include <dlib/image_processing.h>
+#include <dlib/image_processing/frontal_face_detector.h>
+#include <dlib/opencv.h>
+#endif
+
+// 한 프레임에 대한 눈 감음 판별 결과
+struct EyeClosureResult {
+	bool faceFound = false;
+	bool eyesClosed = false;
+	float ear = -1.0f;				// 얼굴 미검출 또는 EAR 계산 불가 시 -1
+	float confidence = 0.0f;	// 임계값으로부터 EAR 이 떨어진 정도 (0~1, EAR 이 없으면 0)
+
+	// 얼굴 위치와 68 랜드마크 (원본 프레임 좌표, 네이티브 엔진만 제공)
+	cv::Rect faceRect;
+	std::vector<cv::Point2f> landmarks;
+};
+
+// 눈 랜드마크 6점으로 EAR 계산 (python/eye_detection_lib.py::calculate_ear 와 동일)
+float calculateEar(const std::array<cv::Point2f, 6>& eye);
+
+// Interface for eye closure detection engine to allow swapping backends
+class IEyeClosureDetector {
+public:
+	virtual ~IEyeClosureDetector() = default;
+	virtual bool initialize() = 0;
+	virtual EyeClosureResult detect(const cv::Mat& frame, float threshold) = 0;
+	virtual std::string getName() const = 0;
+
+	// 원본 프레임의 roi 영역만 잘라낸 이미지에서 판별 (faceHint 가 있으면 얼굴 검출 생략)
+	// 기본 구현은 ROI 를 지원하지 않으므로 잘라낸 이미지 전체로 판별함
+	virtual EyeClosureResult detectInRoi(const cv::Mat& roiImage, const cv::Rect& roi,
+																			 int frameWidth, const cv::Rect& faceHint, float threshold) {
+		(void)roi;
+		(void)frameWidth;
+		(void)faceHint;
+		return detect(roiImage, threshold);
+	}
+	virtual bool supportsRoiTracking() const { return false; }
+
+	// 얼굴/랜드마크 검출 해상도(원본 프레임을 줄일 폭) 변경 (지원하지 않는 엔진은 무시)
+	virtual void setDetectionWidth(int width) { (void)width; }
+
+	// 여러 프레임을 한 번에 판별 (기본 구현은 프레임마다 detect)
+	virtual void detectBatch(const std::vector<cv::Mat>& frames, float threshold,
+													 std::vector<EyeClosureResult>& results) {
+		results.clear();
+		for (const auto& frame : frames) {
+			results.push_back(detect(frame, threshold));
+		}
+	}
+};
+
+// Native implementation using dlib C++ API (same 68 landmark model as the Python path)
+class NativeEyeClosureDetector : public IEyeClosureDetector {
+private:
+	std::string predictorPath;
+	bool initialized;
+	int detectionWidth;	 // 판별 스레드에서만 변경/사용
+
+#ifdef USE_DLIB
+	dlib::frontal_face_detector faceDetector;
+	dlib::shape_predictor shapePredictor;
+
+	// 축소 이미지에서 랜드마크 검출 후 EAR 계산, 좌표는 원본 프레임 기준으로 변환
+	EyeClosureResult analyzeFace(const dlib::cv_image<unsigned char>& image,
+															 const dlib::rectangle& face, double scale, const cv::Point& offset,
+															 float threshold);
+#endif
+
+public:
+	NativeEyeClosureDetector(const std::string& modelPath = "../shape_predictor_68_face_landmarks.dat");
+	~NativeEyeClosureDetector() override;
+
+	bool initialize() override;
+	EyeClosureResult detect(const cv::Mat& frame, float threshold) override;
+	EyeClosureResult detectInRoi(const cv::Mat& roiImage, const cv::Rect& roi, int frameWidth,
+															 const cv::Rect& faceHint, float threshold) override;
+	std::string getName() const override { return "native"; }
+	bool supportsRoiTracking() const override { return initialized; }
+	void setDetectionWidth(int width) override;
+};
+
+// Fallback implementation calling python/eye_detection_lib.py through the embedded interpreter
+// measure_ear 핸들은 초기화 시 한 번만 조회하고, 프레임은 복사 없는 NumPy 뷰로 전달
+// 돌려받은 EAR 로 네이티브 엔진과 같이 faceFound/ear/confidence 를 채우므로 EAR 보정과 처리 모드 판단이 동작함
+// (랜드마크는 없으므로 ROI 추적은 사용하지 않음). 배치 판별 시 GIL 을 한 번만 획득
+class PythonEyeClosureDetector : public IEyeClosureDetector {
+private:
+	PyCallable measureEar;
+
+	// GIL 을 잡은 상태에서 프레임 1장 판별
+	EyeClosureResult detectLocked(const cv::Mat& frame, float threshold);
+
+public:
+	PythonEyeClosureDetector();
+	~PythonEyeClosureDetector() override;
+
+	bool initialize() override;
+	EyeClosureResult detect(const cv::Mat& frame, float threshold) override;
+	void detectBatch(const std::vector<cv::Mat>& frames, float threshold,
+									 std::vector<EyeClosureResult>& results) override;
+	std::string getName() const override { return "python"; }
+};
+
+// 시작 시 선택된 엔진을 초기화하고, 네이티브 엔진 실패 시 Python 경로로 대체
+class EyeClosureDetector {
+private:
+	std::unique_ptr<IEyeClosureDetector> detector;
+	bool useNative;
+
+public:
+	EyeClosureDetector(bool useNative = true);
+	~EyeClosureDetector();
+
+	bool initialize();
+	EyeClosureResult detect(const cv::Mat& frame, float threshold);
+	EyeClosureResult detectInRoi(const cv::Mat& roiImage, const cv::Rect& roi, int frameWidth,
+															 const cv::Rect& faceHint, float threshold);
+	void detectBatch(const std::vector<cv::Mat>& frames, float threshold,
+									 std::vector<EyeClosureResult>& results);
+	bool supportsRoiTracking() const;
+	void setDetectionWidth(int width);
+	std::string getBackendName() const;
+};
+
+#endif	// EYE_CLOSURE_DETECTOR_H
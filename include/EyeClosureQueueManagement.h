@@ -1,26 +1,104 @@
 #ifndef EYE_CLOSURE_QUEUE_MANAGEMENT_H
 #define EYE_CLOSURE_QUEUE_MANAGEMENT_H
 
-#include <deque>
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
+// 졸음 판별 구간 설정 (밀리초)
+struct SleepinessWindowConfig {
+	int closedDurationMs = 2000;	 // 이 시간 이상 연속으로 감기면 졸음
+	int perclosWindowMs = 60000;	 // PERCLOS(눈 감김 비율)/평균 EAR 산출 구간
+	int blinkWindowMs = 60000;		 // 깜빡임 빈도 산출 구간
+	int maxBlinkMs = 400;					 // 이보다 짧게 감았다 뜬 경우만 깜빡임으로 셈
+	int maxSampleGapMs = 200;			 // 프레임 간격이 이보다 길면(드롭/정차) 이 시간만 반영
+	size_t historyCapacity = 4096;	// 보관 프레임 수 (24fps 기준 약 170초)
+};
+
+// 프레임 1장의 눈 상태
+struct EyeStateSample {
+	int64_t timestampMs = 0;	// 캡처 시각 (steady_clock 밀리초)
+	float ear = -1.0f;				// EAR 계산 불가 시 -1
+	float confidence = 0.0f;	// 판별 신뢰도 (0~1)
+	bool faceFound = false;
+	bool eyesClosed = false;
+};
+
+// 현재 눈 감김 지표
+struct EyeClosureStats {
+	int closedRunMs;				 // 현재까지 연속으로 감긴 시간
+	double perclos;					 // PERCLOS 구간 내 감긴 시간 비율 (0~1)
+	double blinksPerMinute;	 // 깜빡임 구간 기준 분당 깜빡임 수
+	float meanEar;					 // PERCLOS 구간 평균 EAR (얼굴 미검출 프레임 제외, 없으면 -1)
+	size_t samples;					 // 지금까지 기록된 프레임 수
+};
+
+// 눈 감음 이력 관리 및 졸음 판별
+// 프레임별 (시각, EAR, 신뢰도, 상태) 를 고정 크기 struct-of-arrays 링에 기록하고, 각 프레임은 직전
+// 프레임 이후 경과 시간만큼을 차지하는 것으로 보아 프레임 드롭이나 프레임률 변화와 무관하게 시간 기준으로 판별
+// 설정된 구간의 지표는 구간을 벗어나는 프레임만 빼는 방식으로 갱신 (프레임당 분할 상환 O(1))
+// 판별 스레드가 기록하는 동안 다른 스레드에서 조회할 수 있도록 내부 잠금 사용
 class EyeClosureQueueManagement {
 private:
-	std::deque<bool> eyeClosureDeque;
-	static const int MAX_DEQUE_SIZE = 60;											// 최대 덱 사이즈 (약 2.5초)
-	static const int CONSECUTIVE_FRAMES_FOR_SLEEPINESS = 48;	// 졸음 진단 위한 연속 프레임 수
+	static const uint8_t FLAG_CLOSED = 1;
+	static const uint8_t FLAG_FACE_FOUND = 2;
+	static const uint8_t FLAG_BLINK_END = 4;	// 이 프레임에서 깜빡임이 끝남
+
+	// 최신 프레임 기준 구간의 누적값
+	struct Window {
+		int durationMs;
+		uint64_t start;	 // 구간의 첫 프레임 (head 와 같으면 비어 있음)
+		int64_t spanMs;
+		int64_t closedMs;
+		size_t blinks;
+		double earSum;
+		size_t earCount;
+	};
+
+	const SleepinessWindowConfig config;
+	const size_t capacity;
+
+	mutable std::mutex historyMutex;
+	// struct-of-arrays 링 (인덱스 = 프레임 번호 % capacity)
+	std::vector<int64_t> timestamps;
+	std::vector<float> ears;
+	std::vector<float> confidences;
+	std::vector<uint16_t> durations;	// 직전 프레임 이후 경과 시간 (maxSampleGapMs 로 제한)
+	std::vector<uint8_t> flags;
+	uint64_t head;	// 지금까지 기록된 프레임 수
+	int closedRunMs;
+	Window perclosWindow;
+	Window blinkWindow;
+
+	void addToWindow(Window& window, size_t index);
+	void evictFromWindow(Window& window, int64_t latestMs);
+	// 지정한 구간 안의 프레임을 최신 순으로 순회하며 (인덱스, 구간 안의 시간) 전달 (잠금 상태에서 호출)
+	template <typename Visitor>
+	void forEachRecent(int windowMs, Visitor visit) const;
 
 public:
-	EyeClosureQueueManagement();
+	explicit EyeClosureQueueManagement(const SleepinessWindowConfig& config = SleepinessWindowConfig());
 	~EyeClosureQueueManagement();
 
-	// 덱 관리 메소드
-	std::deque<bool> getEyeClosureHistory();
+	// 최근 durationMs 구간의 눈 감음 이력 (오래된 순)
+	std::vector<EyeStateSample> getEyeClosureHistory(int durationMs) const;
 
-	// 눈 감음 상태 저장
+	// 눈 상태 저장 (시각은 이전 기록 이후여야 하며, 되돌아간 경우 경과 시간 0 으로 처리)
+	void saveEyeClosureStatus(const EyeStateSample& sample);
+	// 시각을 현재 시각으로 기록 (EAR 정보가 없는 경로용)
 	void saveEyeClosureStatus(bool eyeClosed);
 
-	// 덱에 저장된 눈 감음 상태를 기반으로 졸음 여부 판단
-	bool detectSleepiness();
+	EyeClosureStats getStats() const;
+
+	// 최신 프레임 기준 최근 windowMs 동안 눈이 감겨 있던 시간
+	int getClosedDurationMs(int windowMs) const;
+	// 최신 프레임 기준 최근 windowMs 동안의 평균 EAR (얼굴 미검출 프레임 제외, 없으면 -1)
+	float getMeanEar(int windowMs) const;
+
+	// 현재 연속 감김 시간을 기준으로 졸음 여부 판단
+	bool detectSleepiness() const;
+
+	const SleepinessWindowConfig& getConfig() const { return config; }
 };
 
-#endif	// EYE_CLOSURE_QUEUE_MANAGEMENT_H
\ No newline at end of file
+#endif	// EYE_CLOSURE_QUEUE_MANAGEMENT_H
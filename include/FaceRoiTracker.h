@@ -0,0 +1,56 @@
+#ifndef FACE_ROI_TRACKER_H
+#define FACE_ROI_TRACKER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "EyeClosureDetector.h"
+
+// 얼굴 ROI 추적기
+// N 프레임마다 또는 추적 실패 시에만 전체 프레임 얼굴 검출을 하고,
+// 그 사이에는 이전 랜드마크를 광학 흐름(LK)으로 따라가 얼굴 위치를 예측함
+// 전처리 워커(getSearchRoi)와 판별 워커(predict/update)가 동시에 사용하므로 내부에서 락을 잡음
+class FaceRoiTracker {
+private:
+	const int redetectInterval;	 // 전체 프레임 얼굴 검출 주기 (프레임)
+	const double roiMargin;			 // 얼굴 크기 대비 ROI 여백 비율
+
+	mutable std::mutex trackerMutex;
+	bool tracking;
+	int framesSinceFullDetection;
+	cv::Rect faceRect;												// 원본 프레임 좌표
+	std::vector<cv::Point2f> trackedPoints;		// 이전 프레임 랜드마크 (원본 프레임 좌표)
+	cv::Mat previousImage;										// 이전 프레임 ROI 전처리 이미지
+	cv::Rect previousRoi;
+
+	std::atomic<uint64_t> fullDetectionCount;
+	std::atomic<uint64_t> trackedFrameCount;
+	std::atomic<uint64_t> lostCount;
+
+	void markLost();
+
+public:
+	FaceRoiTracker(int redetectInterval = 24, double roiMargin = 0.5);
+
+	// 전처리 단계: 이번 프레임에서 처리할 영역 (전체 검출이 필요하면 프레임 전체)
+	cv::Rect getSearchRoi(const cv::Size& frameSize) const;
+
+	// 판별 단계: ROI 이미지에서 얼굴 위치 예측 (전체 검출이 필요하거나 추적 실패 시 빈 Rect)
+	cv::Rect predictFaceRect(const cv::Mat& roiImage, const cv::Rect& roi, const cv::Size& frameSize);
+
+	// 판별 단계: 검출 결과 반영 (예측 위치와 크게 어긋나면 추적 실패로 처리하고 false 반환)
+	bool update(const EyeClosureResult& result, const cv::Mat& roiImage, const cv::Rect& roi,
+							const cv::Size& frameSize, const cv::Rect& faceHint);
+
+	void reset();
+
+	bool isTracking() const;
+	uint64_t getFullDetectionCount() const { return fullDetectionCount.load(); }
+	uint64_t getTrackedFrameCount() const { return trackedFrameCount.load(); }
+	uint64_t getLostCount() const { return lostCount.load(); }
+};
+
+#endif	// FACE_ROI_TRACKER_H
@@ -15,11 +15,27 @@
 #include <numpy/arrayobject.h>
 
 #include "AccelerationSensor.h"
+#include "BoundedQueue.h"
 #include "Camera.h"
 #include "DBThreadMonitoring.h"
+#include "DiagnosisClient.h"
+#include "EarCalibrator.h"
+#include "EyeClosureDetector.h"
 #include "EyeClosureQueueManagement.h"
+#include "FaceRoiTracker.h"
+#include "FramePacket.h"
+#include "FrameRingBuffer.h"
+#include "FrameScheduler.h"
+#include "FrameUplink.h"
+#include "IlluminationNormalizer.h"
+#include "LatencyMetrics.h"
+#include "MetricsExporter.h"
+#include "MotionStateMonitor.h"
+#include "ProcessingGovernor.h"
+#include "SleepinessEvidence.h"
 #include "SleepinessDetector.h"
 #include "Speaker.h"
+#include "ThermalMonitor.h"
 #include "Utils.h"
 
 class FirmwareManager {
@@ -27,11 +43,28 @@ private:
 	// 장치 객체들
 	std::unique_ptr<Camera> camera;
 	std::unique_ptr<AccelerationSensor> accelerationSensor;
+	std::unique_ptr<MotionStateMonitor> motionMonitor;	// 센서 샘플링 스레드 (주행/정차 판정 공개)
 	std::unique_ptr<Speaker> speaker;
 	std::unique_ptr<SleepinessDetector> sleepinessDetector;
 	std::unique_ptr<EyeClosureQueueManagement> eyeClosureQueue;
+	std::unique_ptr<EyeClosureDetector> eyeClosureDetector;
+	std::unique_ptr<FaceRoiTracker> faceTracker;	// ROI 추적 (네이티브 엔진에서만 사용)
+	std::unique_ptr<EarCalibrator> earCalibrator;	// 운전자별 EAR 임계값 (판별 스레드에서 갱신)
 	std::unique_ptr<Utils> utils;
 	std::unique_ptr<DBThreadMonitoring> threadMonitor;
+	std::unique_ptr<DiagnosisClient> diagnosisClient;	// AI 서버 진단 (한 번에 하나의 요청만 진행)
+	std::unique_ptr<FrameUplink> frameUplink;	// AI 서버 프레임 배치 전송 (없으면 프레임 단위 전송)
+	bool uplinkRoiOnly = false;	// 얼굴 ROI 만 전송 (false 면 ROI 만 전처리된 프레임은 전송 단계에서 전체 프레임 전처리)
+	std::unique_ptr<ProcessingGovernor> governor;	// 처리 모드 (판별 스레드에서 갱신, 캡처 스레드에서 읽음)
+	std::unique_ptr<ThermalMonitor> thermalMonitor;	// CPU 온도/사용률 감시 (발열 단계별 처리 축소)
+	std::unique_ptr<MetricsExporter> metricsExporter;	// 단계별 지연 지표 내보내기 (설정된 경우에만)
+
+	// 최근 프레임 메모리 링 버퍼 (약 3초, 저장 스레드에서만 기록)
+	static const int RECENT_FRAME_CAPACITY = 72;
+	static const int RECENT_FRAME_WINDOW_MS = 2500;	// 졸음 근거로 가져올 진단 이전 구간
+	std::unique_ptr<FrameRingBuffer> recentFrames;
+	std::vector<uchar> encodeBuffer;
+	std::vector<int> evidenceEncodeParams{cv::IMWRITE_JPEG_QUALITY, 95};	// 발열 시 화질을 낮춤
 
 	// UUID 및 기타 필드
 	std::string deviceUID;
@@ -41,26 +74,70 @@ private:
 	std::atomic<bool> isPaused;
 
 	// 처리 주기 관련 변수
-	int frameCycle;
-	int diagnosticCycle;
-
-	// 스레드
-	std::thread mainThread;
+	static const int FRAMES_PER_SECOND = 24;
+	static const int DIAGNOSIS_INTERVAL_SLOTS = 24;	// 진단 요청 주기 (프레임 슬롯 기준 1초)
+	static const int CAPTURE_TIMEOUT_SLOTS = 6;	// 이 슬롯 수 동안 프레임이 없으면 대기를 끝내고 상태 확인
+	FrameScheduler frameScheduler;	// 캡처 스레드에서만 사용 (카메라 프레임에 슬롯 번호 부여)
+	uint64_t nextDiagnosisSlot;			// 판별 스레드에서만 갱신
+	static const int RECENT_EAR_WINDOW_MS = 3000;	// 처리 모드 판단에 쓰는 EAR 추세 구간
+	// 이 이상이면 EAR 보정 적응을 멈춤 (처리 모드 경계 기준과 같은 값)
+	static const int CALIBRATION_FREEZE_CLOSED_RUN_MS = 400;
+	static constexpr double CALIBRATION_FREEZE_PERCLOS = 0.08;
+	int diagnosticCycle;						// 판별 스레드에서만 갱신
+
+	// 스레드 (캡처 -> 전처리 -> 판별 -> 저장/전송 파이프라인)
+	std::thread mainThread;	 // 캡처 스레드
+	std::vector<std::thread> preprocessThreads;
+	std::thread detectionThread;
+	std::thread persistenceThread;
+	std::thread uplinkThread;
 	std::mutex detectionMutex;
 
-	// 이전 졸음 상태
-	bool previousSleepy = false;
-
-	// 졸음 진단 폴더 경로 저장 스택 (DB 스레드 모니터링용)
-	std::stack<std::string> sleepImgPathStack;
+	// 파이프라인 단계 간 큐
+	static const int PREPROCESS_WORKER_COUNT = 2;
+	BoundedQueue<FramePacketPtr> captureQueue;
+	BoundedQueue<FramePacketPtr> preprocessQueue;
+	BoundedQueue<FramePacketPtr> persistenceQueue;
+	BoundedQueue<FramePacketPtr> uplinkQueue;
+	uint64_t captureSequence = 0;
+	std::vector<cv::Mat> batchFrames;	// 배치 판별 입력/결과 (판별 스레드에서만 사용)
+	std::vector<EyeClosureResult> batchResults;
+	std::atomic<uint64_t> reorderDropCount{0};	// 순서가 뒤바뀌어 판별 단계에서 버린 프레임 수
+	std::atomic<uint64_t> missingEvidenceCount{0};	// 근거 영상 스트림 프레임이 없어 저장하지 않은 프레임 수
+
+	// 이전 졸음 상태 (판별 스레드에서 EAR 보정 동결 여부로도 읽음)
+	std::atomic<bool> previousSleepy{false};
+
+	// 졸음 근거 영상 (detectionMutex 로 보호)
+	std::shared_ptr<SleepinessEvidence> recordingEvidence;	// 감지 이후 프레임을 수집 중인 이벤트
+	std::shared_ptr<SleepinessEvidence> pendingEvidence;		// 졸음 상태 종료 시 전송할 이벤트
 
 	// 내부 메서드
 	void mainLoop();
-	bool processSingleFrame();
+	void preprocessLoop();
+	void detectionLoop();
+	void persistenceLoop();
+	void uplinkLoop();
+	void startPipelineThreads();
+	void stopPipelineThreads();
+
+	// 파이프라인 단계별 처리
+	bool captureFrameToPipeline(uint64_t frameSlot, CapturedFrame& captured);
+	bool preprocessFrame(FramePacket& packet, IlluminationNormalizer& normalizer);
+	void detectEyeClosure(FramePacket& packet);
+	void detectEyeClosures(std::vector<FramePacketPtr>& packets);
+	void recordEyeState(FramePacket& packet);
+	void updateProcessingMode(int64_t nowMs);
+	bool persistFrame(const FramePacket& packet);
+	cv::Rect getUplinkFaceRoi(const FramePacket& packet) const;
+	void logPipelineStats() const;
+	void logSchedulerStats() const;
 	void requestDiagnosis();
+	void pollDiagnosis();
+	void applyDiagnosisResult(const DiagnosisResult& result);
 	void initializeDevices();
 	void handleVehicleStopped();
-	void handleSleepinessDetected(const std::string& timestamp);
+	void handleSleepinessDetected(const std::string& timestamp, int64_t detectedAtMs);
 
 	// 장치 상태 백엔드 전송
 	void sendDeviceStatusToBackend();
@@ -81,6 +158,10 @@ public:
 
 	// 상태 확인 메서드
 	bool isDeviceRunning() const;
+
+	// 파이프라인 단계별 큐 깊이 및 드롭 카운터
+	std::vector<QueueStats> getPipelineStats() const;
+	uint64_t getReorderDropCount() const;
 };
 
 #endif	// FIRMWARE_MANAGER_H
\ No newline at end of file
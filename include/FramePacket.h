@@ -0,0 +1,37 @@
+#ifndef FRAME_PACKET_H
+#define FRAME_PACKET_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+
+#include "EyeClosureDetector.h"
+
+// 캡처 버퍼 뷰 (원본 픽셀이 필요한 단계만 참조하며, 모두 놓으면 버퍼가 카메라로 반환됨)
+struct CaptureBuffers {
+	cv::Mat frame;								 // 원본 프레임 (카메라 경로는 NV12 의 Y 평면 = 그레이스케일)
+	cv::Mat evidenceFrame;				 // 근거 영상용 NV12 프레임 (없으면 컬러 frame 사용, 그레이면 저장 안 함)
+	std::shared_ptr<void> owner;	 // 캡처 버퍼 소유권 (frame/evidenceFrame 이 버퍼 뷰일 때)
+};
+
+// 파이프라인 단계 사이를 이동하는 프레임 단위 데이터
+struct FramePacket {
+	uint64_t sequence = 0;														 // 캡처 순번 (단계 간 순서 복원용)
+	uint64_t frameSlot = 0;														 // 캡처 스케줄러 슬롯 (건너뛴 슬롯 포함)
+	std::chrono::system_clock::time_point capturedAt;				 // 캡처 벽시계 시각 (파일명/서버 전송용)
+	std::chrono::steady_clock::time_point capturedAtSteady;	 // 캡처 시각 (구간/경과 시간 계산은 모두 이 값)
+	std::string timestamp;														 // yyyyMMdd_HHmmss_fff (파일명용)
+
+	// 전처리가 끝나면 놓음 (전체 프레임 전송에 필요할 때만 전송 단계까지 유지)
+	std::shared_ptr<const CaptureBuffers> buffers;
+	cv::Size frameSize;					// 원본 프레임 크기 (버퍼를 놓은 뒤에도 사용)
+	cv::Mat preprocessedFrame;	// 조명 보정된 그레이스케일 프레임 (roi 영역만)
+	cv::Rect roi;								// preprocessedFrame 이 덮는 원본 프레임 영역
+	EyeClosureResult detection;	// 눈 감음 판별 결과
+};
+
+using FramePacketPtr = std::shared_ptr<FramePacket>;
+
+#endif	// FRAME_PACKET_H
@@ -0,0 +1,44 @@
+#ifndef FRAME_RING_BUFFER_H
+#define FRAME_RING_BUFFER_H
+
+#include <cstdint>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+// 링 버퍼에 저장되는 JPEG 인코딩된 프레임
+struct BufferedFrame {
+	int64_t timestampMs = 0;	// 캡처 시각 (steady_clock 밀리초, 시계 보정에 영향받지 않음)
+	std::string name;					// 파일명 (yyyyMMdd_HHmmss_fff.jpg)
+	std::vector<uchar> jpeg;	// 인코딩된 JPEG 바이트
+};
+
+// 최근 프레임을 보관하는 고정 크기 메모리 링 버퍼 (./frames/recent 폴더 대체)
+// 슬롯과 JPEG 버퍼를 미리 할당해 두고, 추가 시 버퍼를 교환(swap)하여 O(1) 로 저장함
+// 쓰기는 저장 스레드 하나에서만, 조회는 여러 스레드에서 가능
+class FrameRingBuffer {
+private:
+	std::vector<BufferedFrame> slots;
+	size_t head;	 // 다음에 쓸 슬롯
+	size_t count;	 // 저장된 프레임 수
+	mutable std::mutex bufferMutex;
+
+	// 가장 오래된 프레임을 0 으로 하는 논리 인덱스 -> 실제 슬롯 인덱스
+	size_t slotIndex(size_t logicalIndex) const;
+
+public:
+	FrameRingBuffer(size_t capacity, size_t reserveBytesPerFrame = 192 * 1024);
+
+	// 프레임 추가. jpeg 내용은 슬롯으로 옮겨지고, 덮어쓴 슬롯의 버퍼가 재사용을 위해 돌려짐
+	void push(int64_t timestampMs, const std::string& name, std::vector<uchar>& jpeg);
+
+	// [fromMs, toMs] 구간 프레임을 시간순으로 복사 (구간 탐색은 이진 탐색, 최신 maxFrames 개까지)
+	std::vector<BufferedFrame> snapshot(int64_t fromMs, int64_t toMs, size_t maxFrames) const;
+
+	void clear();
+	size_t size() const;
+	size_t capacity() const { return slots.size(); }
+};
+
+#endif	// FRAME_RING_BUFFER_H
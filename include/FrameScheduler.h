@@ -0,0 +1,66 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// 프레임 주기 통계 (지터 = 실제 깨어난/도착한 시각 - 예정 시각, 최근 표본 기준)
+struct FrameSchedulerStats {
+	uint64_t ticks;					// 실행한 프레임 슬롯 수
+	uint64_t skippedSlots;	// 처리 지연으로 건너뛴 슬롯 수
+	uint64_t overruns;			// 슬롯을 건너뛰게 만든 지연 횟수
+	double jitterP50Us;
+	double jitterP99Us;
+	double jitterMaxUs;
+};
+
+// 절대 시각 격자 기반 프레임 스케줄러
+// 슬롯 k 의 예정 시각은 origin + k * interval 로 계산하므로 처리 시간이 길어져도 주기가 밀리지 않음
+// 처리가 한 주기 이상 늦어지면 지난 슬롯은 실행하지 않고 건너뛴 수로 기록
+// 카메라처럼 스스로 주기를 정하는 공급원은 waitNextSlot() 대신 frameArrived() 로 도착한 프레임에
+// 슬롯 번호만 매김 (격자를 직전 도착 시각에 다시 맞추므로 카메라 클럭과 어긋나도 건너뛴 수가 쌓이지 않음)
+// 캡처 스레드 하나에서만 사용 (통계 조회 포함)
+class FrameScheduler {
+private:
+	static const size_t JITTER_SAMPLE_COUNT = 512;
+
+	const std::chrono::nanoseconds interval;
+	std::chrono::steady_clock::time_point origin;	 // originSlot 의 예정 시각
+	uint64_t originSlot;
+	uint64_t nextSlot;
+	bool anchored;	// reset() 이후 프레임이 도착했는지 (frameArrived 기준 시각이 유효한지)
+
+	uint64_t tickCount;
+	uint64_t skippedCount;
+	uint64_t overrunCount;
+	std::vector<double> jitterSamples;	// 원형 버퍼 (마이크로초)
+	size_t jitterNext;
+
+	std::chrono::steady_clock::time_point deadlineOf(uint64_t slot) const;
+	void recordTick(uint64_t slot, double jitterUs);
+
+public:
+	explicit FrameScheduler(std::chrono::nanoseconds interval);
+
+	// 격자를 현재 시각 기준으로 다시 맞춤 (정차/일시 중지 후 재개 시, 건너뛴 수에 포함하지 않음)
+	// 슬롯 번호는 이어서 증가
+	void reset();
+
+	// 다음 슬롯의 예정 시각까지 대기 후 슬롯 번호 반환
+	uint64_t waitNextSlot();
+
+	// 방금 도착한 프레임의 슬롯 번호 반환 (대기 없음)
+	// 직전 도착 이후 여러 주기가 지났으면 그 사이 슬롯은 건너뛴 수로 기록
+	uint64_t frameArrived();
+
+	// 프레임 도착을 기다릴 최대 시간 (이 시간 동안 도착하지 않으면 캡처 스레드가 상태를 다시 확인)
+	std::chrono::milliseconds arrivalTimeout(int slots) const {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(interval * slots);
+	}
+
+	std::chrono::nanoseconds getInterval() const { return interval; }
+	FrameSchedulerStats getStats() const;
+};
+
+#endif	// FRAME_SCHEDULER_H
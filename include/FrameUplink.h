@@ -0,0 +1,79 @@
+#ifndef FRAME_UPLINK_H
+#define FRAME_UPLINK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+// AI 서버로 보내는 프레임 1장 (JPEG 버퍼는 배치 사이에 재사용)
+struct UplinkFrame {
+	uint64_t frameIndex = 0;	// 캡처 순번
+	int64_t capturedAtMs = 0;	// 캡처 시각 (epoch 밀리초)
+	cv::Rect roi;							// 원본 프레임 기준 잘라낸 영역 (비어 있으면 전체 프레임)
+	std::vector<uchar> jpeg;
+};
+
+// 프레임 배치 전송기
+// 프레임마다 JSON+base64 POST 를 보내는 대신 여러 장을 multipart 요청 하나로 묶어 보내고,
+// 공용 BackendClient 의 keep-alive 세션으로 연결을 재사용함
+// 얼굴 ROI 모드에서는 얼굴 주변만 낮은 화질로 잘라 보내 업로드 대역폭을 줄임
+// 전송은 업링크 스레드 하나에서만 호출
+class FrameUplink {
+private:
+	const size_t batchSize;
+	const bool roiOnly;
+	const int jpegQuality;
+	const std::chrono::milliseconds maxBatchDelay;	// 배치가 덜 차도 이 시간이 지나면 전송
+
+	bool initialized;
+	std::string deviceUid;
+	std::vector<UplinkFrame> batch;	 // 슬롯 재사용 (batchCount 개만 유효)
+	size_t batchCount;
+	std::chrono::steady_clock::time_point batchStartedAt;
+	std::vector<int> encodeParams;
+
+	// 통계는 다른 스레드에서 로그로 읽음
+	std::atomic<uint64_t> sentBatches;
+	std::atomic<uint64_t> sentFrames;
+	std::atomic<uint64_t> sentBytes;
+	std::atomic<uint64_t> failedBatches;
+
+public:
+	FrameUplink(size_t batchSize = 8, bool roiOnly = false, int jpegQuality = 80,
+							std::chrono::milliseconds maxBatchDelay = std::chrono::milliseconds(500));
+	~FrameUplink();
+
+	// FRAME_UPLINK_MODE=batch 일 때만 생성 (그 외에는 기존 프레임 단위 전송 사용)
+	// FRAME_UPLINK_BATCH_SIZE, FRAME_UPLINK_ROI_ONLY, FRAME_UPLINK_JPEG_QUALITY 로 설정
+	static std::unique_ptr<FrameUplink> fromEnvironment();
+
+	// 얼굴 ROI 만 전송할지 (FRAME_UPLINK_ROI_ONLY=1 일 때만, 기본은 전체 프레임)
+	// 프레임 단위 전송 경로도 같은 설정을 따르며, 이때 잘라낸 영상과 함께 원본 기준 ROI 좌표를 보냄
+	static bool roiOnlyFromEnvironment();
+
+	// 서버 주소/장치 UID 확인
+	bool initialize();
+
+	// 프레임을 인코딩해 배치에 추가하고, 배치가 차면 전송
+	void addFrame(const cv::Mat& image, const cv::Rect& roi, uint64_t frameIndex,
+								int64_t capturedAtMs);
+
+	// 발열 시 JPEG 화질 상한 (0 이면 설정된 화질 사용, 다음 프레임부터 반영)
+	void limitJpegQuality(int maxQuality);
+
+	// 대기 시간이 지난 배치 전송 (프레임이 끊겼을 때 호출)
+	void flushIfDue();
+	bool flush();
+
+	bool isRoiOnly() const { return roiOnly; }
+	uint64_t getSentBatches() const { return sentBatches.load(); }
+	uint64_t getSentFrames() const { return sentFrames.load(); }
+	uint64_t getSentBytes() const { return sentBytes.load(); }
+	uint64_t getFailedBatches() const { return failedBatches.load(); }
+};
+
+#endif	// FRAME_UPLINK_H
@@ -0,0 +1,53 @@
+#ifndef ILLUMINATION_NORMALIZER_H
+#define ILLUMINATION_NORMALIZER_H
+
+#include <algorithm>
+#include <array>
+#include <opencv2/opencv.hpp>
+
+// 조명 보정 전처리 (그레이스케일 0.75 + 반전된 배경 밝기 0.25)
+// 배경 밝기는 축소 해상도에서 L 채널만 계산해 미디안 필터 후 업샘플링하여 추정함
+// 내부 버퍼를 재사용하므로 스레드마다 별도 인스턴스를 사용해야 함
+class IlluminationNormalizer {
+private:
+	int medianKernelSize;	 // 원본 해상도 기준 미디안 커널 크기 (프레임 높이에 비례)
+	int downscaleFactor;	 // 배경 추정 해상도 축소 비율
+
+	// 재사용 버퍼
+	cv::Mat smallFrame;
+	cv::Mat smallLightness;
+	cv::Mat smallBackground;
+	cv::Mat background;
+
+	// sRGB 8비트 값 -> 선형 밝기 변환 테이블
+	std::array<float, 256> srgbToLinear;
+
+	void computeLightness(const cv::Mat& bgr, cv::Mat& lightness) const;
+
+public:
+	// 기존 커널 99 는 1080p 기준으로 조정된 값 (프레임 높이의 약 9%)
+	static const int REFERENCE_KERNEL_SIZE = 99;
+	static const int REFERENCE_FRAME_HEIGHT = 1080;
+
+	IlluminationNormalizer(int medianKernelSize = REFERENCE_KERNEL_SIZE, int downscaleFactor = 8);
+
+	// 프레임 높이에 맞춘 미디안 커널 크기 (360p 면 33, 홀수)
+	static int kernelSizeForHeight(int frameHeight);
+
+	// 빠른 경로: 입력 BGR 프레임을 조명 보정된 그레이스케일 프레임으로 변환
+	bool normalize(const cv::Mat& frame, cv::Mat& output);
+
+	// 기존 방식 (전체 해상도 Lab 변환 + 전체 해상도 미디안 필터), 품질 비교 기준
+	static bool normalizeReference(const cv::Mat& frame, cv::Mat& output, int medianKernelSize = 99);
+
+	// 배경 추정 축소 비율 변경 (발열 시 더 작은 해상도로 추정, 다음 normalize 부터 반영)
+	void setDownscaleFactor(int factor) { downscaleFactor = std::max(1, factor); }
+
+	// 미디안 커널 크기 변경 (ROI 만 처리할 때도 원본 프레임 높이 기준 값을 유지)
+	void setMedianKernelSize(int kernelSize) { medianKernelSize = std::max(3, kernelSize | 1); }
+
+	// 마지막 normalize 호출에서 추정한 배경 밝기 (원본 해상도)
+	const cv::Mat& getBackground() const { return background; }
+};
+
+#endif	// ILLUMINATION_NORMALIZER_H
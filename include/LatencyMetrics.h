@@ -0,0 +1,115 @@
+#ifndef LATENCY_METRICS_H
+#define LATENCY_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 지연 측정 구간
+enum class LatencyStage {
+	Capture = 0,	 // 도착한 카메라 프레임의 패킷 생성 (프레임 도착 대기 제외)
+	Preprocess,		 // 조명 보정 전처리 (프레임 1장)
+	Detection,		 // 눈 감음 판별 (배치 1회)
+	FrameTotal,		 // 캡처 시각부터 판별 완료까지 (프레임 1장)
+	Persistence,	 // 근거 영상 프레임 저장 (색 변환/리사이즈/인코딩 포함)
+	Encode,				 // 프레임 JPEG 인코딩
+	VideoEncode,	 // 졸음 근거 영상 MP4 인코딩
+	Upload,				 // 서버 POST (재시도 포함)
+	Diagnosis,		 // AI 진단 요청부터 응답까지
+	Count
+};
+
+// 구간별 지연 요약 (버킷 중앙값 기준 추정, 상대 오차 약 6%)
+struct LatencySummary {
+	uint64_t count;
+	double meanMs;
+	double p50Ms;
+	double p90Ms;
+	double p99Ms;
+	double maxMs;
+};
+
+// 구간별 지연 히스토그램 레지스트리 (싱글톤)
+// 스레드마다 자기 샤드(로그 선형 버킷 배열) 에만 기록하므로 기록 경로에 잠금/RMW 가 없고,
+// 조회 시 모든 샤드를 합산함. 종료된 스레드의 샤드는 값을 유지한 채 다음 스레드가 재사용
+class LatencyMetrics {
+public:
+	// 버킷: 0~7us 는 1us 단위, 이후 2 배 구간마다 8 등분 (약 67초까지, 넘으면 마지막 버킷)
+	static constexpr int SUB_BUCKETS = 8;
+	static constexpr int BUCKET_COUNT = 200;
+	static constexpr int STAGE_COUNT = static_cast<int>(LatencyStage::Count);
+
+	static LatencyMetrics& getInstance();
+
+	void record(LatencyStage stage, int64_t durationUs);
+	LatencySummary getSummary(LatencyStage stage) const;
+
+	// Prometheus 텍스트 형식 (히스토그램 + 구간별 p50/p90/p99 게이지)
+	std::string renderPrometheus() const;
+
+	static const char* stageName(LatencyStage stage);
+	static int bucketIndex(uint64_t durationUs);
+	static uint64_t bucketLowerUs(int index);
+
+	// 모든 샤드 값을 0 으로 (테스트용, 기록 중인 스레드가 없을 때 호출)
+	void reset();
+	void logStats() const;
+
+	LatencyMetrics(const LatencyMetrics&) = delete;
+	LatencyMetrics& operator=(const LatencyMetrics&) = delete;
+
+private:
+	// 한 스레드만 기록하므로 load + store 로 갱신하고, 읽는 쪽은 relaxed load 로 합산
+	struct Shard {
+		std::atomic<bool> inUse{false};
+		std::atomic<uint64_t> buckets[STAGE_COUNT][BUCKET_COUNT] = {};
+		std::atomic<uint64_t> sumUs[STAGE_COUNT] = {};
+		std::atomic<uint64_t> maxUs[STAGE_COUNT] = {};
+	};
+	friend struct LatencyShardHandle;
+
+	// 샤드 합산 결과
+	struct Snapshot {
+		std::array<uint64_t, BUCKET_COUNT> buckets{};
+		uint64_t count = 0;
+		uint64_t sumUs = 0;
+		uint64_t maxUs = 0;
+	};
+
+	LatencyMetrics() = default;
+
+	Shard* acquireShard();
+	void releaseShard(Shard* shard);
+	Snapshot snapshot(LatencyStage stage) const;
+	static LatencySummary summarize(const Snapshot& snapshot);
+
+	mutable std::mutex shardMutex;	// 샤드 목록 변경/순회만 보호 (기록 경로는 잠그지 않음)
+	std::vector<std::unique_ptr<Shard>> shards;
+};
+
+// 생성부터 소멸까지의 시간을 구간 히스토그램에 기록
+class ScopedLatency {
+private:
+	const LatencyStage stage;
+	const std::chrono::steady_clock::time_point startedAt;
+
+public:
+	explicit ScopedLatency(LatencyStage stage)
+			: stage(stage), startedAt(std::chrono::steady_clock::now()) {}
+	~ScopedLatency() {
+		LatencyMetrics::getInstance().record(
+				stage, std::chrono::duration_cast<std::chrono::microseconds>(
+									 std::chrono::steady_clock::now() - startedAt)
+									 .count());
+	}
+
+	ScopedLatency(const ScopedLatency&) = delete;
+	ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+#endif	// LATENCY_METRICS_H
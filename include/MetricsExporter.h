@@ -0,0 +1,47 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+// LatencyMetrics 를 Prometheus 텍스트로 내보내는 스레드
+// port 가 0 이 아니면 127.0.0.1:port 에서 GET /metrics 에 응답하고,
+// filePath 가 있으면 fileInterval 마다 파일로 기록 (임시 파일 작성 후 rename 하므로 읽는 쪽이 잘린 파일을 보지 않음)
+class MetricsExporter {
+private:
+	const int port;
+	const std::string filePath;
+	const std::chrono::milliseconds fileInterval;
+
+	int listenFd;
+	std::atomic<bool> terminate;
+	std::atomic<uint64_t> servedRequests;
+	mutable std::atomic<uint64_t> fileWrites;	// writeFile() 은 const
+	std::thread exporterThread;
+
+	bool openListener();
+	void exporterLoop();
+	void serveClient(int clientFd);
+
+public:
+	MetricsExporter(int port, const std::string& filePath,
+									std::chrono::milliseconds fileInterval = std::chrono::milliseconds(10000));
+	~MetricsExporter();
+
+	// METRICS_PORT, METRICS_FILE, METRICS_FILE_INTERVAL_MS 로 설정 (둘 다 없으면 nullptr)
+	static std::unique_ptr<MetricsExporter> fromEnvironment();
+
+	bool start();
+	void stop();
+
+	// 현재 값을 파일로 기록
+	bool writeFile() const;
+
+	uint64_t getServedRequests() const { return servedRequests.load(); }
+	uint64_t getFileWrites() const { return fileWrites.load(); }
+};
+
+#endif	// METRICS_EXPORTER_H
@@ -0,0 +1,120 @@
+#ifndef MOTION_STATE_MONITOR_H
+#define MOTION_STATE_MONITOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "AccelerationSensor.h"
+
+// 움직임 판정 설정 (분산 단위는 (m/s^2)^2)
+struct MotionFilterConfig {
+	int sampleRateHz = 100;					 // 센서 폴링 주기
+	float varianceTauMs = 500.0f;		 // 크기/분산 평활 시간 상수
+	float movingVariance = 0.02f;		 // 이 이상이면 움직임 후보
+	float stoppedVariance = 0.005f;	 // 이 이하이면 정차 후보 (사이 구간은 현재 상태 유지)
+	float maxDeviation = 1.0f;			 // 분산 계산 시 편차 상한 (m/s^2, 충격 하나가 분산을 오래 끌어올리지 않도록)
+	int64_t movingHoldMs = 300;			 // 움직임 후보가 이 시간 동안 이어져야 주행으로 전환
+	int64_t stoppedHoldMs = 5000;		 // 정차 후보가 이 시간 동안 이어져야 정차로 전환
+	bool initiallyMoving = true;		 // 시작 시 주행으로 간주 (센서 안정 전 프레임을 버리지 않음)
+};
+
+// 가속도 크기 필터 + 히스테리시스 상태 판정 (스레드 없음, 샘플 타임스탬프 기준)
+// 가속도 크기의 지수 이동 평균/분산(진동 성분) 으로 판단하며,
+// 센서 activity 인터럽트도 움직임 후보로 취급
+// 반대 상태의 후보가 hold 시간 동안 끊기지 않아야 전환하므로 샘플 하나로는 상태가 바뀌지 않음
+class MotionStateFilter {
+private:
+	const MotionFilterConfig config;
+	bool initialized;
+	bool moving;
+	float magnitude;
+	float variance;
+	int64_t lastTimestampUs;
+	int64_t candidateSinceUs;	 // 반대 상태 후보가 시작된 시각 (-1 이면 없음)
+	uint64_t transitions;
+
+public:
+	explicit MotionStateFilter(const MotionFilterConfig& config = MotionFilterConfig());
+
+	// 샘플 1개 반영 후 현재 상태 반환
+	bool update(const AccelerationSample& sample);
+	void reset();
+
+	bool isMoving() const { return moving; }
+	float getMagnitude() const { return magnitude; }
+	float getVariance() const { return variance; }
+	uint64_t getTransitions() const { return transitions; }
+};
+
+// 움직임 감시 통계
+struct MotionStats {
+	bool moving;
+	float magnitude;	// 평활된 가속도 크기 (m/s^2)
+	float variance;		// 진동 성분 분산 ((m/s^2)^2)
+	uint64_t samples;
+	uint64_t transitions;
+	uint64_t emptyPolls;	// 새 샘플이 없던 폴링 (센서 오류 포함)
+};
+
+// 가속도 센서 전용 샘플링 스레드
+// 고정 주기로 센서를 읽어 MotionStateFilter 에 반영하고, 판정 결과를 원자 변수로 공개하므로
+// 캡처 스레드는 isMoving() 의 원자 load 한 번으로 상태를 확인 (프레임 경로에서 센서 I/O 없음)
+// 원시 샘플은 잠금 없는 링(단일 기록자, 슬롯별 시퀀스 검사) 에 남겨 다른 스레드가 최근 구간을 읽을 수 있음
+// 시작 후에는 샘플링 스레드만 센서에 접근
+class MotionStateMonitor {
+private:
+	static constexpr size_t HISTORY_CAPACITY = 1024;	// 100Hz 기준 약 10초
+	static constexpr size_t READ_BATCH = 33;				// ADXL345 FIFO 32개 + 출력 레지스터
+
+	// 기록 중이면 sequence 가 홀수, 완료되면 2 * (인덱스 + 1)
+	struct HistorySlot {
+		std::atomic<uint64_t> sequence{0};
+		std::atomic<int64_t> timestampUs{0};
+		std::atomic<float> x{0.0f};
+		std::atomic<float> y{0.0f};
+		std::atomic<float> z{0.0f};
+		std::atomic<bool> activity{false};
+	};
+
+	AccelerationSensor& sensor;
+	const MotionFilterConfig config;
+	MotionStateFilter filter;	 // 샘플링 스레드에서만 사용
+	std::unique_ptr<HistorySlot[]> history;
+	std::atomic<uint64_t> written;
+
+	std::atomic<bool> moving;
+	std::atomic<float> magnitude;
+	std::atomic<float> variance;
+	std::atomic<uint64_t> sampleCount;
+	std::atomic<uint64_t> transitionCount;
+	std::atomic<uint64_t> emptyPollCount;
+
+	std::atomic<bool> terminate;
+	std::thread samplerThread;
+
+	void samplerLoop();
+	void appendHistory(const AccelerationSample& sample);
+
+public:
+	MotionStateMonitor(AccelerationSensor& sensor,
+										 const MotionFilterConfig& config = MotionFilterConfig());
+	~MotionStateMonitor();
+
+	// MOTION_* 환경 변수로 히스테리시스 설정을 바꿔 생성
+	static std::unique_ptr<MotionStateMonitor> fromEnvironment(AccelerationSensor& sensor);
+
+	void start();
+	void stop();
+
+	bool isMoving() const { return moving.load(std::memory_order_acquire); }
+
+	// 최근 원시 샘플을 오래된 순서로 최대 capacity 개 복사 (기록 중 덮어쓰인 슬롯은 제외)
+	size_t getRecentSamples(AccelerationSample* samples, size_t capacity) const;
+
+	MotionStats getStats() const;
+	void logStats() const;
+};
+
+#endif	// MOTION_STATE_MONITOR_H
@@ -0,0 +1,107 @@
+#ifndef PROCESSING_GOVERNOR_H
+#define PROCESSING_GOVERNOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// 처리 모드 (값이 클수록 처리량이 많음)
+enum class ProcessingMode { Economy = 0, Normal = 1, Alert = 2 };
+
+// 모드별 처리 설정
+struct ProcessingProfile {
+	ProcessingMode mode;
+	int captureDivisor;	 // 스케줄러 슬롯 N 개 중 1 개만 캡처 (24fps 격자 유지)
+	int detectionWidth;	 // 얼굴/랜드마크 검출 해상도 (원본 프레임을 줄일 폭)
+	int uplinkDivisor;	 // 캡처한 프레임 N 장 중 1 장만 AI 서버로 전송
+};
+
+// 모드 판단 입력 (판별 스레드에서 모아 전달)
+struct GovernorInputs {
+	int64_t nowMs = 0;
+	bool moving = true;
+	float motionVariance = 0.0f;	// 진동 성분 분산 ((m/s^2)^2)
+	int closedRunMs = 0;					// 현재 연속 감김 시간
+	double perclos = 0.0;
+	float recentEar = -1.0f;			// 최근 몇 초 평균 EAR (얼굴 미검출이면 -1)
+	float earThreshold = 0.25f;
+	float cpuTemperatureC = -1.0f;	// 알 수 없으면 -1
+	float cpuLoad = -1.0f;					// CPU 사용률 (0~1, 알 수 없으면 -1)
+};
+
+struct GovernorConfig {
+	ProcessingProfile economy{ProcessingMode::Economy, 3, 320, 4};	// 8fps
+	ProcessingProfile normal{ProcessingMode::Normal, 2, 400, 2};		// 12fps
+	ProcessingProfile alert{ProcessingMode::Alert, 1, 400, 1};			// 24fps (기존 처리와 같음)
+
+	// 눈이 감기기 시작하는 신호 (하나라도 해당하면 Alert)
+	int alertClosedRunMs = 400;			 // 일반적인 깜빡임보다 긴 감김
+	double alertPerclos = 0.08;
+	float alertEarMargin = 0.15f;		 // 최근 EAR 이 임계값보다 이 비율 이내로 가까워짐
+	int64_t alertHoldMs = 10000;		 // 신호가 사라져도 Alert 유지
+
+	// 눈을 안정적으로 뜨고 있는 상태가 이어지면 Economy
+	float steadyEarMargin = 0.3f;
+	int64_t economyAfterMs = 30000;
+	float roughMotionVariance = 0.5f;	 // 노면 진동이 크면 영상이 흔들리므로 Economy 로 내리지 않음
+
+	// 발열/부하가 높으면 (Alert 가 아닐 때) Economy
+	float hotTemperatureC = 75.0f;
+	float busyLoad = 0.9f;
+};
+
+// 처리 모드 통계
+struct GovernorStats {
+	ProcessingMode mode;
+	uint64_t modeChanges;
+	uint64_t alertTriggers;
+	int64_t economyMs;	// 모드별 누적 시간
+	int64_t normalMs;
+	int64_t alertMs;
+};
+
+// 주행 상태/최근 EAR 추세/CPU 상태로 구간별 캡처율, 검출 해상도, 전송 빈도를 정하는 조정기
+// 눈이 감기기 시작하면 즉시 최대 처리로 올리고 alertHoldMs 동안 유지하며,
+// 눈을 뜬 상태가 충분히 이어졌을 때만 처리량을 낮추므로 졸음 감지 민감도는 유지됨
+// evaluate() 는 한 스레드(판별 스레드) 에서만 호출하고, 현재 모드는 원자 변수로 공개
+class ProcessingGovernor {
+private:
+	const GovernorConfig config;
+	const bool enabled;	 // 비활성화하면 항상 Alert (모든 프레임 처리)
+	std::atomic<int> mode;
+
+	// evaluate() 호출 스레드에서만 사용
+	int64_t alertUntilMs;
+	int64_t steadySinceMs;	// 눈을 안정적으로 뜨기 시작한 시각 (-1 이면 아님)
+	int64_t lastEvaluatedMs;
+	std::atomic<uint64_t> modeChanges;
+	std::atomic<uint64_t> alertTriggers;
+	std::atomic<int64_t> modeTimeMs[3];
+
+public:
+	explicit ProcessingGovernor(const GovernorConfig& config = GovernorConfig(), bool enabled = true);
+
+	// PROCESSING_GOVERNOR=0 이면 비활성화
+	static std::unique_ptr<ProcessingGovernor> fromEnvironment();
+
+	// 입력을 반영해 모드 결정 후 반환
+	ProcessingMode evaluate(const GovernorInputs& inputs);
+
+	ProcessingMode getMode() const {
+		return static_cast<ProcessingMode>(mode.load(std::memory_order_acquire));
+	}
+	ProcessingProfile getProfile() const;
+	const ProcessingProfile& profileOf(ProcessingMode mode) const;
+
+	// 이 슬롯을 캡처할지 (캡처 스레드)
+	bool shouldCapture(uint64_t frameSlot) const;
+	// 이 프레임을 AI 서버로 보낼지 (판별 스레드)
+	bool shouldUplink(uint64_t sequence) const;
+
+	static const char* modeName(ProcessingMode mode);
+
+	GovernorStats getStats() const;
+	void logStats() const;
+};
+
+#endif	// PROCESSING_GOVERNOR_H
@@ -0,0 +1,60 @@
+#ifndef PY_BRIDGE_H
+#define PY_BRIDGE_H
+
+#include <Python.h>
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+// GIL 획득/해제 범위 (여러 프레임을 한 번의 획득으로 처리할 때 사용)
+class PyGilGuard {
+private:
+	PyGILState_STATE state;
+
+public:
+	PyGilGuard() : state(PyGILState_Ensure()) {}
+	~PyGilGuard() { PyGILState_Release(state); }
+	PyGilGuard(const PyGilGuard&) = delete;
+	PyGilGuard& operator=(const PyGilGuard&) = delete;
+};
+
+// 한 번 조회한 Python 함수(또는 바운드 메서드) 핸들과 재사용 인자 튜플
+// 호출마다 모듈 import/속성 조회/튜플 생성을 하지 않음
+// 튜플은 호출 후 함수가 참조를 붙잡지 않은 경우에만 다시 사용하고, 붙잡았으면 새로 만듦
+// 모든 메서드는 GIL 을 잡은 상태에서 호출
+class PyCallable {
+private:
+	PyObject* function;
+	PyObject* args;	 // 길이 argCount 인 튜플 (항목은 호출 사이에 교체)
+	Py_ssize_t argCount;
+	std::string name;	 // 로그용 module.function
+
+	void releaseArgs();
+
+public:
+	PyCallable();
+	~PyCallable();
+	PyCallable(const PyCallable&) = delete;
+	PyCallable& operator=(const PyCallable&) = delete;
+
+	// 모듈 함수 조회 (import 는 처음 한 번만)
+	bool resolve(const char* moduleName, const char* functionName, Py_ssize_t argCount);
+	// 객체의 메서드를 바운드 메서드로 조회
+	bool resolveMethod(PyObject* instance, const char* methodName, const std::string& label);
+	void reset();
+	bool isResolved() const { return function != nullptr; }
+
+	// index 번째 인자 설정 (참조를 가져감)
+	void setArg(Py_ssize_t index, PyObject* value);
+	// 호출 후 프레임 버퍼처럼 오래 붙잡으면 안 되는 인자를 None 으로 교체
+	void clearArg(Py_ssize_t index);
+	// 설정된 인자로 호출 (새 참조 반환, 실패 시 nullptr 와 Python 오류 출력)
+	PyObject* call();
+};
+
+// cv::Mat 을 복사 없이 참조하는 읽기 전용 NumPy 배열 (8비트, 행 간격(step) 유지하므로 ROI 도 복사 없음)
+// 반환된 배열이 살아 있는 동안 mat 의 버퍼가 유지되어야 함 (NumPy C API 는 FirmwareManager.cpp 에서 초기화)
+PyObject* wrapMatAsNumpy(const cv::Mat& mat);
+
+#endif	// PY_BRIDGE_H
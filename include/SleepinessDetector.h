@@ -5,22 +5,27 @@
 #include <queue>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include "EyeClosureQueueManagement.h"
 
 class SleepinessDetector {
 private:
-	static const int closureCountForSleepiness = 48;
 	std::string sleepImgPath;
 	std::stack<std::string> sleepImgPathStack;
+	std::vector<uchar> encodeBuffer;	// 프레임 JPEG 버퍼 (프레임마다 재사용)
+	int frameIndex;
 
 public:
 	SleepinessDetector();
 
-	void sendDriverFrame(const cv::Mat& frame);
-	void requestAIDetection(
-			const std::string& uid, const std::string& requestTime,
-			std::function<void(bool success, bool isDrowsy, const std::string& message)> callback);
+	// 프레임 전송 JSON 본문 작성 (base64 를 payload 에 바로 기록)
+	// roi 가 비어 있지 않으면 frame 은 원본 프레임에서 잘라낸 영역이며 "roi":[x,y,w,h] 로 위치를 함께 보냄
+	static void buildFramePayload(const std::string& deviceUid, int frameIdx,
+																const std::vector<uchar>& jpeg, std::string& payload,
+																const cv::Rect& roi = cv::Rect());
+	// 화질 0 이면 OpenCV 기본값
+	void sendDriverFrame(const cv::Mat& frame, int jpegQuality = 0, const cv::Rect& roi = cv::Rect());
 	bool getLocalDetection(EyeClosureQueueManagement& eyeManager);
 	void updateBaseSleepImgPath(const std::string& path);
 };
@@ -0,0 +1,49 @@
+#ifndef SLEEPINESS_EVIDENCE_H
+#define SLEEPINESS_EVIDENCE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FrameRingBuffer.h"
+
+// 졸음 이벤트 하나의 근거 프레임 묶음 (졸음 근거 영상 폴더 대체)
+// 감지 직전 프레임을 링 버퍼에서 복사해 두고, 감지 이후 프레임은 저장 스레드가 채움
+// DBThread 는 수집 완료를 기다린 뒤 메모리에서 바로 영상으로 인코딩함
+class SleepinessEvidence {
+private:
+	const std::string id;					// 감지 시각 yyyyMMdd_HHmmss_fff (기존 폴더 이름)
+	const int64_t detectedAtMs;		// 감지 시각 (steady_clock 밀리초, 인코딩 지연 측정용)
+	const size_t postEventFrames;	// 감지 이후 수집할 프레임 수
+
+	std::mutex evidenceMutex;
+	std::condition_variable completeCondition;
+	std::vector<BufferedFrame> frames;
+	size_t postEventCount;
+	bool complete;
+
+public:
+	SleepinessEvidence(const std::string& id, int64_t detectedAtMs,
+										 std::vector<BufferedFrame> preEventFrames, size_t postEventFrames);
+
+	// 감지 이후 프레임 추가. 목표 개수를 채우면 수집을 완료하고 true 반환
+	bool appendFrame(int64_t timestampMs, const std::string& name, const std::vector<uchar>& jpeg);
+
+	// 목표 개수를 채우지 못해도 수집 종료 (새 졸음 이벤트로 교체되는 경우 등)
+	void markComplete();
+
+	// 수집 완료까지 대기 (시간 초과 시 false, 그때까지 모인 프레임은 그대로 사용 가능)
+	bool waitUntilComplete(std::chrono::milliseconds timeout);
+
+	// 수집된 프레임을 시간순으로 넘겨줌 (이후 추가되는 프레임은 무시됨)
+	std::vector<BufferedFrame> takeFrames();
+
+	bool isComplete();
+	const std::string& getId() const { return id; }
+	int64_t getDetectedAtMs() const { return detectedAtMs; }
+};
+
+#endif	// SLEEPINESS_EVIDENCE_H
@@ -0,0 +1,124 @@
+#ifndef THERMAL_MONITOR_H
+#define THERMAL_MONITOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+// 발열 단계 (값이 클수록 처리량을 더 줄임)
+enum class ThermalLevel { Normal = 0, Elevated = 1, Critical = 2 };
+
+// 단계별 처리 축소 설정
+struct ThermalDegradation {
+	int normalizerDownscale;	// 조명 보정 배경 추정 축소 비율 (기본 8)
+	int jpegQuality;					// 전송/근거 영상 JPEG 화질 상한 (0 이면 기본값 유지)
+	bool skipUplink;					// AI 서버 프레임 전송 중단 (로컬 판별만 사용)
+};
+
+struct ThermalConfig {
+	int sampleIntervalMs = 1000;
+	int historySamples = 30;						 // 온도 상승 추세 계산 구간 (샘플 수)
+	int64_t predictionHorizonMs = 60000;	 // 이 시간 뒤 온도를 추세로 예측
+	float throttleTemperatureC = 80.0f;	 // passive 트립 포인트가 없을 때 사용 (Pi 소프트 스로틀 온도)
+	float elevatedMarginC = 10.0f;			 // 스로틀 온도보다 이만큼 낮아지면 Elevated
+	float criticalMarginC = 4.0f;				 // 스로틀 온도보다 이만큼 낮아지면 Critical
+	float releaseHysteresisC = 3.0f;		 // 단계를 내릴 때는 진입 온도보다 이만큼 더 식어야 함
+	int64_t releaseHoldMs = 30000;			 // 내릴 조건이 이 시간 동안 이어져야 단계 하향
+	float busyUtilization = 0.9f;				 // 이 이상 바쁘면 예측 온도가 낮아도 Elevated
+
+	ThermalDegradation normal{8, 0, false};
+	ThermalDegradation elevated{16, 70, false};
+	ThermalDegradation critical{16, 60, true};
+};
+
+// 발열 감시 통계
+struct ThermalStats {
+	ThermalLevel level;
+	float temperatureC;		 // 가장 뜨거운 thermal zone (알 수 없으면 -1)
+	float trendCPerMin;		 // 최근 온도 변화율
+	float predictedC;			 // predictionHorizonMs 뒤 예측 온도
+	float throttleC;			 // 스로틀 기준 온도
+	float cpuUtilization;	 // 직전 샘플 이후 CPU 사용률 (0~1, 알 수 없으면 -1)
+	bool frequencyCapped;	 // 바쁜데도 CPU 클럭이 최대보다 낮음 (이미 스로틀 중)
+	uint64_t samples;
+	uint64_t levelChanges;
+	int64_t elevatedMs;	 // 단계별 누적 시간
+	int64_t criticalMs;
+};
+
+// CPU 온도/사용률 감시 및 스로틀 예측
+// <root>/sys/class/thermal/thermal_zone*/temp, <root>/proc/stat, cpufreq 를 주기적으로 읽어
+// 온도 추세(최근 구간 선형 회귀) 로 커널 스로틀 전에 단계를 올리고, 식으면 천천히 내림
+// root 를 바꾸면 같은 구조의 임시 디렉터리로 장치 없이 시험할 수 있음
+// sample() 은 한 스레드(감시 스레드 또는 테스트) 에서만 호출하고, 결과는 원자 변수로 공개
+class ThermalMonitor {
+private:
+	const std::string root;
+	const ThermalConfig config;
+	const bool enabled;	 // 비활성화하면 읽기만 하고 항상 Normal
+
+	// sample() 호출 스레드에서만 사용
+	std::deque<std::pair<int64_t, float>> history;	// (시각, 온도)
+	uint64_t previousBusy;
+	uint64_t previousTotal;
+	int64_t releaseSinceMs;	 // 하향 조건이 시작된 시각 (-1 이면 없음)
+	int64_t lastSampledMs;
+
+	std::atomic<int> level;
+	std::atomic<float> temperatureC;
+	std::atomic<float> trendCPerMin;
+	std::atomic<float> predictedC;
+	std::atomic<float> throttleC;
+	std::atomic<float> cpuUtilization;
+	std::atomic<bool> frequencyCapped;
+	std::atomic<uint64_t> sampleCount;
+	std::atomic<uint64_t> levelChanges;
+	std::atomic<int64_t> levelTimeMs[3];
+
+	std::atomic<bool> terminate;
+	std::mutex waitMutex;
+	std::condition_variable waitCondition;
+	std::thread monitorThread;
+
+	void monitorLoop();
+	float readTemperature() const;
+	float readThrottleTemperature() const;
+	float readCpuUtilization();
+	bool readFrequencyCapped() const;
+	float computeTrend() const;
+	ThermalLevel levelFor(float temperature, float predicted, float utilization, float offsetC) const;
+
+public:
+	explicit ThermalMonitor(const std::string& root = "", const ThermalConfig& config = ThermalConfig(),
+													bool enabled = true);
+	~ThermalMonitor();
+
+	// THERMAL_SYSFS_ROOT 로 시뮬레이션 루트 지정, THERMAL_THROTTLE=0 이면 처리 축소 안 함
+	static std::unique_ptr<ThermalMonitor> fromEnvironment();
+
+	void start();
+	void stop();
+
+	// 한 번 읽고 단계 갱신 후 반환 (nowMs 는 단조 증가 시각)
+	ThermalLevel sample(int64_t nowMs);
+
+	ThermalLevel getLevel() const {
+		return static_cast<ThermalLevel>(level.load(std::memory_order_acquire));
+	}
+	const ThermalDegradation& getDegradation() const;
+	float getTemperatureC() const { return temperatureC.load(std::memory_order_relaxed); }
+	float getCpuUtilization() const { return cpuUtilization.load(std::memory_order_relaxed); }
+
+	static const char* levelName(ThermalLevel level);
+
+	ThermalStats getStats() const;
+	void logStats() const;
+};
+
+#endif	// THERMAL_MONITOR_H
@@ -0,0 +1,96 @@
+#ifndef UPLOAD_OUTBOX_H
+#define UPLOAD_OUTBOX_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+// 백엔드 업로드 1회 시도 결과
+enum class UploadResult {
+	Success,		 // 저장 완료
+	RetryLater,	 // 네트워크/서버 오류, 나중에 다시 시도
+	Rejected		 // 서버가 데이터를 거부 (재시도해도 실패하므로 폐기)
+};
+
+// 전송 대기 중인 졸음 근거 영상
+struct OutboxEntry {
+	std::string id;					 // 감지 시각 yyyyMMdd_HHmmss_fff (시간순 정렬 키)
+	std::string detectedAt;	 // 백엔드 전송용 감지 시각 문자열
+	std::string checksum;		 // 영상 SHA256
+	uint64_t size = 0;			 // 영상 바이트 수
+	int attempts = 0;				 // 전송 실패 횟수 (재부팅 시 초기화)
+};
+
+// 디스크 기반 업로드 대기함 (outbox)
+// 영상은 <id>.mp4 파일로, 상태 변화는 추가 전용 저널(journal.log)에 기록하여
+// 전원이 꺼지거나 장시간 오프라인이어도 재부팅 후 이어서 전송함
+// 전송 실패 시 지수 백오프 + 지터로 다음 시도 시각을 늦추고, 디스크 사용량 상한을 넘으면 오래된 영상부터 폐기
+// 한 졸음 구간에서 coalesceWindowMs 이내로 이어진 이벤트는 아직 전송 전이면 최신 영상 하나로 합침
+class UploadOutbox {
+private:
+	const std::string directory;
+	const uint64_t maxBytes;
+	const int64_t coalesceWindowMs;
+
+	mutable std::mutex outboxMutex;
+	std::map<std::string, OutboxEntry> pending;	// id 순 = 감지 시각 순
+	uint64_t pendingBytes;
+	uint64_t evictedCount;
+	uint64_t coalescedCount;
+	uint64_t journalAppends;	// 마지막 압축 이후 저널에 추가한 기록 수
+
+	// 가장 최근에 추가한 영상은 메모리에도 두어 첫 전송 시 디스크에서 다시 읽지 않음
+	std::string cachedId;
+	std::vector<uchar> cachedVideo;
+
+	// 연결 상태는 영상마다 다르지 않으므로 백오프는 대기함 전체에 적용
+	int consecutiveFailures;
+	std::chrono::steady_clock::time_point nextAttemptAt;
+	std::mt19937 jitterEngine;
+
+	std::string contentPath(const std::string& id) const;
+	std::string journalPath() const;
+	bool appendJournal(const std::string& line);
+	void replayJournal();
+	bool compactJournal();
+	void removeEntry(const std::string& id, const char* journalTag);
+
+public:
+	UploadOutbox(const std::string& directory, uint64_t maxBytes = 256ULL * 1024 * 1024,
+							 int64_t coalesceWindowMs = 5000);
+
+	// 디렉토리 생성, 저널 재생으로 미전송 영상 복원 후 저널 압축
+	bool open();
+
+	// 영상 추가 (같은 id 가 이미 있으면 새 영상으로 교체). 상한을 넘으면 오래된 영상부터 폐기
+	// 감지 시각이 coalesceWindowMs 이내로 앞선 대기 영상은 같은 졸음 구간으로 보고 폐기 (최신 영상만 전송)
+	bool enqueue(const std::string& id, const std::string& detectedAt, const std::string& checksum,
+							 std::vector<uchar> video);
+
+	// 지금 전송할 영상 목록 (백오프 중이면 비어 있음, 오래된 순)
+	std::vector<OutboxEntry> dueEntries();
+	bool loadContent(const OutboxEntry& entry, std::vector<uchar>& video) const;
+
+	// 전송 결과 반영
+	void markSent(const std::string& id);
+	void markRejected(const std::string& id);
+	void markRetry(const std::string& id);
+
+	// 마지막 압축 이후 기록이 있으면 남은 영상의 ADD 기록만으로 저널을 다시 씀 (전송 작업 후 호출)
+	bool compact();
+
+	// 다음 전송 시도 가능 시각 (대기 영상이 없으면 false)
+	bool nextAttemptTime(std::chrono::steady_clock::time_point& time) const;
+
+	size_t pendingCount() const;
+	uint64_t getPendingBytes() const;
+	uint64_t getEvictedCount() const;
+	uint64_t getCoalescedCount() const;
+};
+
+#endif	// UPLOAD_OUTBOX_H
@@ -4,9 +4,13 @@
 #include <cstdlib>
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <thread>
 
 void setEnvVar(const std::string& key, const std::string& value);
 
+// 스레드를 특정 CPU 코어에 고정 (Linux 전용, 그 외 환경에서는 무시)
+bool setThreadAffinity(std::thread& thread, int core);
+
 class Utils {
 public:
 	Utils(const std::string& saveDirectory = "./frames");
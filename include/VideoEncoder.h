@@ -5,13 +5,31 @@
 #include <vector>
 #include <opencv2/opencv.hpp>
 
+#include "FrameRingBuffer.h"
+
+// 메모리의 JPEG 프레임을 H.264 fragmented MP4 로 인코딩 (libavcodec/libavformat)
+// 결과는 사용자 정의 AVIO 로 메모리 버퍼에 바로 기록되며 임시 파일이나 외부 프로세스를 쓰지 않음
+// moov 박스가 파일 앞에 오므로 ffmpeg faststart 후처리가 필요 없음
+// 프레임 PTS 는 캡처 시각(timestampMs) 기준이므로 일부 슬롯만 캡처하거나 프레임이 빠져도 실제 속도로 재생됨
 class VideoEncoder {
 private:
     const int frameRate = 24;
     const cv::Size resolution = cv::Size(1280, 720);
+    const int bitRate = 2000000;
+
+    double lastEncodeMs = 0.0;
+    std::string lastCodecName;
+    std::string lastChecksum;
 
 public:
-    std::vector<uchar> convertFramesToMP4(const std::string& path);
+    std::vector<uchar> encodeToMP4(const std::vector<BufferedFrame>& frames);
+
+    // 마지막 인코딩 소요 시간과 사용한 코덱 (하드웨어 인코더 사용 여부 확인용)
+    double getLastEncodeMs() const { return lastEncodeMs; }
+    const std::string& getLastCodecName() const { return lastCodecName; }
+
+    // 마지막으로 인코딩한 영상의 SHA256 (먹싱과 동시에 계산된 16진수 문자열)
+    const std::string& getLastChecksum() const { return lastChecksum; }
 };
 
 #endif
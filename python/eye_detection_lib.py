@@ -41,23 +41,22 @@ def calculate_ear(eye):
     ear = (A + B) / (2.0 * C)
     return ear
 
-def is_eye_closed(frame, threshold=0.25):
+def measure_ear(frame):
     """
-    Determine if eyes are closed in the input frame
+    Measure the eye aspect ratio of the first face in the input frame
     
     Parameters:
     frame (numpy.ndarray): OpenCV image frame
-    threshold (float): EAR threshold, default is 0.25
     
     Returns:
-    bool: True if eyes are closed, False if open
+    float: average EAR of both eyes, or -1.0 if no face was found
     """
     global predictor
     
     if predictor is None:
         if not initialize():
             print("[ERROR] Face predictor has not been initialized")
-            return False
+            return -1.0
     
     try:
         # Resize image
@@ -67,8 +66,7 @@ def is_eye_closed(frame, threshold=0.25):
         rects = detector(frame, 0)
         
         if len(rects) == 0:
-            print("[WARN] Failed to detect face")
-            return False
+            return -1.0
         
         # Detect face landmarks
         shape = predictor(frame, rects[0])
@@ -81,13 +79,29 @@ def is_eye_closed(frame, threshold=0.25):
         # Calculate EAR
         leftEAR = calculate_ear(leftEye)
         rightEAR = calculate_ear(rightEye)
-        both_ear = (leftEAR + rightEAR) / 2.0
-        
-        print(f"[DEBUG] EAR: {both_ear:.3f}, Threshold: {threshold:.3f}")
-        
-        # Compare with threshold to determine if eyes are closed
-        return both_ear < threshold
+        return float((leftEAR + rightEAR) / 2.0)
         
     except Exception as e:
-        print(f"[ERROR] Error occurred while determining eye closure: {e}")
-        return False
\ No newline at end of file
+        print(f"[ERROR] Error occurred while measuring EAR: {e}")
+        return -1.0
+
+def is_eye_closed(frame, threshold=0.25):
+    """
+    Determine if eyes are closed in the input frame
+    
+    Parameters:
+    frame (numpy.ndarray): OpenCV image frame
+    threshold (float): EAR threshold, default is 0.25
+    
+    Returns:
+    bool: True if eyes are closed, False if open
+    """
+    both_ear = measure_ear(frame)
+    if both_ear < 0:
+        print("[WARN] Failed to detect face")
+        return False
+    
+    print(f"[DEBUG] EAR: {both_ear:.3f}, Threshold: {threshold:.3f}")
+    
+    # Compare with threshold to determine if eyes are closed
+    return both_ear < threshold
\ No newline at end of file
@@ -1,146 +1,400 @@
 #include "../include/AccelerationSensor.h"
 
-#include <chrono>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+
+namespace {
+// ADXL345 레지스터
+const uint8_t REG_DEVID = 0x00;
+const uint8_t REG_THRESH_ACT = 0x24;
+const uint8_t REG_ACT_INACT_CTL = 0x27;
+const uint8_t REG_BW_RATE = 0x2C;
+const uint8_t REG_POWER_CTL = 0x2D;
+const uint8_t REG_INT_ENABLE = 0x2E;
+const uint8_t REG_INT_SOURCE = 0x30;
+const uint8_t REG_DATA_FORMAT = 0x31;
+const uint8_t REG_DATAX0 = 0x32;
+const uint8_t REG_FIFO_CTL = 0x38;
+const uint8_t REG_FIFO_STATUS = 0x39;
+
+const uint8_t DEVICE_ID = 0xE5;
+const uint8_t INT_ACTIVITY = 0x10;
+const uint8_t POWER_MEASURE = 0x08;
+const uint8_t FORMAT_FULL_RES_4G = 0x09;			 // 범위와 관계없이 3.9mg/LSB
+const uint8_t ACT_DC_XYZ = 0x70;							 // adafruit enable_motion_detection 과 같은 설정
+const uint8_t FIFO_STREAM = 0x80;
+const uint8_t FIFO_ENTRIES_MASK = 0x3F;
+const int BYTES_PER_ENTRY = 6;
+
+const float STANDARD_GRAVITY = 9.80665f;
+const float SCALE_MS2 = 0.0039f * STANDARD_GRAVITY;
+const float ACTIVITY_LSB_MS2 = 0.0625f * STANDARD_GRAVITY;
+
+int64_t steadyNowUs() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+						 std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
 
-// Helper function to convert Python error to string
-std::string getPythonError() {
-	PyObject *pType, *pValue, *pTraceback;
-	PyErr_Fetch(&pType, &pValue, &pTraceback);
-
-	std::string errorMessage = "Python error: ";
-
-	if (pValue != nullptr) {
-		PyObject* pStr = PyObject_Str(pValue);
-		if (pStr != nullptr) {
-			errorMessage += PyUnicode_AsUTF8(pStr);
-			Py_DECREF(pStr);
-		}
-	}
-
-	Py_XDECREF(pType);
-	Py_XDECREF(pValue);
-	Py_XDECREF(pTraceback);
-
-	return errorMessage;
+// 출력 속도(Hz) 를 BW_RATE 코드로 변환 (100Hz = 0x0A, 두 배마다 1 씩 증가)
+uint8_t rateCode(int sampleRateHz) {
+	int code = 0x0A + static_cast<int>(std::lround(std::log2(std::max(1, sampleRateHz) / 100.0)));
+	return static_cast<uint8_t>(std::min(0x0F, std::max(0x06, code)));
 }
+}	 // namespace
 
-// RealAccelerationSensor implementation
-RealAccelerationSensor::RealAccelerationSensor()
-		: xAcceleration(0.0f),
-			yAcceleration(0.0f),
-			zAcceleration(0.0f),
-			pModule(nullptr),
-			pSensorClass(nullptr),
-			pSensorInstance(nullptr) {
-	if (!initPython()) {
-		std::cerr << "Failed to initialize Python ADXL345 sensor" << std::endl;
+size_t IAccelerationSensor::readSamples(AccelerationSample* samples, size_t capacity) {
+	if (capacity == 0) {
+		return 0;
 	}
+	samples[0] = getAcceleration();
+	return 1;
 }
 
-RealAccelerationSensor::~RealAccelerationSensor() {
-	cleanupPython();
+// Adxl345Sensor implementation
+Adxl345Sensor::Adxl345Sensor(const std::string& busPath, int address, int sampleRateHz,
+														 int activityThreshold)
+		: busPath(busPath),
+			address(address),
+			sampleRateHz(std::max(1, sampleRateHz)),
+			activityThreshold(activityThreshold),
+			fd(-1),
+			pendingActivity(false),
+			unreportedActivity(false),
+			ioErrors(0) {}
+
+Adxl345Sensor::~Adxl345Sensor() {
+	close();
 }
 
-bool RealAccelerationSensor::initPython() {
-	Py_Initialize();
+bool Adxl345Sensor::open() {
+	close();
 
-	// Python 모듈 검색 경로에 현재 디렉터리 추가
-	PyRun_SimpleString("import sys; sys.path.append('.')");
+	fd = ::open(busPath.c_str(), O_RDWR | O_CLOEXEC);
+	if (fd < 0) {
+		std::cerr << "I2C 버스 열기 실패: " << busPath << " (" << std::strerror(errno) << ")"
+							<< std::endl;
+		return false;
+	}
+	if (ioctl(fd, I2C_SLAVE, address) < 0) {
+		std::cerr << "I2C 주소 설정 실패: 0x" << std::hex << address << std::dec << " ("
+							<< std::strerror(errno) << ")" << std::endl;
+		close();
+		return false;
+	}
 
-	// 미리 작성한 파이썬 파일 import
-	pModule = PyImport_ImportModule("adxl345_helper");
-	if (pModule == nullptr) {
-		std::cerr << getPythonError() << std::endl;
+	uint8_t deviceId = 0;
+	if (!readRegisters(REG_DEVID, &deviceId, 1) || deviceId != DEVICE_ID) {
+		std::cerr << "ADXL345 를 찾을 수 없음 (DEVID 0x" << std::hex << static_cast<int>(deviceId)
+							<< std::dec << ")" << std::endl;
+		close();
 		return false;
 	}
-	std::cout << "Python module loaded successfully" << std::endl;
 
-	pSensorClass = PyObject_GetAttrString(pModule, "ADXL345Sensor");
-	if (pSensorClass == nullptr) {
-		std::cerr << getPythonError() << std::endl;
-		Py_DECREF(pModule);
-		pModule = nullptr;
+	// 대기 모드에서 설정 후 측정 시작, FIFO 는 bypass 로 비운 뒤 stream 모드로 전환
+	bool configured = writeRegister(REG_POWER_CTL, 0x00) &&
+										writeRegister(REG_DATA_FORMAT, FORMAT_FULL_RES_4G) &&
+										writeRegister(REG_BW_RATE, rateCode(sampleRateHz)) &&
+										writeRegister(REG_THRESH_ACT, static_cast<uint8_t>(activityThreshold)) &&
+										writeRegister(REG_ACT_INACT_CTL, ACT_DC_XYZ) &&
+										writeRegister(REG_FIFO_CTL, 0x00) &&
+										writeRegister(REG_FIFO_CTL, FIFO_STREAM | (FIFO_DEPTH / 2)) &&
+										writeRegister(REG_INT_ENABLE, INT_ACTIVITY) &&
+										writeRegister(REG_POWER_CTL, POWER_MEASURE);
+	if (!configured) {
+		std::cerr << "ADXL345 설정 실패" << std::endl;
+		close();
 		return false;
 	}
-	std::cout << "Python class loaded successfully" << std::endl;
 
-	pSensorInstance = PyObject_CallObject(pSensorClass, nullptr);
-	if (pSensorInstance == nullptr) {
-		std::cerr << getPythonError() << std::endl;
-		Py_DECREF(pSensorClass);
-		Py_DECREF(pModule);
-		pSensorClass = nullptr;
-		pModule = nullptr;
+	pendingActivity = false;
+	unreportedActivity = false;
+	std::cout << "ADXL345 연결: " << busPath << " 0x" << std::hex << address << std::dec << ", "
+						<< sampleRateHz << "Hz, FIFO stream" << std::endl;
+	return true;
+}
+
+void Adxl345Sensor::close() {
+	if (fd >= 0) {
+		::close(fd);
+		fd = -1;
+	}
+}
+
+bool Adxl345Sensor::readRegisters(uint8_t reg, uint8_t* data, size_t length) {
+	// 레지스터 주소 쓰기와 읽기를 repeated start 로 묶은 한 번의 트랜잭션
+	i2c_msg messages[2];
+	messages[0].addr = static_cast<__u16>(address);
+	messages[0].flags = 0;
+	messages[0].len = 1;
+	messages[0].buf = &reg;
+	messages[1].addr = static_cast<__u16>(address);
+	messages[1].flags = I2C_M_RD;
+	messages[1].len = static_cast<__u16>(length);
+	messages[1].buf = data;
+
+	i2c_rdwr_ioctl_data transfer{messages, 2};
+	if (ioctl(fd, I2C_RDWR, &transfer) < 0) {
+		if (++ioErrors == 1) {
+			std::cerr << "ADXL345 읽기 실패: " << std::strerror(errno) << std::endl;
+		}
 		return false;
 	}
-	std::cout << "Python instance created successfully" << std::endl;
+	return true;
+}
 
+bool Adxl345Sensor::writeRegister(uint8_t reg, uint8_t value) {
+	uint8_t buffer[2] = {reg, value};
+	i2c_msg message;
+	message.addr = static_cast<__u16>(address);
+	message.flags = 0;
+	message.len = 2;
+	message.buf = buffer;
+
+	i2c_rdwr_ioctl_data transfer{&message, 1};
+	if (ioctl(fd, I2C_RDWR, &transfer) < 0) {
+		if (++ioErrors == 1) {
+			std::cerr << "ADXL345 쓰기 실패: " << std::strerror(errno) << std::endl;
+		}
+		return false;
+	}
 	return true;
 }
 
-void RealAccelerationSensor::cleanupPython() {
-	// Clean up Python objects
-	Py_XDECREF(pSensorInstance);
-	Py_XDECREF(pSensorClass);
-	Py_XDECREF(pModule);
+int Adxl345Sensor::readFifoEntries(AccelerationSample* samples, int count) {
+	// DATAX0 부터 6바이트를 읽을 때마다 FIFO 에서 한 항목이 빠지므로, 주소/읽기 쌍을 이어 붙여 한 번에 읽음
+	uint8_t reg = REG_DATAX0;
+	uint8_t buffer[ENTRIES_PER_TRANSFER * BYTES_PER_ENTRY];
+	i2c_msg messages[ENTRIES_PER_TRANSFER * 2];
+
+	int done = 0;
+	while (done < count) {
+		int chunk = std::min(ENTRIES_PER_TRANSFER, count - done);
+		for (int i = 0; i < chunk; ++i) {
+			messages[i * 2].addr = static_cast<__u16>(address);
+			messages[i * 2].flags = 0;
+			messages[i * 2].len = 1;
+			messages[i * 2].buf = &reg;
+			messages[i * 2 + 1].addr = static_cast<__u16>(address);
+			messages[i * 2 + 1].flags = I2C_M_RD;
+			messages[i * 2 + 1].len = BYTES_PER_ENTRY;
+			messages[i * 2 + 1].buf = buffer + i * BYTES_PER_ENTRY;
+		}
+
+		i2c_rdwr_ioctl_data transfer{messages, static_cast<__u32>(chunk * 2)};
+		if (ioctl(fd, I2C_RDWR, &transfer) < 0) {
+			if (++ioErrors == 1) {
+				std::cerr << "ADXL345 FIFO 읽기 실패: " << std::strerror(errno) << std::endl;
+			}
+			break;
+		}
 
-	// Finalize Python interpreter
-	Py_Finalize();
+		for (int i = 0; i < chunk; ++i) {
+			const uint8_t* raw = buffer + i * BYTES_PER_ENTRY;
+			AccelerationSample& sample = samples[done + i];
+			sample.x = static_cast<int16_t>(raw[0] | (raw[1] << 8)) * SCALE_MS2;
+			sample.y = static_cast<int16_t>(raw[2] | (raw[3] << 8)) * SCALE_MS2;
+			sample.z = static_cast<int16_t>(raw[4] | (raw[5] << 8)) * SCALE_MS2;
+			sample.activity = false;
+		}
+		done += chunk;
+	}
+	return done;
 }
 
-std::vector<float> RealAccelerationSensor::getAcceleration() {
-	if (pSensorInstance == nullptr) {
-		return {0.0f, 0.0f, 0.0f};
+bool Adxl345Sensor::pollActivity() {
+	// INT_SOURCE 는 읽으면 해제되므로 읽은 activity 를 샘플 스트림과 isMoving() 양쪽에 넘김
+	uint8_t source = 0;
+	if (readRegisters(REG_INT_SOURCE, &source, 1) && (source & INT_ACTIVITY)) {
+		pendingActivity = true;
+		unreportedActivity = true;
+		return true;
+	}
+	return false;
+}
+
+size_t Adxl345Sensor::readSamples(AccelerationSample* samples, size_t capacity) {
+	if (!isConnected() || capacity == 0) {
+		return 0;
 	}
 
-	// Call get_acceleration method
-	PyObject* pAcceleration = PyObject_CallMethod(pSensorInstance, "get_acceleration", nullptr);
-	if (pAcceleration == nullptr) {
-		std::cerr << getPythonError() << std::endl;
-		return {0.0f, 0.0f, 0.0f};
+	pollActivity();
+	uint8_t status = 0;
+	if (!readRegisters(REG_FIFO_STATUS, &status, 1)) {
+		return 0;
 	}
+	int entries = status & FIFO_ENTRIES_MASK;
+	int count = std::min(entries, static_cast<int>(capacity));
+	if (count == 0) {
+		return 0;
+	}
+
+	int64_t readAtUs = steadyNowUs();
+	count = readFifoEntries(samples, count);
+
+	// 센서 안에 쌓여 있던 시간만큼 측정 시각을 거슬러 올라감
+	const int64_t periodUs = 1000000 / sampleRateHz;
+	for (int i = 0; i < count; ++i) {
+		samples[i].timestampUs = readAtUs - (entries - 1 - i) * periodUs;
+	}
+	if (count > 0) {
+		// 이번에 읽은 activity 만 붙이고 해제 (계속 붙이면 정차로 전환되지 않음)
+		samples[count - 1].activity = unreportedActivity;
+		unreportedActivity = false;
+		latest = samples[count - 1];
+	}
+	return static_cast<size_t>(count);
+}
 
-	// Check if it's a tuple
-	if (!PyTuple_Check(pAcceleration)) {
-		Py_DECREF(pAcceleration);
-		return {0.0f, 0.0f, 0.0f};
+AccelerationSample Adxl345Sensor::getAcceleration() {
+	// 쌓인 샘플을 모두 비우고 가장 최근 값만 사용
+	AccelerationSample drained[FIFO_DEPTH + 1];
+	readSamples(drained, FIFO_DEPTH + 1);
+	return latest;
+}
+
+bool Adxl345Sensor::isMoving() {
+	if (!isConnected()) {
+		return false;
 	}
+	pollActivity();
+	bool moving = pendingActivity;
+	pendingActivity = false;
+	return moving;
+}
 
-	// Extract the x, y, z values
-	PyObject* pX = PyTuple_GetItem(pAcceleration, 0);
-	PyObject* pY = PyTuple_GetItem(pAcceleration, 1);
-	PyObject* pZ = PyTuple_GetItem(pAcceleration, 2);
+// ReplayAccelerationSensor implementation
+ReplayAccelerationSensor::ReplayAccelerationSensor(const std::string& path, bool realtime,
+																									 bool loop)
+		: path(path),
+			realtime(realtime),
+			loop(loop),
+			position(0),
+			loopOffsetUs(0),
+			pendingActivity(false) {}
+
+bool ReplayAccelerationSensor::open() {
+	std::ifstream input(path);
+	if (!input.is_open()) {
+		std::cerr << "가속도 궤적 파일 열기 실패: " << path << std::endl;
+		return false;
+	}
 
-	// Convert to C++ floats
-	xAcceleration = PyFloat_AsDouble(pX);
-	yAcceleration = PyFloat_AsDouble(pY);
-	zAcceleration = PyFloat_AsDouble(pZ);
+	const float activityLimit = 18 * ACTIVITY_LSB_MS2;
+	trace.clear();
+	std::string line;
+	while (std::getline(input, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::istringstream fields(line);
+		double timestampMs = 0.0;
+		AccelerationSample sample;
+		if (!(fields >> timestampMs >> sample.x >> sample.y >> sample.z)) {
+			continue;	 // 헤더 또는 잘못된 줄
+		}
+		int moving = 0;
+		if (fields >> moving) {
+			sample.activity = moving != 0;
+		} else {
+			sample.activity = std::fabs(sample.x) > activityLimit || std::fabs(sample.y) > activityLimit ||
+												std::fabs(sample.z) > activityLimit;
+		}
+		sample.timestampUs = static_cast<int64_t>(std::llround(timestampMs * 1000.0));
+		trace.push_back(sample);
+	}
 
-	Py_DECREF(pAcceleration);
+	if (trace.empty()) {
+		std::cerr << "가속도 궤적에 샘플이 없음: " << path << std::endl;
+		return false;
+	}
 
-	return {xAcceleration, yAcceleration, zAcceleration};
+	position = 0;
+	loopOffsetUs = 0;
+	pendingActivity = false;
+	latest = AccelerationSample{};
+	startedAt = std::chrono::steady_clock::now();
+	std::cout << "가속도 궤적 재생: " << path << " (" << trace.size() << "개 샘플"
+						<< (realtime ? ", 실시간" : "") << ")" << std::endl;
+	return true;
 }
 
-bool RealAccelerationSensor::isMoving() {
-	if (pSensorInstance == nullptr) {
+bool ReplayAccelerationSensor::nextSample(AccelerationSample& sample) {
+	if (trace.empty()) {
 		return false;
 	}
+	if (position >= trace.size()) {
+		if (!loop) {
+			return false;
+		}
+		// 마지막 샘플 뒤에 평균 간격 하나를 두고 처음부터 다시 재생
+		int64_t spanUs = trace.back().timestampUs - trace.front().timestampUs;
+		int64_t gapUs = trace.size() > 1 ? spanUs / static_cast<int64_t>(trace.size() - 1) : 10000;
+		loopOffsetUs += spanUs + gapUs;
+		position = 0;
+	}
 
-	// Call is_moving method
-	PyObject* pIsMoving = PyObject_CallMethod(pSensorInstance, "is_moving", nullptr);
-	if (pIsMoving == nullptr) {
-		std::cerr << getPythonError() << std::endl;
+	int64_t relativeUs = trace[position].timestampUs - trace.front().timestampUs + loopOffsetUs;
+	if (realtime &&
+			relativeUs > std::chrono::duration_cast<std::chrono::microseconds>(
+											 std::chrono::steady_clock::now() - startedAt)
+											 .count()) {
 		return false;
 	}
 
-	// Convert to C++ bool
-	bool isMoving = PyObject_IsTrue(pIsMoving);
+	sample = trace[position++];
+	sample.timestampUs =
+			std::chrono::duration_cast<std::chrono::microseconds>(startedAt.time_since_epoch()).count() +
+			relativeUs;
+	if (sample.activity) {
+		pendingActivity = true;
+	}
+	latest = sample;
+	return true;
+}
 
-	Py_DECREF(pIsMoving);
+AccelerationSample ReplayAccelerationSensor::getAcceleration() {
+	AccelerationSample sample;
+	if (realtime) {
+		while (nextSample(sample)) {
+		}
+	} else {
+		nextSample(sample);
+	}
+	return latest;
+}
+
+size_t ReplayAccelerationSensor::readSamples(AccelerationSample* samples, size_t capacity) {
+	size_t count = 0;
+	while (count < capacity && nextSample(samples[count])) {
+		count++;
+	}
+	return count;
+}
 
-	return isMoving;
+bool ReplayAccelerationSensor::isMoving() {
+	// 실시간 재생이면 지금까지 지난 샘플을 반영, 아니면 이미 읽은 샘플 기준
+	if (realtime) {
+		AccelerationSample sample;
+		while (nextSample(sample)) {
+		}
+	}
+	bool moving = pendingActivity;
+	pendingActivity = false;
+	return moving;
 }
 
 MockAccelerationSensor::MockAccelerationSensor()
@@ -153,7 +407,7 @@ MockAccelerationSensor::MockAccelerationSensor()
 
 MockAccelerationSensor::~MockAccelerationSensor() {}
 
-std::vector<float> MockAccelerationSensor::getAcceleration() {
+AccelerationSample MockAccelerationSensor::getAcceleration() {
 	if (moving) {
 		// 랜덤한 수로 가속도 값 생성
 		xAcceleration = 0.5f + dist(rng);
@@ -165,7 +419,7 @@ std::vector<float> MockAccelerationSensor::getAcceleration() {
 		zAcceleration = 9.8f + dist(rng) * 0.1f;
 	}
 
-	return {xAcceleration, yAcceleration, zAcceleration};
+	return AccelerationSample{steadyNowUs(), xAcceleration, yAcceleration, zAcceleration, moving};
 }
 
 bool MockAccelerationSensor::isMoving() {
@@ -186,20 +440,34 @@ AccelerationSensor::AccelerationSensor(bool useMock) : Device(), useMock(useMock
 	if (useMock) {
 		sensor = std::make_unique<MockAccelerationSensor>();
 	} else {
-		sensor = std::make_unique<RealAccelerationSensor>();
+		sensor = createSensor();
 	}
 }
 
+AccelerationSensor::AccelerationSensor(std::unique_ptr<IAccelerationSensor> sensor)
+		: Device(), sensor(std::move(sensor)), useMock(false) {}
+
 AccelerationSensor::~AccelerationSensor() {}
 
+std::unique_ptr<IAccelerationSensor> AccelerationSensor::createSensor() {
+	// 센서 없이 시험할 때: ACCEL_SOURCE=/path/trace.csv
+	const char* sourceC = std::getenv("ACCEL_SOURCE");
+	std::string source = sourceC ? sourceC : "";
+	if (source == "mock") {
+		return std::make_unique<MockAccelerationSensor>();
+	}
+	if (!source.empty() && source != "i2c") {
+		return std::make_unique<ReplayAccelerationSensor>(source);
+	}
+
+	const char* busC = std::getenv("ACCEL_I2C_BUS");
+	return std::make_unique<Adxl345Sensor>(busC && *busC ? busC : "/dev/i2c-1");
+}
+
 void AccelerationSensor::initialize() {
 	std::cout << "가속도 센서 초기화 중..." << std::endl;
 
-	// Try to get acceleration data to check if sensor is working
-	std::vector<float> accel = sensor->getAcceleration();
-
-	// Check if accelerometer is working
-	bool sensorWorking = true;	// Simplified check
+	bool sensorWorking = sensor->open();
 
 	setConnectionStatus(sensorWorking);
 	updateDeviceStatus(1, sensorWorking);	 // Accelerometer is index 1
@@ -211,6 +479,10 @@ bool AccelerationSensor::isMoving() {
 	return sensor->isMoving();
 }
 
-std::vector<float> AccelerationSensor::getAcceleration() {
+AccelerationSample AccelerationSensor::getAcceleration() {
 	return sensor->getAcceleration();
-}
\ No newline at end of file
+}
+
+size_t AccelerationSensor::readSamples(AccelerationSample* samples, size_t capacity) {
+	return sensor->readSamples(samples, capacity);
+}
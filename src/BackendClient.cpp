@@ -0,0 +1,276 @@
+#include "../include/BackendClient.h"
+
+#if __has_include(<cpr/cpr_version.h>)
+#include <cpr/cpr_version.h>
+#endif
+
+#include <cstdlib>
+#include <iostream>
+
+#include "../include/LatencyMetrics.h"
+
+namespace {
+std::string envOrEmpty(const char* name) {
+	const char* value = std::getenv(name);
+	return value ? std::string(value) : std::string();
+}
+
+cpr::Response makeErrorResponse(const std::string& message) {
+	cpr::Response response;
+	response.error.code = cpr::ErrorCode::INVALID_URL_FORMAT;
+	response.error.message = message;
+	return response;
+}
+}	 // namespace
+
+BackendClient& BackendClient::getInstance() {
+	static BackendClient instance;
+	return instance;
+}
+
+BackendClient::BackendClient()
+		: terminate(false),
+			requestCount(0),
+			retryCount(0),
+			failureCount(0),
+			sessionsCreated(0),
+			sessionsReused(0),
+			asyncDropped(0) {
+	config = loadConfig();
+	for (int i = 0; i < ASYNC_WORKER_COUNT; ++i) {
+		asyncWorkers.emplace_back([this] { asyncLoop(); });
+	}
+}
+
+BackendClient::~BackendClient() {
+	{
+		std::lock_guard<std::mutex> lock(asyncMutex);
+		terminate = true;
+	}
+	asyncCondition.notify_all();
+	for (auto& worker : asyncWorkers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+}
+
+BackendClient::Config BackendClient::loadConfig() const {
+	return Config{envOrEmpty("SERVER_IP"), envOrEmpty("AI_SERVER_IP"), envOrEmpty("DEVICE_UID"),
+								envOrEmpty("EMBEDDED_HASH")};
+}
+
+void BackendClient::reloadConfig() {
+	Config loaded = loadConfig();
+	std::lock_guard<std::mutex> lock(configMutex);
+	config = std::move(loaded);
+}
+
+bool BackendClient::isConfigured(BackendServer server) const {
+	std::lock_guard<std::mutex> lock(configMutex);
+	if (config.deviceUid.empty()) {
+		return false;
+	}
+	if (server == BackendServer::Backend) {
+		return !config.serverIp.empty() && !config.authHash.empty();
+	}
+	return !config.aiServerIp.empty();
+}
+
+std::string BackendClient::getDeviceUid() const {
+	std::lock_guard<std::mutex> lock(configMutex);
+	return config.deviceUid;
+}
+
+std::unique_ptr<cpr::Session> BackendClient::acquireSession(const BackendEndpoint& endpoint) {
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		auto& idle = idleSessions[endpoint.name];
+		if (!idle.empty()) {
+			std::unique_ptr<cpr::Session> session = std::move(idle.back());
+			idle.pop_back();
+			sessionsReused.fetch_add(1, std::memory_order_relaxed);
+			return session;
+		}
+	}
+
+	auto session = std::make_unique<cpr::Session>();
+#if defined(CPR_VERSION_NUM) && CPR_VERSION_NUM >= 0x010600 && LIBCURL_VERSION_NUM >= 0x072F00
+	// HTTPS 는 ALPN 으로 HTTP/2 협상 (서버가 지원하지 않으면 HTTP/1.1 keep-alive)
+	session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+#endif
+	sessionsCreated.fetch_add(1, std::memory_order_relaxed);
+	return session;
+}
+
+void BackendClient::releaseSession(const BackendEndpoint& endpoint,
+																	 std::unique_ptr<cpr::Session> session) {
+	std::lock_guard<std::mutex> lock(poolMutex);
+	auto& idle = idleSessions[endpoint.name];
+	if (idle.size() < MAX_IDLE_SESSIONS) {
+		idle.push_back(std::move(session));
+	}
+}
+
+bool BackendClient::shouldRetry(const cpr::Response& response) {
+	return response.error || response.status_code == 429 || response.status_code >= 500;
+}
+
+cpr::Response BackendClient::perform(const BackendEndpoint& endpoint, Method method,
+																		 const std::string& query,
+																		 const std::function<void(cpr::Session&)>& setBody,
+																		 const std::string& contentType) {
+	std::string baseUrl;
+	cpr::Header headers;
+	{
+		std::lock_guard<std::mutex> lock(configMutex);
+		baseUrl = endpoint.server == BackendServer::Backend ? config.serverIp : config.aiServerIp;
+		if (endpoint.server == BackendServer::Backend) {
+			if (config.authHash.empty()) {
+				baseUrl.clear();
+			}
+			headers["Authorization"] = "Bearer " + config.authHash;
+		}
+	}
+	if (baseUrl.empty()) {
+		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락 (" << endpoint.name << ")"
+							<< std::endl;
+		return makeErrorResponse("환경 변수 설정 오류");
+	}
+	if (!contentType.empty()) {
+		headers["Content-Type"] = contentType;
+	}
+
+	requestCount.fetch_add(1, std::memory_order_relaxed);
+	std::unique_ptr<cpr::Session> session = acquireSession(endpoint);
+	session->SetUrl(cpr::Url{baseUrl + endpoint.path + (query.empty() ? "" : "?" + query)});
+	session->SetTimeout(cpr::Timeout{endpoint.timeout});
+	session->SetHeader(headers);
+	if (setBody) {
+		setBody(*session);
+	}
+
+	cpr::Response response;
+	auto startedAt = std::chrono::steady_clock::now();
+	std::chrono::milliseconds delay = endpoint.retryDelay;
+	for (int attempt = 1;; ++attempt) {
+		switch (method) {
+			case Method::Get:
+				response = session->Get();
+				break;
+			case Method::Post:
+				response = session->Post();
+				break;
+			case Method::Patch:
+				response = session->Patch();
+				break;
+		}
+
+		if (!shouldRetry(response) || attempt >= endpoint.maxAttempts) {
+			break;
+		}
+		retryCount.fetch_add(1, std::memory_order_relaxed);
+		std::this_thread::sleep_for(delay);
+		delay *= 2;
+	}
+
+	if (shouldRetry(response)) {
+		failureCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	// 업로드(POST) 지연만 기록 (진단 GET 은 DiagnosisClient 에서 요청~응답 전체로 기록)
+	if (method == Method::Post) {
+		LatencyMetrics::getInstance().record(
+				LatencyStage::Upload, std::chrono::duration_cast<std::chrono::microseconds>(
+																	std::chrono::steady_clock::now() - startedAt)
+																	.count());
+	}
+	releaseSession(endpoint, std::move(session));
+	return response;
+}
+
+cpr::Response BackendClient::get(const BackendEndpoint& endpoint, const std::string& query) {
+	return perform(endpoint, Method::Get, query, nullptr, "");
+}
+
+cpr::Response BackendClient::post(const BackendEndpoint& endpoint, std::string body,
+																	const std::string& contentType) {
+	return perform(
+			endpoint, Method::Post, "",
+			[&body](cpr::Session& session) { session.SetBody(cpr::Body{std::move(body)}); },
+			contentType);
+}
+
+cpr::Response BackendClient::post(const BackendEndpoint& endpoint,
+																	const cpr::Multipart& multipart) {
+	// Content-Type(boundary) 은 libcurl 이 설정
+	return perform(
+			endpoint, Method::Post, "",
+			[&multipart](cpr::Session& session) { session.SetMultipart(multipart); }, "");
+}
+
+cpr::Response BackendClient::patch(const BackendEndpoint& endpoint, std::string body,
+																	 const std::string& contentType) {
+	return perform(
+			endpoint, Method::Patch, "",
+			[&body](cpr::Session& session) { session.SetBody(cpr::Body{std::move(body)}); },
+			contentType);
+}
+
+void BackendClient::postAsync(const BackendEndpoint& endpoint, std::string body,
+															const std::string& contentType, Callback callback) {
+	auto task = [this, endpoint, body = std::move(body), contentType,
+							 callback = std::move(callback)]() mutable {
+		cpr::Response response = post(endpoint, std::move(body), contentType);
+		if (callback) {
+			callback(response);
+		}
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(asyncMutex);
+		if (terminate) {
+			return;
+		}
+		// 서버가 느리면 오래된 요청부터 버려 메모리가 늘어나지 않도록 함
+		if (asyncQueue.size() >= MAX_ASYNC_PENDING) {
+			asyncQueue.pop_front();
+			asyncDropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		asyncQueue.push_back(std::move(task));
+	}
+	asyncCondition.notify_one();
+}
+
+void BackendClient::asyncLoop() {
+	std::unique_lock<std::mutex> lock(asyncMutex);
+	while (true) {
+		asyncCondition.wait(lock, [this] { return terminate || !asyncQueue.empty(); });
+		if (terminate) {
+			return;	 // 남은 비동기 요청(실시간 프레임)은 버림
+		}
+
+		std::function<void()> task = std::move(asyncQueue.front());
+		asyncQueue.pop_front();
+		lock.unlock();
+
+		try {
+			task();
+		} catch (const std::exception& e) {
+			std::cerr << "비동기 요청 예외: " << e.what() << std::endl;
+		}
+
+		lock.lock();
+	}
+}
+
+BackendClientStats BackendClient::getStats() const {
+	return BackendClientStats{requestCount.load(), retryCount.load(),		 failureCount.load(),
+														sessionsCreated.load(), sessionsReused.load(), asyncDropped.load()};
+}
+
+void BackendClient::logStats() const {
+	BackendClientStats stats = getStats();
+	std::cout << "[Backend] requests " << stats.requests << ", retries " << stats.retries
+						<< ", failures " << stats.failures << ", sessions new/reused " << stats.sessionsCreated
+						<< "/" << stats.sessionsReused << ", async-drop " << stats.asyncDropped << std::endl;
+}
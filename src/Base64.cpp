@@ -0,0 +1,138 @@
+#include "../include/Base64.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BASE64_USE_NEON 1
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <tmmintrin.h>
+#define BASE64_USE_SSSE3 1
+#endif
+
+namespace {
+const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 3바이트 -> 4문자 테이블 인코딩 (SIMD 구간 이후 남은 입력 처리)
+void encodeScalar(const uint8_t* input, size_t inputSize, char* output) {
+	size_t i = 0;
+	for (; i + 3 <= inputSize; i += 3) {
+		uint32_t value = (uint32_t(input[i]) << 16) | (uint32_t(input[i + 1]) << 8) | input[i + 2];
+		output[0] = BASE64_CHARS[(value >> 18) & 0x3F];
+		output[1] = BASE64_CHARS[(value >> 12) & 0x3F];
+		output[2] = BASE64_CHARS[(value >> 6) & 0x3F];
+		output[3] = BASE64_CHARS[value & 0x3F];
+		output += 4;
+	}
+
+	size_t remaining = inputSize - i;
+	if (remaining == 0) {
+		return;
+	}
+
+	uint32_t value = uint32_t(input[i]) << 16;
+	if (remaining == 2) {
+		value |= uint32_t(input[i + 1]) << 8;
+	}
+	output[0] = BASE64_CHARS[(value >> 18) & 0x3F];
+	output[1] = BASE64_CHARS[(value >> 12) & 0x3F];
+	output[2] = remaining == 2 ? BASE64_CHARS[(value >> 6) & 0x3F] : '=';
+	output[3] = '=';
+}
+
+#if defined(BASE64_USE_NEON)
+// 48바이트 -> 64문자
+// vld3 로 3바이트 묶음을 채널별로 나눠 읽고, 6비트 인덱스 4개를 만든 뒤 64바이트 테이블 조회
+size_t encodeSimd(const uint8_t* input, size_t inputSize, char* output) {
+	uint8x16x4_t table;
+	for (int i = 0; i < 4; ++i) {
+		table.val[i] = vld1q_u8(reinterpret_cast<const uint8_t*>(BASE64_CHARS) + 16 * i);
+	}
+	const uint8x16_t mask = vdupq_n_u8(0x3F);
+
+	size_t consumed = 0;
+	for (; consumed + 48 <= inputSize; consumed += 48) {
+		uint8x16x3_t in = vld3q_u8(input + consumed);
+		uint8x16x4_t indices;
+		indices.val[0] = vshrq_n_u8(in.val[0], 2);
+		indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+		indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+		indices.val[3] = vandq_u8(in.val[2], mask);
+
+		uint8x16x4_t chars;
+		for (int i = 0; i < 4; ++i) {
+			chars.val[i] = vqtbl4q_u8(table, indices.val[i]);
+		}
+		vst4q_u8(reinterpret_cast<uint8_t*>(output), chars);
+		output += 64;
+	}
+	return consumed;
+}
+#elif defined(BASE64_USE_SSSE3)
+// 빌드 옵션(-mssse3) 없이도 SSSE3 를 쓰도록 함수 단위로 활성화하고, 실행 시 CPU 지원 여부 확인
+bool cpuSupportsSsse3() {
+	static const bool supported = __builtin_cpu_supports("ssse3");
+	return supported;
+}
+
+// 12바이트 -> 16문자 (16바이트를 읽으므로 입력이 16바이트 이상 남았을 때만 사용)
+// 바이트 재배치 후 곱셈으로 6비트 인덱스를 분리하고, 구간별 오프셋을 더해 문자로 변환
+__attribute__((target("ssse3"))) size_t encodeSsse3(const uint8_t* input, size_t inputSize,
+																										char* output) {
+	const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+	const __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+																				 '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+																				 '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	size_t consumed = 0;
+	for (; consumed + 16 <= inputSize; consumed += 12) {
+		__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+		in = _mm_shuffle_epi8(in, shuffle);
+
+		const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+		const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+		const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		const __m128i indices = _mm_or_si128(t1, t3);
+
+		// 0..25 -> 13, 26..51 -> 0, 52..63 -> 1..12 로 접은 뒤 오프셋 테이블 조회
+		__m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+		const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(shiftLut, reduced), indices);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output), chars);
+		output += 16;
+	}
+	return consumed;
+}
+
+size_t encodeSimd(const uint8_t* input, size_t inputSize, char* output) {
+	return cpuSupportsSsse3() ? encodeSsse3(input, inputSize, output) : 0;
+}
+#else
+size_t encodeSimd(const uint8_t*, size_t, char*) {
+	return 0;
+}
+#endif
+}	 // namespace
+
+void base64Encode(const uint8_t* input, size_t inputSize, char* output) {
+	// SIMD 구간은 항상 3의 배수만큼 처리하므로 나머지는 이어서 테이블로 인코딩
+	size_t consumed = encodeSimd(input, inputSize, output);
+	encodeScalar(input + consumed, inputSize - consumed, output + consumed / 3 * 4);
+}
+
+void base64Append(const uint8_t* input, size_t inputSize, std::string& output) {
+	size_t offset = output.size();
+	output.resize(offset + base64EncodedSize(inputSize));
+	base64Encode(input, inputSize, &output[offset]);
+}
+
+const char* base64Implementation() {
+#if defined(BASE64_USE_NEON)
+	return "neon";
+#elif defined(BASE64_USE_SSSE3)
+	return cpuSupportsSsse3() ? "ssse3" : "scalar";
+#else
+	return "scalar";
+#endif
+}
@@ -1,44 +1,70 @@
 #include "../include/Camera.h"
 
+#include <cstdlib>
 #include <iostream>
 
 Camera::Camera() : Device() {
-	resolution = {1920, 1080};
+	// ISP 가 판별용 저해상도와 근거 영상용 720p 를 함께 출력 (CPU 리사이즈 없음)
+	resolution = {640, 360};
+	evidenceResolution = {1280, 720};
+	framerate = 24;
 	cameraName =
 			"/base/soc/i2c0mux/i2c@1/ov5647@36";	// 기본 카메라 경로 (실제 환경에 맞게 수정 필요)
 }
 
 Camera::~Camera() {
-	if (cap.isOpened()) {
-		cap.release();
+	if (source) {
+		source->close();
 	}
 }
 
+std::unique_ptr<CaptureSource> Camera::createSource() const {
+	// 카메라 없이 시험할 때: CAMERA_SOURCE=/path/video.mp4 (또는 frame_%04d.jpg)
+	const char* sourceC = std::getenv("CAMERA_SOURCE");
+	if (sourceC && std::string(sourceC) != "" && std::string(sourceC) != "camera") {
+		return std::make_unique<VideoCaptureSource>(sourceC, cv::CAP_ANY, true);
+	}
+
+	cv::Size evidenceSize(evidenceResolution[0], evidenceResolution[1]);
+#ifdef USE_GSTREAMER
+	// CAMERA_DUAL_STREAM=0: 두 번째 스트림을 지원하지 않는 카메라는 근거 영상 해상도 하나만 받음
+	const char* dualStreamC = std::getenv("CAMERA_DUAL_STREAM");
+	if (dualStreamC && std::string(dualStreamC) == "0") {
+		return std::make_unique<GstCaptureSource>(
+				GstCaptureSource::libcameraPipeline(cameraName, evidenceSize, cv::Size(), framerate));
+	}
+	return std::make_unique<GstCaptureSource>(GstCaptureSource::libcameraPipeline(
+			cameraName, cv::Size(resolution[0], resolution[1]), evidenceSize, framerate));
+#else
+	// GStreamer 개발 패키지 없이 빌드한 경우 OpenCV 캡처 사용 (BGR 변환 및 복사 발생)
+	// appsink 가 하나뿐이므로 근거 영상 해상도 단일 스트림으로 판별
+	std::string pipeline = "libcamerasrc camera-name=" + cameraName +
+												 " ! video/x-raw,width=" + std::to_string(evidenceSize.width) +
+												 ",height=" + std::to_string(evidenceSize.height) +
+												 ",framerate=" + std::to_string(framerate) + "/1,format=RGBx" +
+												 " ! videoconvert ! video/x-raw,format=BGR ! appsink";
+	return std::make_unique<VideoCaptureSource>(pipeline, cv::CAP_GSTREAMER, false);
+#endif
+}
+
 void Camera::initialize() {
 	std::cout << "카메라 초기화 중..." << std::endl;
 
-	// GStreamer 파이프라인 구성
-	gstreamerPipeline = "libcamerasrc camera-name=" + cameraName +
-											" ! video/x-raw,width=" + std::to_string(resolution[0]) +
-											",height=" + std::to_string(resolution[1]) + ",framerate=10/1,format=RGBx" +
-											" ! videoconvert ! videoscale" + " ! video/x-raw,format=BGR" + " ! appsink";
-
-	// GStreamer 파이프라인으로 카메라 열기
-	cap.open(gstreamerPipeline, cv::CAP_GSTREAMER);
+	if (source) {
+		source->close();
+	}
+	source = createSource();
 
-	if (!cap.isOpened()) {
-		std::cerr << "Error: Could not open camera with GStreamer pipeline." << std::endl;
-		std::cerr << "Pipeline: " << gstreamerPipeline << std::endl;
+	if (!source->open()) {
+		std::cerr << "Error: Could not open camera: " << source->describe() << std::endl;
 		setConnectionStatus(false);
 		updateDeviceStatus(0, false);	 // Camera is index 0
 		return;
 	}
 
 	// 테스트 프레임 캡처
-	cv::Mat testFrame;
-	bool success = cap.read(testFrame);
-
-	if (!success || testFrame.empty()) {
+	CapturedFrame testFrame;
+	if (!source->read(testFrame) || testFrame.image.empty()) {
 		std::cerr << "Error: Could not capture test frame." << std::endl;
 		setConnectionStatus(false);
 		updateDeviceStatus(0, false);	 // Camera is index 0
@@ -46,33 +72,43 @@ void Camera::initialize() {
 	}
 
 	// 카메라 작동 중
-	std::cout << "Camera initialized successfully!" << std::endl;
+	std::cout << "Camera initialized successfully! (" << source->describe() << ")" << std::endl;
 	setConnectionStatus(true);
 	updateDeviceStatus(0, true);	// Camera is index 0
 }
 
-cv::Mat Camera::captureFrame() {
-	if (!cap.isOpened()) {
+bool Camera::capture(CapturedFrame& frame, std::chrono::milliseconds timeout) {
+	if (!source || !source->isOpened()) {
 		std::cerr << "Error: Camera is not open. Attempting to initialize..." << std::endl;
 		initialize();
 
-		if (!cap.isOpened()) {
+		if (!source->isOpened()) {
 			setCameraStatus(false);
-			return cv::Mat();
+			return false;
 		}
 	}
 
-	cv::Mat frame;
-	bool success = cap.read(frame);
-
-	if (!success || frame.empty()) {
+	if (!source->read(frame, timeout) || frame.image.empty()) {
 		std::cerr << "Error: Failed to capture frame." << std::endl;
 		setCameraStatus(false);
-		return cv::Mat();
+		return false;
 	}
 
 	setCameraStatus(true);
-	return frame;
+	return true;
+}
+
+bool Camera::isLive() const {
+	return source && source->isLive();
+}
+
+cv::Mat Camera::captureFrame() {
+	CapturedFrame frame;
+	if (!capture(frame)) {
+		return cv::Mat();
+	}
+	// 캡처 버퍼 뷰는 owner 와 함께 사라지므로 복사해서 반환
+	return frame.owner ? frame.image.clone() : frame.image;
 }
 
 void Camera::setCameraStatus(bool status) {
@@ -90,8 +126,8 @@ bool Camera::getCameraStatus() const {
 
 void Camera::setResolution(int width, int height) {
 	// 이미 열려있는 경우 닫기
-	if (cap.isOpened()) {
-		cap.release();
+	if (source) {
+		source->close();
 	}
 
 	resolution[0] = width;
@@ -103,4 +139,4 @@ void Camera::setResolution(int width, int height) {
 
 std::vector<int> Camera::getResolution() const {
 	return resolution;
-}
\ No newline at end of file
+}
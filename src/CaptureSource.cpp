@@ -0,0 +1,356 @@
+#include "../include/CaptureSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef USE_GSTREAMER
+#include <gst/app/gstappsink.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#endif
+
+// ===== VideoCaptureSource =====
+
+VideoCaptureSource::VideoCaptureSource(const std::string& location, int apiPreference, bool loop)
+		: location(location), apiPreference(apiPreference), loop(loop), frameCount(0), live(false) {}
+
+bool VideoCaptureSource::open() {
+	if (!cap.open(location, apiPreference)) {
+		std::cerr << "캡처 소스를 열 수 없음: " << location << std::endl;
+		return false;
+	}
+	frameCount = 0;
+	live = cap.get(cv::CAP_PROP_FRAME_COUNT) <= 0;
+	return true;
+}
+
+void VideoCaptureSource::close() {
+	if (cap.isOpened()) {
+		cap.release();
+	}
+}
+
+bool VideoCaptureSource::isOpened() const {
+	return cap.isOpened();
+}
+
+bool VideoCaptureSource::read(CapturedFrame& frame, std::chrono::milliseconds /*timeout*/) {
+	// 패킷이 이전 프레임을 계속 참조할 수 있으므로 매번 새 버퍼에 읽음
+	frame = CapturedFrame();
+	if (!cap.read(frame.image) || frame.image.empty()) {
+		if (!loop || frameCount == 0) {
+			return false;
+		}
+		// 파일 끝: 처음부터 다시 재생 (이미지 시퀀스도 동일하게 동작하도록 다시 열기)
+		close();
+		if (!open() || !cap.read(frame.image) || frame.image.empty()) {
+			return false;
+		}
+	}
+
+	frameCount++;
+	frame.sensorTimestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+																std::chrono::steady_clock::now().time_since_epoch())
+																.count();
+	return true;
+}
+
+std::string VideoCaptureSource::describe() const {
+	return "VideoCapture(" + location + (loop ? ", loop" : "") + ")";
+}
+
+// ===== GstCaptureSource =====
+
+#ifdef USE_GSTREAMER
+namespace {
+// appsink 에서 받은 샘플과 매핑 정보 (마지막 뷰가 사라질 때 해제되어 버퍼가 파이프라인으로 돌아감)
+struct MappedSample {
+	GstSample* sample;
+	GstVideoFrame videoFrame;
+	std::shared_ptr<std::atomic<int>> outstanding;
+};
+
+void releaseMappedSample(MappedSample* mapped) {
+	gst_video_frame_unmap(&mapped->videoFrame);
+	gst_sample_unref(mapped->sample);
+	mapped->outstanding->fetch_sub(1);
+	delete mapped;
+}
+
+// 판별/근거 스트림 버퍼를 함께 붙잡는 소유권
+struct DualStreamOwner {
+	std::shared_ptr<void> analysis;
+	std::shared_ptr<void> evidence;
+};
+
+int64_t samplePts(GstSample* sample) {
+	GstBuffer* buffer = gst_sample_get_buffer(sample);
+	return buffer && GST_BUFFER_PTS_IS_VALID(buffer) ? static_cast<int64_t>(GST_BUFFER_PTS(buffer))
+																									 : -1;
+}
+
+// 샘플을 매핑해 뷰를 만듦 (luma: 판별용 영상, nv12: NV12 전체, NV12 가 아니면 비어 있음)
+// 성공하면 샘플 소유권이 반환된 owner 로 넘어가고, 실패하면 샘플을 해제하고 nullptr
+std::shared_ptr<void> mapSample(GstSample* sample,
+																const std::shared_ptr<std::atomic<int>>& outstanding,
+																cv::Mat& luma, cv::Mat& nv12) {
+	GstVideoInfo info;
+	GstCaps* caps = gst_sample_get_caps(sample);
+	GstBuffer* buffer = gst_sample_get_buffer(sample);
+	if (!caps || !buffer || !gst_video_info_from_caps(&info, caps)) {
+		gst_sample_unref(sample);
+		return nullptr;
+	}
+
+	auto* mapped = new MappedSample{sample, GstVideoFrame(), outstanding};
+	if (!gst_video_frame_map(&mapped->videoFrame, &info, buffer, GST_MAP_READ)) {
+		gst_sample_unref(sample);
+		delete mapped;
+		return nullptr;
+	}
+	outstanding->fetch_add(1);
+	std::shared_ptr<void> owner(mapped, releaseMappedSample);
+
+	const int width = GST_VIDEO_INFO_WIDTH(&info);
+	const int height = GST_VIDEO_INFO_HEIGHT(&info);
+	auto* plane0 = static_cast<uchar*>(GST_VIDEO_FRAME_PLANE_DATA(&mapped->videoFrame, 0));
+	const size_t stride0 = GST_VIDEO_FRAME_PLANE_STRIDE(&mapped->videoFrame, 0);
+
+	switch (GST_VIDEO_INFO_FORMAT(&info)) {
+		case GST_VIDEO_FORMAT_NV12: {
+			luma = cv::Mat(height, width, CV_8UC1, plane0, stride0);
+
+			auto* plane1 = static_cast<uchar*>(GST_VIDEO_FRAME_PLANE_DATA(&mapped->videoFrame, 1));
+			const size_t stride1 = GST_VIDEO_FRAME_PLANE_STRIDE(&mapped->videoFrame, 1);
+			if (stride1 == stride0 && plane1 == plane0 + stride0 * height) {
+				nv12 = cv::Mat(height * 3 / 2, width, CV_8UC1, plane0, stride0);
+			} else {
+				// 평면이 떨어져 있으면 컬러 변환용 버퍼만 복사
+				nv12.create(height * 3 / 2, width, CV_8UC1);
+				luma.copyTo(nv12.rowRange(0, height));
+				cv::Mat(height / 2, width, CV_8UC1, plane1, stride1)
+						.copyTo(nv12.rowRange(height, height * 3 / 2));
+			}
+			break;
+		}
+		case GST_VIDEO_FORMAT_GRAY8:
+			luma = cv::Mat(height, width, CV_8UC1, plane0, stride0);
+			break;
+		case GST_VIDEO_FORMAT_BGR:
+			luma = cv::Mat(height, width, CV_8UC3, plane0, stride0);
+			break;
+		default:
+			std::cerr << "지원하지 않는 캡처 포맷: " << GST_VIDEO_INFO_NAME(&info) << std::endl;
+			luma = cv::Mat();
+			nv12 = cv::Mat();
+			return nullptr;
+	}
+	return owner;
+}
+}	 // namespace
+
+GstCaptureSource::GstCaptureSource(const std::string& pipelineDescription, int maxOutstanding)
+		: pipelineDescription(pipelineDescription),
+			maxOutstanding(std::max(1, maxOutstanding)),
+			pipeline(nullptr),
+			sink(nullptr),
+			evidenceSink(nullptr),
+			pendingEvidence(nullptr),
+			outstanding(std::make_shared<std::atomic<int>>(0)),
+			evidenceOutstanding(std::make_shared<std::atomic<int>>(0)),
+			zeroCopyFrames(0),
+			copiedFrames(0),
+			unmatchedFrames(0) {}
+
+GstCaptureSource::~GstCaptureSource() {
+	close();
+}
+
+std::string GstCaptureSource::libcameraPipeline(const std::string& cameraName,
+																								const cv::Size& analysisSize,
+																								const cv::Size& evidenceSize, int framerate) {
+	auto nv12Caps = [framerate](const cv::Size& size) {
+		return "video/x-raw,format=NV12,width=" + std::to_string(size.width) +
+					 ",height=" + std::to_string(size.height) + ",framerate=" + std::to_string(framerate) +
+					 "/1";
+	};
+	const std::string appsink = "appsink max-buffers=2 drop=true sync=false";
+
+	// ISP 가 바로 출력하는 NV12 를 요청 (videoconvert/videoscale 없음)
+	if (evidenceSize.area() == 0) {
+		return "libcamerasrc camera-name=" + cameraName + " ! " + nv12Caps(analysisSize) + " ! " +
+					 appsink + " name=sink";
+	}
+
+	// 한 번의 요청으로 두 스트림을 함께 출력하므로 두 버퍼의 타임스탬프가 같음
+	// (큰 스트림을 첫 번째 패드에 연결해야 ISP 의 주 출력에 배정됨)
+	return "libcamerasrc name=cs camera-name=" + cameraName + " cs.src ! " +
+				 nv12Caps(evidenceSize) + " ! queue ! " + appsink + " name=evidence cs.src_0 ! " +
+				 nv12Caps(analysisSize) + " ! queue ! " + appsink + " name=sink";
+}
+
+bool GstCaptureSource::open() {
+	if (pipeline) {
+		return true;
+	}
+	if (!gst_is_initialized()) {
+		gst_init(nullptr, nullptr);
+	}
+
+	GError* error = nullptr;
+	pipeline = gst_parse_launch(pipelineDescription.c_str(), &error);
+	if (error) {
+		std::cerr << "GStreamer 파이프라인 생성 실패: " << error->message << std::endl;
+		g_error_free(error);
+		close();
+		return false;
+	}
+
+	sink = pipeline ? gst_bin_get_by_name(GST_BIN(pipeline), "sink") : nullptr;
+	if (!sink) {
+		std::cerr << "GStreamer 파이프라인에 appsink(name=sink) 가 없음" << std::endl;
+		close();
+		return false;
+	}
+	evidenceSink = gst_bin_get_by_name(GST_BIN(pipeline), "evidence");
+
+	if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+		std::cerr << "GStreamer 파이프라인 시작 실패" << std::endl;
+		close();
+		return false;
+	}
+	return true;
+}
+
+void GstCaptureSource::close() {
+	if (pipeline) {
+		gst_element_set_state(pipeline, GST_STATE_NULL);
+	}
+	if (pendingEvidence) {
+		gst_sample_unref(pendingEvidence);
+		pendingEvidence = nullptr;
+	}
+	if (evidenceSink) {
+		gst_object_unref(evidenceSink);
+		evidenceSink = nullptr;
+	}
+	if (sink) {
+		gst_object_unref(sink);
+		sink = nullptr;
+	}
+	if (pipeline) {
+		gst_object_unref(pipeline);
+		pipeline = nullptr;
+	}
+}
+
+bool GstCaptureSource::isOpened() const {
+	return sink != nullptr;
+}
+
+GstSample* GstCaptureSource::pullMatchingEvidence(int64_t timestampNs) {
+	// 두 appsink 는 각자 오래된 버퍼를 버리므로 한쪽이 앞서 있을 수 있음
+	// 판별 프레임보다 오래된 근거 프레임은 버리고, 더 새로운 것은 다음 판별 프레임을 위해 남겨 둠
+	while (true) {
+		if (!pendingEvidence) {
+			// 같은 요청의 버퍼는 거의 동시에 도착하므로 짧게만 기다림
+			pendingEvidence =
+					gst_app_sink_try_pull_sample(GST_APP_SINK(evidenceSink), 20 * GST_MSECOND);
+			if (!pendingEvidence) {
+				return nullptr;
+			}
+		}
+
+		int64_t evidenceNs = samplePts(pendingEvidence);
+		if (timestampNs < 0 || evidenceNs < 0) {
+			// 타임스탬프가 없으면 도착 순서대로 짝을 맞춤
+			break;
+		}
+		if (evidenceNs < timestampNs - TIMESTAMP_TOLERANCE_NS) {
+			gst_sample_unref(pendingEvidence);
+			pendingEvidence = nullptr;
+			continue;
+		}
+		if (evidenceNs > timestampNs + TIMESTAMP_TOLERANCE_NS) {
+			return nullptr;
+		}
+		break;
+	}
+
+	GstSample* matched = pendingEvidence;
+	pendingEvidence = nullptr;
+	return matched;
+}
+
+bool GstCaptureSource::read(CapturedFrame& frame, std::chrono::milliseconds timeout) {
+	frame = CapturedFrame();
+	if (!sink) {
+		return false;
+	}
+
+	// 다음 샘플이 도착하는 즉시 반환 (프레임 주기는 카메라가 정함)
+	GstSample* sample = gst_app_sink_try_pull_sample(
+			GST_APP_SINK(sink), static_cast<GstClockTime>(timeout.count()) * GST_MSECOND);
+	if (!sample) {
+		if (gst_app_sink_is_eos(GST_APP_SINK(sink))) {
+			// 끝난 파이프라인은 다시 샘플을 내지 않으므로 닫아서 Camera 가 재초기화하도록 함
+			std::cerr << "GStreamer 스트림 종료" << std::endl;
+			close();
+		}
+		return false;
+	}
+
+	frame.sensorTimestampNs = samplePts(sample);
+	cv::Mat analysisNv12;
+	std::shared_ptr<void> owner = mapSample(sample, outstanding, frame.image, analysisNv12);
+	if (!owner) {
+		frame = CapturedFrame();
+		return false;
+	}
+	bool copyFrame = outstanding->load() > maxOutstanding;
+
+	std::shared_ptr<void> evidenceOwner;
+	if (evidenceSink) {
+		GstSample* evidenceSample = pullMatchingEvidence(frame.sensorTimestampNs);
+		cv::Mat evidenceLuma;
+		if (evidenceSample) {
+			evidenceOwner = mapSample(evidenceSample, evidenceOutstanding, evidenceLuma, frame.evidence);
+		}
+		if (evidenceOwner) {
+			copyFrame = copyFrame || evidenceOutstanding->load() > maxOutstanding;
+		} else {
+			// 근거 프레임을 놓친 경우 비워 둠 (저해상도 판별 프레임을 확대해 근거 영상에 섞지 않음)
+			unmatchedFrames++;
+		}
+	} else {
+		// 단일 스트림이면 같은 프레임을 근거 영상으로 사용
+		frame.evidence = analysisNv12;
+	}
+	if (frame.sensorTimestampNs < 0) {
+		frame.sensorTimestampNs = 0;
+	}
+
+	if (copyFrame) {
+		// 파이프라인 버퍼가 부족해지지 않도록 복사 후 즉시 반환
+		frame.image = frame.image.clone();
+		if (!frame.evidence.empty()) {
+			frame.evidence = frame.evidence.clone();
+		}
+		copiedFrames++;
+	} else {
+		if (evidenceOwner) {
+			frame.owner = std::make_shared<DualStreamOwner>(
+					DualStreamOwner{std::move(owner), std::move(evidenceOwner)});
+		} else {
+			frame.owner = std::move(owner);
+		}
+		zeroCopyFrames++;
+	}
+	return true;
+}
+
+std::string GstCaptureSource::describe() const {
+	return "GStreamer appsink(" + pipelineDescription + ")";
+}
+#endif
@@ -1,124 +1,73 @@
 #include "../include/DBThread.h"
 
 #include <cpr/cpr.h>
-#include <openssl/evp.h>
-#include <openssl/sha.h>
 
 #include <chrono>
 #include <ctime>
-#include <filesystem>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <random>
 #include <sstream>
 #include <thread>
 #include <vector>
 
+#include "../include/BackendClient.h"
 #include "../include/DBThreadMonitoring.h"
+#include "../include/LatencyMetrics.h"
 
 namespace {
-std::string generateTempFilePath() {
-	std::filesystem::path tempDir = std::filesystem::temp_directory_path();
-	std::stringstream ss;
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<> dis(0, 15);
-
-	ss << "temp_video_";
-	for (int i = 0; i < 8; ++i) {
-		ss << std::hex << dis(gen);
-	}
-	ss << ".mp4";
-
-	// tempDir / filename
-	std::filesystem::path tempFilePath = tempDir / ss.str();
-	return tempFilePath.string();
-}
-
-// SHA256 해시 계산 함수
-std::string calculateSHA256(const std::vector<uchar>& data) {
-	EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
-	if (mdctx == nullptr) {
-		std::cerr << "EVP_MD_CTX_new 실패" << std::endl;
-		return "";
-	}
-
-	if (EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr) != 1) {
-		std::cerr << "EVP_DigestInit_ex 실패" << std::endl;
-		EVP_MD_CTX_free(mdctx);
-		return "";
-	}
-
-	if (EVP_DigestUpdate(mdctx, data.data(), data.size()) != 1) {
-		std::cerr << "EVP_DigestUpdate 실패" << std::endl;
-		EVP_MD_CTX_free(mdctx);
-		return "";
-	}
-
-	unsigned char hash[EVP_MAX_MD_SIZE];
-	unsigned int hash_len;
-	if (EVP_DigestFinal_ex(mdctx, hash, &hash_len) != 1) {
-		std::cerr << "EVP_DigestFinal_ex 실패" << std::endl;
-		EVP_MD_CTX_free(mdctx);
-		return "";
-	}
-
-	EVP_MD_CTX_free(mdctx);
-
-	// 바이트를 16진수 문자열로 변환
-	std::stringstream ss;
-	for (unsigned int i = 0; i < hash_len; i++) {
-		ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
-	}
-
-	return ss.str();
-}
+// 감지 이후 프레임 수집(약 2.5초)을 기다리는 최대 시간
+const std::chrono::milliseconds EVIDENCE_WAIT_TIMEOUT(5000);
 }	 // namespace
 
-DBThread::DBThread(const std::string& uid, const std::string& folder, DBThreadMonitoring* monitor)
-		: deviceUid(uid), folderPath(folder), monitoring(monitor) {
-	time = std::filesystem::last_write_time(folderPath);
-}
+DBThread::DBThread(const std::string& uid, std::shared_ptr<SleepinessEvidence> evidence,
+									 DBThreadMonitoring* monitor)
+		: deviceUid(uid), evidence(std::move(evidence)), monitoring(monitor) {}
 
 DBThread::~DBThread() {}
 
-void DBThread::deleteFolderSafe(const std::string& path) {
-	try {
-		std::filesystem::remove_all(path);
-		std::cout << "[DBThread] 폴더 삭제 성공: " << path << std::endl;
-	} catch (const std::filesystem::filesystem_error& e) {
-		std::cerr << "[DBThread] 폴더 삭제 실패: " << e.what() << std::endl;
-	}
-}
-
 bool DBThread::sendDataToDB() {
 	VideoEncoder encoder;
-	std::cout << "백서버 통신 전 이미지 데이터들을 영상 데이터로 변환" << std::endl;
+	std::cout << "백서버 통신 전 졸음 근거 프레임들을 영상 데이터로 변환" << std::endl;
 
-	// 폴더에 이미지 프레임 충분히 수집될 때까지 sleep
-	std::this_thread::sleep_for(std::chrono::seconds(3));
+	// 감지 이후 프레임이 충분히 수집될 때까지 대기 (시간 초과 시 모인 프레임만 사용)
+	if (!evidence->waitUntilComplete(EVIDENCE_WAIT_TIMEOUT)) {
+		std::cerr << "졸음 근거 프레임 수집 시간 초과, 수집된 프레임으로 영상 생성" << std::endl;
+	}
 
-	std::vector<uchar> videoData = encoder.convertFramesToMP4(folderPath);
+	std::vector<uchar> videoData;
+	{
+		ScopedLatency timer(LatencyStage::VideoEncode);
+		videoData = encoder.encodeToMP4(evidence->takeFrames());
+	}
 	if (videoData.empty()) {
 		std::cerr << "영상 생성 실패로 영상 전송 통신 취소." << std::endl;
 		setIsDBThreadRunningFalse();
 		return false;
 	}
 
-	bool success = sendVideoToBackend(videoData);
+	// 졸음 감지 시점부터 업로드 가능한 영상이 준비되기까지의 지연 (수집 대기 포함)
+	int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+											std::chrono::steady_clock::now().time_since_epoch())
+											.count();
+	std::cout << "졸음 감지 -> 영상 준비 지연: " << (nowMs - evidence->getDetectedAtMs())
+						<< "ms (인코딩 " << encoder.getLastEncodeMs() << "ms)" << std::endl;
 
-	if (success) {
-		std::cout << "백엔드 영상 저장 성공, 로컬 폴더 삭제 : " << folderPath << std::endl;
-		deleteFolderSafe(folderPath);
-		setIsDBThreadRunningFalse();
-		return true;
-	} else {
-		std::cerr << "백엔드 전송 실패, 로컬 폴더 삭제 : " << folderPath << std::endl;
-		deleteFolderSafe(folderPath);
+	std::string detectedAt = getDetectedAt();
+	if (detectedAt.empty()) {
+		std::cerr << "detectedAt 추출 실패" << std::endl;
 		setIsDBThreadRunningFalse();
 		return false;
 	}
+
+	// 전송은 업로드 대기함(outbox)에 맡김 (오프라인이어도 디스크에 보관 후 재전송)
+	bool queued = monitoring && monitoring->enqueueEvidence(evidence->getId(), detectedAt,
+																													encoder.getLastChecksum(),
+																													std::move(videoData));
+	if (!queued) {
+		std::cerr << "업로드 대기함 저장 실패 : " << evidence->getId() << std::endl;
+	}
+	setIsDBThreadRunningFalse();
+	return queued;
 }
 
 void DBThread::setIsDBThreadRunningFalse() {
@@ -127,15 +76,15 @@ void DBThread::setIsDBThreadRunningFalse() {
 	}
 }
 
-std::string DBThread::getDetectedAtFromFolder() const {
-	std::string folderName = std::filesystem::path(folderPath).filename().string();
+std::string DBThread::getDetectedAt() const {
+	const std::string& evidenceId = evidence->getId();
 
-	// 폴더 이름 형식: "20250529_124345_300" (년월일_시분초_밀리초)
-	std::cout << "폴더 이름: " << folderName << std::endl;
+	// 졸음 근거 ID 형식: "20250529_124345_300" (년월일_시분초_밀리초)
+	std::cout << "졸음 근거 ID: " << evidenceId << std::endl;
 
 	// 언더스코어로 분리하여 파싱
 	std::vector<std::string> parts;
-	std::stringstream ss(folderName);
+	std::stringstream ss(evidenceId);
 	std::string part;
 
 	while (std::getline(ss, part, '_')) {
@@ -143,7 +92,7 @@ std::string DBThread::getDetectedAtFromFolder() const {
 	}
 
 	if (parts.size() != 3) {
-		std::cerr << "DBThread 폴더 이름 형식이 올바르지 않음: " << folderName << std::endl;
+		std::cerr << "DBThread 졸음 근거 ID 형식이 올바르지 않음: " << evidenceId << std::endl;
 		std::cerr << "예상 형식: 년월일_시분초_밀리초 (예: 20250529_124345_300)" << std::endl;
 		return "";
 	}
@@ -153,12 +102,12 @@ std::string DBThread::getDetectedAtFromFolder() const {
 	std::string millisStr = parts[2];	 // 300
 
 	// 날짜와 시간 파싱
-	std::tm folderTime = {};
+	std::tm detectedTime = {};
 	std::istringstream dateStream(dateStr + timeStr);
-	dateStream >> std::get_time(&folderTime, "%Y%m%d%H%M%S");
+	dateStream >> std::get_time(&detectedTime, "%Y%m%d%H%M%S");
 
 	if (dateStream.fail()) {
-		std::cerr << "DBThread 폴더 이름에서 타임스탬프를 파싱할 수 없음: " << folderName << std::endl;
+		std::cerr << "DBThread 졸음 근거 ID에서 타임스탬프를 파싱할 수 없음: " << evidenceId << std::endl;
 		return "";
 	}
 
@@ -167,7 +116,7 @@ std::string DBThread::getDetectedAtFromFolder() const {
 
 	// 날짜 형식 변환: "2025-05-12 12:06:13.000000"
 	char timeBuffer[30];
-	std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", &folderTime);
+	std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", &detectedTime);
 
 	std::string result = std::string(timeBuffer) + "." + microseconds;
 	std::cout << "변환된 날짜 형식: " << result << std::endl;
@@ -175,114 +124,48 @@ std::string DBThread::getDetectedAtFromFolder() const {
 	return result;
 }
 
-bool DBThread::sendVideoToBackend(const std::vector<uchar>& videoData) {
-	const int MAX_RETRIES = 5;
-	const int RETRY_DELAY_MS = 1000;
-	bool backendResponse = false;
-	int attempt = 0;
-
-	while (!backendResponse && attempt < MAX_RETRIES) {
-		std::cout << "백엔드 서버 통신 " << (attempt + 1) << " 번째 시도" << std::endl;
-
-		const char* hashC = std::getenv("EMBEDDED_HASH");
-		const char* uidC = std::getenv("DEVICE_UID");
-		const char* ipC = std::getenv("SERVER_IP");
-
-		if (!hashC || !uidC || !ipC) {
-			std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
-			return false;
-		}
-
-		std::string hash(hashC);
-		std::string deviceUidEnv(uidC);
-		std::string serverIP(ipC);
-		std::string detectedAt = getDetectedAtFromFolder();
-		if (detectedAt.empty()) {
-			std::cerr << "detectedAt 추출 실패" << std::endl;
-			return false;
-		}
-
-		std::string checksum = calculateSHA256(videoData);
-		if (checksum.empty()) {
-			std::cerr << "체크섬 계산 실패" << std::endl;
-			return false;
-		}
-
-		std::cout << "비디오 데이터 크기: " << videoData.size() << " bytes" << std::endl;
-		std::cout << "체크섬: " << checksum << std::endl;
-		std::cout << "감지 시각: " << detectedAt << std::endl;
-
-		std::string tempVideoPath = generateTempFilePath();
-		std::ofstream outFile(tempVideoPath, std::ios::binary);
-		if (!outFile) {
-			std::cerr << "임시 파일 열기 실패: " << tempVideoPath << std::endl;
-			return false;
-		}
-		outFile.write(reinterpret_cast<const char*>(videoData.data()), videoData.size());
-		outFile.close();
-
-		std::ifstream checkFile(tempVideoPath, std::ios::binary | std::ios::ate);
-		if (!checkFile) {
-			std::cerr << "임시 파일 열기 실패 (검증용): " << tempVideoPath << std::endl;
-			return false;
-		}
-		std::streamsize fileSize = checkFile.tellg();
-		checkFile.close();
-		if (fileSize <= 0) {
-			std::cerr << "임시 파일 사이즈 0, 파일 손상 의심: " << tempVideoPath << std::endl;
-			return false;
-		}
-		std::cout << "임시 파일 정상 생성, 크기: " << fileSize << " bytes" << std::endl;
-
-		cpr::Header headers = {{"Authorization", "Bearer " + hash}};
-		cpr::Multipart multipart{{"deviceUid", deviceUidEnv},
-														 {"detectedAt", detectedAt},
-														 {"videoFile", cpr::File{tempVideoPath, "video.mp4"}},
-														 {"checksum", checksum}};
-
-		cpr::Response r =
-				cpr::Post(cpr::Url{serverIP + "/sleep"}, headers, multipart, cpr::Timeout{10000});
-
-		std::cout << "응답 코드: " << r.status_code << std::endl;
-		std::cout << "응답 메시지: " << r.text << std::endl;
-		std::cout << "에러 메시지: " << r.error.message << std::endl;
-		std::cout << "에러 코드: " << static_cast<int>(r.error.code) << std::endl;
-
-		if (r.status_code == 201 &&
-				r.text.find("졸음 감지 데이터가 저장되었습니다.") != std::string::npos) {
-			backendResponse = true;
-			std::cout << "백엔드 전송 성공!" << std::endl;
-		} else if (r.status_code == 404) {
-			std::cerr << "장치를 찾을 수 없음 (404): " << r.text << std::endl;
-			break;
-		} else if (r.status_code == 401) {
-			std::cerr << "인증 실패 (401): " << r.text << std::endl;
-			break;
-		} else if (r.status_code == 400) {
-			std::cerr << "잘못된 요청 데이터 (400): " << r.text << std::endl;
-			break;
-		} else {
-			std::cerr << "백엔드 응답 실패 (" << r.status_code << "): " << r.error.message
-								<< "\n응답 본문: " << r.text << std::endl;
-		}
-
-		try {
-			std::filesystem::remove(tempVideoPath);
-		} catch (const std::exception& e) {
-			std::cerr << "임시 영상 파일 삭제 실패: " << e.what() << std::endl;
-		}
-
-		if (backendResponse) {
-			return true;
-		}
-
-		if (r.status_code >= 400 && r.status_code < 500) {
-			break;
-		}
-
-		std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_DELAY_MS));
-		attempt++;
+UploadResult DBThread::uploadVideo(const OutboxEntry& entry, const std::vector<uchar>& videoData) {
+	BackendClient& client = BackendClient::getInstance();
+	if (!client.isConfigured(BackendServer::Backend)) {
+		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
+		return UploadResult::RetryLater;
+	}
+
+	std::cout << "백엔드 영상 전송: " << entry.id << " (" << videoData.size()
+						<< " bytes, 감지 시각 " << entry.detectedAt << ", 체크섬 " << entry.checksum << ")"
+						<< std::endl;
+
+	// 영상은 메모리 버퍼에서 바로 multipart 본문으로 전송 (임시 파일 없음)
+	cpr::Multipart multipart{
+			{"deviceUid", client.getDeviceUid()},
+			{"detectedAt", entry.detectedAt},
+			{"videoFile", cpr::Buffer{videoData.begin(), videoData.end(), "video.mp4"}, "video/mp4"},
+			{"checksum", entry.checksum}};
+
+	cpr::Response r = client.post(BackendEndpoints::EvidenceUpload, multipart);
+
+	std::cout << "응답 코드: " << r.status_code << std::endl;
+	std::cout << "응답 메시지: " << r.text << std::endl;
+	std::cout << "에러 메시지: " << r.error.message << std::endl;
+	std::cout << "에러 코드: " << static_cast<int>(r.error.code) << std::endl;
+
+	if (r.status_code == 201 &&
+			r.text.find("졸음 감지 데이터가 저장되었습니다.") != std::string::npos) {
+		std::cout << "백엔드 전송 성공!" << std::endl;
+		return UploadResult::Success;
+	} else if (r.status_code == 400) {
+		// 요청 데이터 자체가 잘못된 경우만 폐기 (다시 보내도 같은 결과)
+		std::cerr << "잘못된 요청 데이터 (400): " << r.text << std::endl;
+		return UploadResult::Rejected;
+	} else if (r.status_code == 404) {
+		std::cerr << "장치를 찾을 수 없음 (404): " << r.text << std::endl;
+	} else if (r.status_code == 401) {
+		std::cerr << "인증 실패 (401): " << r.text << std::endl;
+	} else {
+		std::cerr << "백엔드 응답 실패 (" << r.status_code << "): " << r.error.message
+							<< "\n응답 본문: " << r.text << std::endl;
 	}
 
-	return false;
+	// 장치 등록/인증 문제도 설정이 고쳐지면 전송 가능하므로 영상은 보관
+	return UploadResult::RetryLater;
 }
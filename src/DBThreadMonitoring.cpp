@@ -1,72 +1,261 @@
 #include "../include/DBThreadMonitoring.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "../include/DBThread.h"
 
+namespace {
+const char* priorityName(UploadPriority priority) {
+	switch (priority) {
+		case UploadPriority::Evidence:
+			return "evidence";
+		default:
+			return "telemetry";
+	}
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+	return std::chrono::duration<double, std::milli>(to - from).count();
+}
+}	 // namespace
+
 std::string DBThreadMonitoring::generateThreadKey(const std::string& deviceUid,
-																									const std::string& folderPath) {
-	return deviceUid + "::" + folderPath;
+																									const std::string& evidenceId) {
+	return deviceUid + "::" + evidenceId;
 }
 
-DBThreadMonitoring::DBThreadMonitoring() {
+DBThreadMonitoring::DBThreadMonitoring(const std::string& outboxDirectory)
+		: outbox(outboxDirectory) {
+	// 이전 실행에서 전송하지 못한 근거 영상 복원 (워커 시작 후 바로 전송 시도)
+	if (!outbox.open()) {
+		std::cerr << "업로드 대기함을 열 수 없음: " << outboxDirectory << std::endl;
+	}
 	startDBMonitoring();
 }
 
 DBThreadMonitoring::~DBThreadMonitoring() {
-	terminate = true;
+	shutdown();
+}
+
+void DBThreadMonitoring::startDBMonitoring() {
+	std::lock_guard<std::mutex> lock(queueMutex);
+	if (!workerThreads.empty()) {
+		return;
+	}
+	terminate = false;
+	outboxDrainScheduled = false;
+	outboxStateChanged = false;
+	for (int i = 0; i < WORKER_COUNT; ++i) {
+		workerThreads.emplace_back([this] { workerLoop(); });
+	}
+	outboxThread = std::thread([this] { outboxLoop(); });
+}
+
+void DBThreadMonitoring::shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		if (workerThreads.empty()) {
+			return;
+		}
+		terminate = true;
+	}
 	condition.notify_all();
-	if (monitoringThread.joinable()) {
-		monitoringThread.join();
+	outboxCondition.notify_all();
+
+	if (outboxThread.joinable()) {
+		outboxThread.join();
+	}
+	for (auto& worker : workerThreads) {
+		if (worker.joinable()) {
+			worker.join();
+		}
 	}
+	workerThreads.clear();
+	logStats();
 }
 
-void DBThreadMonitoring::startDBMonitoring() {
-	monitoringThread = std::thread([this] { processThreadQueue(); });
+void DBThreadMonitoring::workerLoop() {
+	std::unique_lock<std::mutex> lock(queueMutex);
+
+	while (true) {
+		condition.wait(lock, [this] { return terminate || !jobQueue.empty(); });
+
+		if (jobQueue.empty()) {
+			return;	 // 종료 요청 + 남은 작업 없음
+		}
+
+		UploadJob job = jobQueue.top();
+		jobQueue.pop();
+		int index = static_cast<int>(job.priority);
+		pendingCounts[index]--;
+
+		// 종료 중에는 근거 영상만 마저 전송 (상태 정보는 의미가 없어짐)
+		if (terminate && job.priority != UploadPriority::Evidence) {
+			metrics[index].dropped++;
+			continue;
+		}
+
+		auto startedAt = std::chrono::steady_clock::now();
+		double waitMs = elapsedMs(job.enqueuedAt, startedAt);
+		lock.unlock();
+
+		try {
+			job.work();
+		} catch (const std::exception& e) {
+			std::cerr << "업로드 작업 예외 (" << job.name << "): " << e.what() << std::endl;
+		}
+
+		double durationMs = elapsedMs(startedAt, std::chrono::steady_clock::now());
+		lock.lock();
+
+		PriorityMetrics& metric = metrics[index];
+		metric.completed++;
+		metric.totalWaitMs += waitMs;
+		metric.maxWaitMs = std::max(metric.maxWaitMs, waitMs);
+		metric.totalDurationMs += durationMs;
+		metric.maxDurationMs = std::max(metric.maxDurationMs, durationMs);
+	}
 }
 
-void DBThreadMonitoring::processThreadQueue() {
+void DBThreadMonitoring::outboxLoop() {
 	std::unique_lock<std::mutex> lock(queueMutex);
+	auto changed = [this] { return terminate || outboxStateChanged; };
 
 	while (!terminate) {
-		condition.wait(lock, [this] { return terminate || !threadQueue.empty(); });
-
-		while (!threadQueue.empty()) {
-			auto thread = threadQueue.front();
-			threadQueue.pop();
-			lock.unlock();
-
-			std::thread([ptr = thread, this] {
-				try {
-					ptr->sendDataToDB();
-				} catch (const std::exception& e) {
-					std::cerr << "DBThread 예외: " << e.what() << std::endl;
-				}
-				removeActiveThread(generateThreadKey(ptr->getDeviceUid(), ptr->getFolderPath()));
-			}).detach();
-			lock.lock();
+		// 상태를 확인하기 전에 알림을 지우므로, 확인 이후의 변경은 아래 대기에서 놓치지 않음
+		outboxStateChanged = false;
+
+		// 대기 영상이 없거나 이미 전송 작업이 예약되어 있으면 새 영상/작업 완료까지 대기
+		std::chrono::steady_clock::time_point nextAttempt;
+		if (outboxDrainScheduled || !outbox.nextAttemptTime(nextAttempt)) {
+			outboxCondition.wait(lock, changed);
+			continue;
+		}
+
+		// 백오프 중이면 다음 시도 시각까지 대기
+		if (std::chrono::steady_clock::now() < nextAttempt) {
+			outboxCondition.wait_until(lock, nextAttempt, changed);
+			continue;
+		}
+
+		outboxDrainScheduled = true;
+		lock.unlock();
+		bool submitted =
+				submitJob(UploadPriority::Evidence, "outbox drain", [this] { drainOutbox(); });
+		lock.lock();
+
+		if (!submitted) {
+			outboxDrainScheduled = false;
+			outboxCondition.wait_for(lock, std::chrono::seconds(1), [this] { return terminate; });
 		}
 	}
 }
 
-void DBThreadMonitoring::addDBThread(std::shared_ptr<DBThread> thread) {
+void DBThreadMonitoring::drainOutbox() {
+	// 대기 중인 영상을 한 작업에서 오래된 순으로 모두 전송 (영상마다 작업을 만들지 않음)
+	for (const auto& entry : outbox.dueEntries()) {
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if (terminate) {
+				break;	// 남은 영상은 디스크에 두고 다음 부팅 때 전송
+			}
+		}
+
+		std::vector<uchar> video;
+		if (!outbox.loadContent(entry, video)) {
+			std::cerr << "업로드 대기 영상을 읽을 수 없음: " << entry.id << std::endl;
+			outbox.markRejected(entry.id);
+			continue;
+		}
+
+		UploadResult result = DBThread::uploadVideo(entry, video);
+		if (result == UploadResult::Success) {
+			outbox.markSent(entry.id);
+		} else if (result == UploadResult::Rejected) {
+			outbox.markRejected(entry.id);
+		} else {
+			// 연결 문제라면 나머지 영상도 실패하므로 백오프 후 다시 시도
+			outbox.markRetry(entry.id);
+			break;
+		}
+	}
+
+	// 전송/폐기 기록이 쌓인 저널을 남은 영상 기준으로 다시 씀
+	outbox.compact();
+
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		outboxDrainScheduled = false;
+		outboxStateChanged = true;
+	}
+	outboxCondition.notify_all();
+}
+
+bool DBThreadMonitoring::enqueueEvidence(const std::string& id, const std::string& detectedAt,
+																				 const std::string& checksum, std::vector<uchar> video) {
+	if (!outbox.enqueue(id, detectedAt, checksum, std::move(video))) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		outboxStateChanged = true;
+	}
+	outboxCondition.notify_all();
+	return true;
+}
+
+bool DBThreadMonitoring::submitJob(UploadPriority priority, const std::string& name,
+																	 std::function<void()> work) {
 	std::unique_lock<std::mutex> lock(queueMutex);
-	std::string threadKey = generateThreadKey(thread->getDeviceUid(), thread->getFolderPath());
+	int index = static_cast<int>(priority);
+
+	if (terminate) {
+		metrics[index].dropped++;
+		return false;
+	}
+	if (pendingCounts[index] >= MAX_PENDING_JOBS[index]) {
+		metrics[index].dropped++;
+		std::cerr << "업로드 대기 작업이 가득 참 (" << priorityName(priority) << "), 작업 버림: " << name
+							<< std::endl;
+		return false;
+	}
 
-	if (activeThreadKeys.find(threadKey) == activeThreadKeys.end()) {
+	jobQueue.push(UploadJob{priority, jobSequence++, std::chrono::steady_clock::now(), name,
+													std::move(work)});
+	pendingCounts[index]++;
+	lock.unlock();
+
+	condition.notify_one();
+	return true;
+}
+
+void DBThreadMonitoring::addDBThread(std::shared_ptr<DBThread> thread) {
+	std::string threadKey = generateThreadKey(thread->getDeviceUid(), thread->getEvidenceId());
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		if (activeThreadKeys.find(threadKey) != activeThreadKeys.end()) {
+			std::cout << "이미 실행 중인 스레드입니다 : " << threadKey << std::endl;
+			return;
+		}
 		activeThreadKeys.insert(threadKey);
-		threadQueue.push(thread);
-		condition.notify_one();
-		std::cout << "DBThread 추가됨, 큐 크기: " << threadQueue.size() << std::endl;
+	}
+
+	bool submitted = submitJob(UploadPriority::Evidence, threadKey, [this, thread, threadKey] {
+		thread->sendDataToDB();
+		removeActiveThread(threadKey);
+	});
+
+	if (submitted) {
+		std::cout << "DBThread 추가됨: " << threadKey << std::endl;
 	} else {
-		std::cout << "이미 실행 중인 스레드입니다 : " << threadKey << std::endl;
+		removeActiveThread(threadKey);
 	}
 }
 
 void DBThreadMonitoring::removeActiveThread(const std::string& key) {
-	std::unique_lock<std::mutex> lock(queueMutex);
+	std::lock_guard<std::mutex> lock(queueMutex);
 	activeThreadKeys.erase(key);
-	condition.notify_all();
 }
 
 bool DBThreadMonitoring::getIsDBThreadRunning() const {
@@ -75,5 +264,32 @@ bool DBThreadMonitoring::getIsDBThreadRunning() const {
 
 void DBThreadMonitoring::setIsDBThreadRunning(bool value) {
 	isDBThreadRunning.store(value, std::memory_order_release);
-	condition.notify_all();
+}
+
+std::vector<UploadPoolStats> DBThreadMonitoring::getStats() const {
+	std::lock_guard<std::mutex> lock(queueMutex);
+	std::vector<UploadPoolStats> stats;
+
+	for (int i = PRIORITY_COUNT - 1; i >= 0; --i) {
+		const PriorityMetrics& metric = metrics[i];
+		double completed = metric.completed > 0 ? static_cast<double>(metric.completed) : 1.0;
+		stats.push_back(UploadPoolStats{static_cast<UploadPriority>(i), pendingCounts[i],
+																		metric.completed, metric.dropped, metric.totalWaitMs / completed,
+																		metric.maxWaitMs, metric.totalDurationMs / completed,
+																		metric.maxDurationMs});
+	}
+	return stats;
+}
+
+void DBThreadMonitoring::logStats() const {
+	std::cout << "[UploadPool] ";
+	for (const auto& stats : getStats()) {
+		std::cout << priorityName(stats.priority) << "(pending " << stats.pending << ", done "
+							<< stats.completed << ", drop " << stats.dropped << ", wait avg/max "
+							<< stats.averageWaitMs << "/" << stats.maxWaitMs << "ms, run avg/max "
+							<< stats.averageDurationMs << "/" << stats.maxDurationMs << "ms) ";
+	}
+	std::cout << "| outbox " << outbox.pendingCount() << " pending (" << outbox.getPendingBytes()
+						<< " bytes), evicted " << outbox.getEvictedCount() << ", coalesced "
+						<< outbox.getCoalescedCount() << std::endl;
 }
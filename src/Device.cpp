@@ -1,9 +1,8 @@
 #include "../include/Device.h"
 
-#include <cpr/cpr.h>
-
 #include <iostream>
 
+#include "../include/BackendClient.h"
 #include "../include/Utils.h"
 
 // DeviceStatusManager 구현
@@ -37,40 +36,28 @@ bool DeviceStatusManager::getDeviceStatus(int deviceIndex) const {
 }
 
 void DeviceStatusManager::sendDeviceStatusToBackend() {
-	const char* hashC = std::getenv("EMBEDDED_HASH");
-	const char* uidC = std::getenv("DEVICE_UID");
-	const char* ipC = std::getenv("SERVER_IP");
-
-	if (!hashC || !uidC || !ipC) {
+	BackendClient& client = BackendClient::getInstance();
+	if (!client.isConfigured(BackendServer::Backend)) {
 		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
 		return;
 	}
 
-	std::string hash(hashC);
-	std::string deviceUid(uidC);
-	std::string serverIP(ipC);
-
-	cpr::Header headers = {{"Content-Type", "application/json; charset=utf-8"},
-												 {"Authorization", "Bearer " + hash}};
-
 	std::string status_1 = deviceStatus[0] ? "true" : "false";
 	std::string status_2 = deviceStatus[1] ? "true" : "false";
 	std::string status_3 = deviceStatus[2] ? "true" : "false";
 
-	nlohmann::json jsonData = {{"deviceUid", deviceUid},
+	nlohmann::json jsonData = {{"deviceUid", client.getDeviceUid()},
 														 {"cameraState", deviceStatus[0]},
 														 {"accelerationSensorState", deviceStatus[1]},
 														 {"speakerState", deviceStatus[2]}};
-	std::string jsonBody = jsonData.dump();
 
 	std::cout << "백엔드로 장치 상태 전송 중..." << std::endl;
 	std::cout << "Camera: " << status_1 << ", AccelSensor: " << status_2 << ", Speaker: " << status_3
 						<< std::endl;
 
 	try {
-		cpr::Response r = cpr::Patch(cpr::Url{serverIP + "/vehicles/status"}, headers,
-																 cpr::Body{jsonBody}, cpr::Timeout{5000}	// 5초 타임아웃
-		);
+		cpr::Response r = client.patch(BackendEndpoints::DeviceStatus, jsonData.dump(),
+																	 "application/json; charset=utf-8");
 
 		if (r.error) {
 			std::cerr << "장치 상태 전송 오류: " << r.error.message << std::endl;
@@ -0,0 +1,233 @@
+#include "../include/DiagnosisClient.h"
+
+#include <algorithm>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "../include/BackendClient.h"
+#include "../include/LatencyMetrics.h"
+
+namespace {
+// 정렬된 표본에서 백분위 값 (nearest-rank)
+double percentile(const std::vector<double>& sorted, double ratio) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	size_t index = static_cast<size_t>(ratio * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+}	 // namespace
+
+DiagnosisClient::DiagnosisClient(std::chrono::milliseconds deadline)
+		: deadline(deadline),
+			terminate(false),
+			hasRequest(false),
+			inFlight(false),
+			resultDelivered(false),
+			requestedCount(0),
+			skippedCount(0),
+			failedCount(0),
+			deadlineMissedCount(0),
+			lateCount(0),
+			latencyNext(0) {
+	latencySamples.reserve(LATENCY_SAMPLE_COUNT);
+}
+
+DiagnosisClient::~DiagnosisClient() {
+	shutdown();
+}
+
+bool DiagnosisClient::initialize() {
+	BackendClient& client = BackendClient::getInstance();
+	if (!client.isConfigured(BackendServer::AiServer)) {
+		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
+		return false;
+	}
+
+	// 쿼리 문자열은 바뀌지 않으므로 한 번만 구성
+	auto encodedSecure = cpr::util::urlEncode(client.getDeviceUid());
+	query = "deviceUid=" + std::string(encodedSecure.begin(), encodedSecure.end());
+
+	std::lock_guard<std::mutex> lock(clientMutex);
+	if (!requestThread.joinable()) {
+		terminate = false;
+		requestThread = std::thread([this] { requestLoop(); });
+	}
+	return true;
+}
+
+void DiagnosisClient::shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(clientMutex);
+		terminate = true;
+	}
+	requestCondition.notify_all();
+
+	// 진행 중인 요청은 HTTP 타임아웃 안에 끝남
+	if (requestThread.joinable()) {
+		requestThread.join();
+	}
+}
+
+bool DiagnosisClient::request(const std::string& timestamp, int64_t requestedAtMs) {
+	PendingRequest next{timestamp, requestedAtMs, std::chrono::steady_clock::now()};
+	std::lock_guard<std::mutex> lock(clientMutex);
+
+	if (!requestThread.joinable() || terminate) {
+		completed.push_back(makeFailure(next, "환경 변수 설정 오류"));
+		return false;
+	}
+
+	if (inFlight) {
+		skippedCount++;
+		// 이전 요청이 이미 로컬 판별로 넘어갔다면 이번 주기도 기다리지 않고 로컬 판별
+		if (resultDelivered) {
+			completed.push_back(makeFailure(next, "이전 진단 요청 응답 대기 중"));
+		}
+		return false;
+	}
+
+	std::cout << "AI Server 진단 요청 시각 : " << timestamp << std::endl;
+	current = std::move(next);
+	hasRequest = true;
+	inFlight = true;
+	resultDelivered = false;
+	requestedCount++;
+	requestCondition.notify_one();
+	return true;
+}
+
+bool DiagnosisClient::poll(DiagnosisResult& result) {
+	std::lock_guard<std::mutex> lock(clientMutex);
+
+	if (!completed.empty()) {
+		result = std::move(completed.front());
+		completed.pop_front();
+		return true;
+	}
+
+	// 기한이 지나면 응답을 기다리지 않고 실패로 전달 (늦게 온 응답은 통계에만 반영)
+	if (inFlight && !resultDelivered && std::chrono::steady_clock::now() - current.sentAt >= deadline) {
+		deadlineMissedCount++;
+		resultDelivered = true;
+		result = makeFailure(current, "응답 기한(" + std::to_string(deadline.count()) + "ms) 초과");
+		return true;
+	}
+	return false;
+}
+
+void DiagnosisClient::requestLoop() {
+	std::unique_lock<std::mutex> lock(clientMutex);
+
+	while (true) {
+		requestCondition.wait(lock, [this] { return terminate || hasRequest; });
+		if (terminate) {
+			return;
+		}
+
+		PendingRequest request = current;
+		hasRequest = false;
+		lock.unlock();
+
+		DiagnosisResult result = performRequest(request);
+		double latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+																																	 request.sentAt)
+													 .count();
+		LatencyMetrics::getInstance().record(LatencyStage::Diagnosis,
+																				 static_cast<int64_t>(latencyMs * 1000.0));
+
+		lock.lock();
+		if (latencySamples.size() < LATENCY_SAMPLE_COUNT) {
+			latencySamples.push_back(latencyMs);
+		} else {
+			latencySamples[latencyNext] = latencyMs;
+		}
+		latencyNext = (latencyNext + 1) % LATENCY_SAMPLE_COUNT;
+		if (!result.success) {
+			failedCount++;
+		}
+
+		if (resultDelivered) {
+			lateCount++;
+		} else {
+			completed.push_back(std::move(result));
+			resultDelivered = true;
+		}
+		inFlight = false;
+	}
+}
+
+DiagnosisResult DiagnosisClient::performRequest(const PendingRequest& request) {
+	cpr::Response r = BackendClient::getInstance().get(BackendEndpoints::Diagnosis, query);
+
+	if (r.error) {
+		std::cerr << "통신 오류: " << r.error.message << std::endl;
+		return makeFailure(request, "통신 오류: " + r.error.message);
+	}
+
+	if (r.status_code != 200) {
+		std::cerr << "서버 응답 실패 - 상태 코드: " << r.status_code << "\n본문: " << r.text
+							<< std::endl;
+		return makeFailure(request, "HTTP 오류: " + std::to_string(r.status_code));
+	}
+
+	try {
+		nlohmann::json jsonResp = nlohmann::json::parse(r.text);
+
+		if (jsonResp.contains("success") && jsonResp["success"] == true) {
+			DiagnosisResult result;
+			result.timestamp = request.timestamp;
+			result.requestedAtMs = request.requestedAtMs;
+			result.success = true;
+			result.isDrowsy = jsonResp["isDrowsinessDrive"];
+			std::string detectionTime = jsonResp["detectionTime"];
+			result.message = "AI 진단 성공, 감지 시각: " + detectionTime;
+			return result;
+		}
+
+		const auto& err = jsonResp["error"];
+		std::cerr << "AI 서버 오류 - 메시지: " << err["message"] << std::endl;
+		return makeFailure(request, "AI 서버 오류: " + std::string(err["message"]));
+	} catch (const std::exception& e) {
+		std::cerr << "JSON 파싱 오류: " << e.what() << std::endl;
+		return makeFailure(request, "JSON 파싱 오류: " + std::string(e.what()));
+	}
+}
+
+DiagnosisResult DiagnosisClient::makeFailure(const PendingRequest& request,
+																						 const std::string& message) {
+	DiagnosisResult result;
+	result.timestamp = request.timestamp;
+	result.requestedAtMs = request.requestedAtMs;
+	result.message = message;
+	return result;
+}
+
+DiagnosisStats DiagnosisClient::getStats() const {
+	std::vector<double> sorted;
+	DiagnosisStats stats{};
+	{
+		std::lock_guard<std::mutex> lock(clientMutex);
+		sorted = latencySamples;
+		stats.requested = requestedCount;
+		stats.skipped = skippedCount;
+		stats.failed = failedCount;
+		stats.deadlineMissed = deadlineMissedCount;
+		stats.late = lateCount;
+	}
+
+	std::sort(sorted.begin(), sorted.end());
+	stats.p50Ms = percentile(sorted, 0.50);
+	stats.p90Ms = percentile(sorted, 0.90);
+	stats.p99Ms = percentile(sorted, 0.99);
+	stats.maxMs = sorted.empty() ? 0.0 : sorted.back();
+	return stats;
+}
+
+void DiagnosisClient::logStats() const {
+	DiagnosisStats stats = getStats();
+	std::cout << "[Diagnosis] requested " << stats.requested << ", skipped " << stats.skipped
+						<< ", failed " << stats.failed << ", deadline-miss " << stats.deadlineMissed << ", late "
+						<< stats.late << " | latency p50/p90/p99/max " << stats.p50Ms << "/" << stats.p90Ms
+						<< "/" << stats.p99Ms << "/" << stats.maxMs << "ms" << std::endl;
+}
@@ -0,0 +1,328 @@
+#include "../include/EarCalibrator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace {
+float median(std::vector<float> values) {
+	std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+	return values[values.size() / 2];
+}
+
+float meanOf(std::vector<float>::const_iterator begin, std::vector<float>::const_iterator end) {
+	double sum = 0.0;
+	for (auto it = begin; it != end; ++it) {
+		sum += *it;
+	}
+	return static_cast<float>(sum / (end - begin));
+}
+}	 // namespace
+
+EarCalibrator::EarCalibrator(const std::string& driverId, const std::string& profileDirectory,
+														 int64_t calibrationMs, size_t minCalibrationSamples)
+		: profilePath(profileDirectory + "/" + driverId + ".json"),
+			calibrationMs(calibrationMs),
+			minCalibrationSamples(std::max<size_t>(2, minCalibrationSamples)),
+			calibrated(false),
+			calibrationStartMs(-1) {
+	profile.driverId = driverId;
+	profile.threshold = DEFAULT_THRESHOLD;
+	calibrationSamples.reserve(MAX_CALIBRATION_SAMPLES);
+}
+
+std::unique_ptr<EarCalibrator> EarCalibrator::fromEnvironment() {
+	const char* driverC = std::getenv("DRIVER_ID");
+	const char* directoryC = std::getenv("EAR_PROFILE_DIR");
+	std::string driverId = driverC && std::string(driverC) != "" ? driverC : "default";
+	std::string directory = directoryC && std::string(directoryC) != "" ? directoryC
+																																		 : "./frames/calibration";
+
+	auto calibrator = std::make_unique<EarCalibrator>(driverId, directory);
+	if (calibrator->load()) {
+		EarProfile loaded = calibrator->getProfile();
+		std::cout << "운전자 EAR 프로필 복원: " << driverId << " (임계값 " << loaded.threshold
+							<< ", 뜬 눈 " << loaded.openEar << ", 감은 눈 " << loaded.closedEar << ")"
+							<< std::endl;
+	} else {
+		std::cout << "운전자 EAR 프로필 없음, 주행 초반 보정 후 임계값 적용: " << driverId << std::endl;
+	}
+	return calibrator;
+}
+
+bool EarCalibrator::load() {
+	std::ifstream file(profilePath);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	try {
+		nlohmann::json json = nlohmann::json::parse(file);
+		EarProfile loaded;
+		loaded.driverId = profile.driverId;
+		loaded.openEar = json.at("openEar").get<float>();
+		loaded.closedEar = json.at("closedEar").get<float>();
+		loaded.samples = json.value("samples", uint64_t(0));
+		// 적응 한계 기준이 없는 이전 프로필은 저장된 중심을 기준으로 사용
+		loaded.baselineOpenEar = json.value("baselineOpenEar", loaded.openEar);
+		loaded.baselineClosedEar = json.value("baselineClosedEar", loaded.closedEar);
+		if (loaded.openEar - loaded.closedEar < MIN_SEPARATION) {
+			std::cerr << "EAR 프로필 값이 올바르지 않음: " << profilePath << std::endl;
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(calibratorMutex);
+		profile = loaded;
+		calibrated = true;
+		calibrationSamples.clear();
+		window = AdaptWindow();
+		tripOpenMeans.clear();
+		tripClosedMeans.clear();
+		updateThreshold();
+		return true;
+	} catch (const std::exception& e) {
+		std::cerr << "EAR 프로필 읽기 오류: " << profilePath << " - " << e.what() << std::endl;
+		return false;
+	}
+}
+
+bool EarCalibrator::save() const {
+	EarProfile current;
+	{
+		std::lock_guard<std::mutex> lock(calibratorMutex);
+		if (!calibrated) {
+			return false;
+		}
+		current = profile;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(profilePath).parent_path(), error);
+
+	// 저장 중 전원이 꺼져도 이전 프로필이 남도록 임시 파일에 쓴 뒤 교체
+	std::string tempPath = profilePath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::trunc);
+		if (!file.is_open()) {
+			std::cerr << "EAR 프로필 저장 실패: " << tempPath << std::endl;
+			return false;
+		}
+		nlohmann::json json = {{"driverId", current.driverId},
+													 {"openEar", current.openEar},
+													 {"closedEar", current.closedEar},
+													 {"threshold", current.threshold},
+													 {"samples", current.samples},
+													 {"baselineOpenEar", current.baselineOpenEar},
+													 {"baselineClosedEar", current.baselineClosedEar}};
+		file << json.dump(2);
+		if (!file.good()) {
+			std::cerr << "EAR 프로필 저장 실패: " << tempPath << std::endl;
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, profilePath, error);
+	if (error) {
+		std::cerr << "EAR 프로필 저장 실패: " << profilePath << " - " << error.message() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool EarCalibrator::fitTwoMeans(std::vector<float> samples, float& closedEar, float& openEar) {
+	if (samples.size() < 2) {
+		return false;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	// 대부분 눈을 뜨고 있으므로 하위 10% 를 감은 눈, 중앙값을 뜬 눈 초기 중심으로 사용
+	float closed = samples[samples.size() / 10];
+	float open = samples[samples.size() / 2];
+	for (int iteration = 0; iteration < 20; ++iteration) {
+		// 정렬되어 있으므로 두 중심의 중간값을 기준으로 나뉨
+		float split = (closed + open) / 2.0f;
+		auto boundary = std::upper_bound(samples.begin(), samples.end(), split);
+		if (boundary == samples.begin() || boundary == samples.end()) {
+			return false;
+		}
+
+		double closedSum = 0.0;
+		double openSum = 0.0;
+		for (auto it = samples.begin(); it != boundary; ++it) {
+			closedSum += *it;
+		}
+		for (auto it = boundary; it != samples.end(); ++it) {
+			openSum += *it;
+		}
+		float nextClosed = static_cast<float>(closedSum / (boundary - samples.begin()));
+		float nextOpen = static_cast<float>(openSum / (samples.end() - boundary));
+		if (nextClosed == closed && nextOpen == open) {
+			break;
+		}
+		closed = nextClosed;
+		open = nextOpen;
+	}
+
+	if (open - closed < MIN_SEPARATION) {
+		return false;
+	}
+	closedEar = closed;
+	openEar = open;
+	return true;
+}
+
+void EarCalibrator::updateThreshold() {
+	if (!calibrated || profile.openEar - profile.closedEar < MIN_SEPARATION) {
+		return;	// 두 분포가 가까워지면 마지막으로 구분되던 임계값 유지
+	}
+	float threshold = profile.closedEar + (profile.openEar - profile.closedEar) / 2.0f;
+	profile.threshold = std::clamp(threshold, MIN_THRESHOLD, MAX_THRESHOLD);
+}
+
+void EarCalibrator::closeWindow() {
+	// 졸음 신호가 있었거나 관측 시간이 짧은 구간은 버림
+	if (!window.frozen && window.openCount > 0 && window.openMs >= MIN_WINDOW_OPEN_MS &&
+			tripOpenMeans.size() < MAX_TRIP_WINDOWS) {
+		tripOpenMeans.push_back(static_cast<float>(window.openSum / window.openCount));
+		if (window.closedCount > 0 && window.closedMs >= MIN_WINDOW_CLOSED_MS) {
+			tripClosedMeans.push_back(static_cast<float>(window.closedSum / window.closedCount));
+		}
+	}
+	window = AdaptWindow();
+}
+
+bool EarCalibrator::adaptCenter(std::vector<float>& means, float& center, float baseline) {
+	if (means.size() < MIN_TRIP_WINDOWS) {
+		return false;
+	}
+	// 주행 중 한 방향으로 흘러간 EAR 은 피로 신호일 수 있으므로 운전자 특성으로 학습하지 않음
+	size_t third = means.size() / 3;
+	float trend = meanOf(means.end() - third, means.end()) - meanOf(means.begin(), means.begin() + third);
+	if (std::abs(trend) > MAX_TRIP_TREND) {
+		return false;
+	}
+	center += TRIP_ADAPT_RATE * (median(means) - center);
+	center = std::clamp(center, baseline - MAX_DRIFT, baseline + MAX_DRIFT);
+	return true;
+}
+
+void EarCalibrator::addSample(int64_t timestampMs, float ear, bool faceFound, bool drowsySignal) {
+	if (!faceFound || ear < 0.0f) {
+		return;
+	}
+
+	bool shouldSave = false;
+	{
+		std::lock_guard<std::mutex> lock(calibratorMutex);
+		profile.samples++;
+
+		if (!calibrated) {
+			if (drowsySignal) {
+				return;	 // 졸음 중 EAR 은 보정 표본에서 제외
+			}
+			if (calibrationStartMs < 0) {
+				calibrationStartMs = timestampMs;
+			}
+			if (calibrationSamples.size() < MAX_CALIBRATION_SAMPLES) {
+				calibrationSamples.push_back(ear);
+			}
+			if (timestampMs - calibrationStartMs < calibrationMs ||
+					calibrationSamples.size() < minCalibrationSamples) {
+				return;
+			}
+
+			float closedEar = 0.0f;
+			float openEar = 0.0f;
+			if (fitTwoMeans(calibrationSamples, closedEar, openEar)) {
+				profile.closedEar = closedEar;
+				profile.openEar = openEar;
+				profile.baselineClosedEar = closedEar;
+				profile.baselineOpenEar = openEar;
+				calibrated = true;
+				updateThreshold();
+				shouldSave = true;
+				std::cout << "EAR 보정 완료: 임계값 " << profile.threshold << " (뜬 눈 " << openEar
+									<< ", 감은 눈 " << closedEar << ", 표본 " << calibrationSamples.size() << ")"
+									<< std::endl;
+			} else {
+				std::cerr << "EAR 분포가 구분되지 않아 보정 다시 시작 (기본 임계값 유지)" << std::endl;
+			}
+			calibrationSamples.clear();
+			calibrationStartMs = -1;
+		} else {
+			// 주행 중에는 임계값을 바꾸지 않고 1분 구간 평균만 누적
+			if (window.startMs >= 0 && timestampMs - window.startMs >= ADAPT_WINDOW_MS) {
+				closeWindow();
+			}
+			if (window.startMs < 0) {
+				window.startMs = timestampMs;
+			}
+			window.frozen = window.frozen || drowsySignal;
+			// 표본은 직전 표본 이후 시간을 대표 (fps 가 낮은 처리 모드에서도 같은 기준으로 구간을 채움)
+			int64_t spanMs = window.lastSampleMs < 0
+													 ? 0
+													 : std::clamp<int64_t>(timestampMs - window.lastSampleMs, 0,
+																								MAX_SAMPLE_SPAN_MS);
+			window.lastSampleMs = timestampMs;
+			if (std::abs(ear - profile.closedEar) < std::abs(ear - profile.openEar)) {
+				window.closedSum += ear;
+				window.closedCount++;
+				window.closedMs += spanMs;
+			} else {
+				window.openSum += ear;
+				window.openCount++;
+				window.openMs += spanMs;
+			}
+		}
+	}
+
+	if (shouldSave) {
+		save();
+	}
+}
+
+bool EarCalibrator::endTrip() {
+	{
+		std::lock_guard<std::mutex> lock(calibratorMutex);
+		if (!calibrated) {
+			return false;
+		}
+		closeWindow();
+
+		float openEar = profile.openEar;
+		float closedEar = profile.closedEar;
+		bool openAdapted = adaptCenter(tripOpenMeans, profile.openEar, profile.baselineOpenEar);
+		bool closedAdapted = adaptCenter(tripClosedMeans, profile.closedEar, profile.baselineClosedEar);
+		if (profile.openEar - profile.closedEar < MIN_SEPARATION) {
+			// 두 중심이 가까워지면 이번 주행은 반영하지 않음
+			profile.openEar = openEar;
+			profile.closedEar = closedEar;
+		} else if (openAdapted || closedAdapted) {
+			updateThreshold();
+			std::cout << "EAR 주행 적응: 임계값 " << profile.threshold << " (뜬 눈 " << profile.openEar
+								<< ", 감은 눈 " << profile.closedEar << ", 구간 " << tripOpenMeans.size() << ")"
+								<< std::endl;
+		}
+		tripOpenMeans.clear();
+		tripClosedMeans.clear();
+	}
+	return save();
+}
+
+float EarCalibrator::getThreshold() const {
+	std::lock_guard<std::mutex> lock(calibratorMutex);
+	return profile.threshold;
+}
+
+bool EarCalibrator::isCalibrated() const {
+	std::lock_guard<std::mutex> lock(calibratorMutex);
+	return calibrated;
+}
+
+EarProfile EarCalibrator::getProfile() const {
+	std::lock_guard<std::mutex> lock(calibratorMutex);
+	return profile;
+}
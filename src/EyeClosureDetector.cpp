@@ -0,0 +1,331 @@
+#include "../include/EyeClosureDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// NumPy C API는 FirmwareManager.cpp 에서 초기화됨
+#define NO_IMPORT_ARRAY
+#define PY_ARRAY_UNIQUE_SYMBOL NOSLEEP_ARRAY_API
+#define NPY_NO_DEPRECATED_API	 NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+namespace {
+// Python 경로(imutils.resize(frame, width=400))와 동일한 기본 검출 해상도
+const int DETECTION_WIDTH = 400;
+const int MIN_DETECTION_WIDTH = 240;	// 이보다 작으면 운전석 거리의 얼굴 검출률이 떨어짐
+
+// 68 랜드마크 기준 눈 인덱스 (imutils face_utils.FACIAL_LANDMARKS_IDXS)
+const int RIGHT_EYE_START = 36;
+const int LEFT_EYE_START = 42;
+
+// 68 랜드마크 모델의 점 개수
+const int LANDMARK_COUNT = 68;
+
+float distance(const cv::Point2f& a, const cv::Point2f& b) {
+	return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+#ifdef USE_DLIB
+// 입력을 그레이스케일로 맞춘 뒤 scale 배로 축소
+cv::Mat toScaledGray(const cv::Mat& image, double scale) {
+	cv::Mat gray;
+	if (image.channels() == 1) {
+		gray = image;
+	} else {
+		cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+	}
+
+	cv::Size size(std::max(1, static_cast<int>(gray.cols * scale)),
+								std::max(1, static_cast<int>(gray.rows * scale)));
+	cv::Mat small;
+	cv::resize(gray, small, size, 0, 0, cv::INTER_AREA);
+	return small;
+}
+#endif
+}	 // namespace
+
+float calculateEar(const std::array<cv::Point2f, 6>& eye) {
+	float a = distance(eye[1], eye[5]);
+	float b = distance(eye[2], eye[4]);
+	float c = distance(eye[0], eye[3]);
+	if (c <= 0.0f) {
+		return -1.0f;
+	}
+	return (a + b) / (2.0f * c);
+}
+
+// NativeEyeClosureDetector implementation
+NativeEyeClosureDetector::NativeEyeClosureDetector(const std::string& modelPath)
+		: predictorPath(modelPath), initialized(false), detectionWidth(DETECTION_WIDTH) {}
+
+NativeEyeClosureDetector::~NativeEyeClosureDetector() {}
+
+bool NativeEyeClosureDetector::initialize() {
+#ifdef USE_DLIB
+	try {
+		faceDetector = dlib::get_frontal_face_detector();
+		dlib::deserialize(predictorPath) >> shapePredictor;
+	} catch (const std::exception& e) {
+		std::cerr << "[ERROR] 랜드마크 모델 로드 실패 (" << predictorPath << "): " << e.what()
+							<< std::endl;
+		return false;
+	}
+	initialized = true;
+	return true;
+#else
+	std::cerr << "dlib 없이 빌드되어 네이티브 눈 감음 판별 엔진을 사용할 수 없음" << std::endl;
+	return false;
+#endif
+}
+
+void NativeEyeClosureDetector::setDetectionWidth(int width) {
+	detectionWidth = std::clamp(width, MIN_DETECTION_WIDTH, DETECTION_WIDTH);
+}
+
+#ifdef USE_DLIB
+EyeClosureResult NativeEyeClosureDetector::analyzeFace(const dlib::cv_image<unsigned char>& image,
+																											const dlib::rectangle& face, double scale,
+																											const cv::Point& offset, float threshold) {
+	EyeClosureResult result;
+
+	// 랜드마크 검출
+	dlib::full_object_detection shape = shapePredictor(image, face);
+	if (shape.num_parts() != LANDMARK_COUNT) {
+		return result;
+	}
+	result.faceFound = true;
+
+	// 좌/우 눈 EAR 계산 후 평균 (EAR 은 비율이므로 축소 좌표 그대로 사용)
+	std::array<cv::Point2f, 6> rightEye;
+	std::array<cv::Point2f, 6> leftEye;
+	for (int i = 0; i < 6; ++i) {
+		const dlib::point& r = shape.part(RIGHT_EYE_START + i);
+		const dlib::point& l = shape.part(LEFT_EYE_START + i);
+		rightEye[i] = cv::Point2f(static_cast<float>(r.x()), static_cast<float>(r.y()));
+		leftEye[i] = cv::Point2f(static_cast<float>(l.x()), static_cast<float>(l.y()));
+	}
+
+	float rightEar = calculateEar(rightEye);
+	float leftEar = calculateEar(leftEye);
+	if (rightEar >= 0.0f && leftEar >= 0.0f) {
+		result.ear = (leftEar + rightEar) / 2.0f;
+		result.eyesClosed = result.ear < threshold;
+		result.confidence = std::min(1.0f, std::fabs(result.ear - threshold) / threshold);
+	}
+
+	// 얼굴 위치와 랜드마크를 원본 프레임 좌표로 변환 (ROI 추적용)
+	result.landmarks.reserve(LANDMARK_COUNT);
+	for (int i = 0; i < LANDMARK_COUNT; ++i) {
+		const dlib::point& p = shape.part(i);
+		result.landmarks.emplace_back(static_cast<float>(offset.x + p.x() / scale),
+																	static_cast<float>(offset.y + p.y() / scale));
+	}
+	result.faceRect = cv::Rect(cv::Point(offset.x + static_cast<int>(face.left() / scale),
+																			 offset.y + static_cast<int>(face.top() / scale)),
+														 cv::Point(offset.x + static_cast<int>(face.right() / scale),
+																			 offset.y + static_cast<int>(face.bottom() / scale)));
+
+	return result;
+}
+#endif
+
+EyeClosureResult NativeEyeClosureDetector::detect(const cv::Mat& frame, float threshold) {
+	if (frame.empty()) {
+		return EyeClosureResult();
+	}
+	return detectInRoi(frame, cv::Rect(0, 0, frame.cols, frame.rows), frame.cols, cv::Rect(),
+										 threshold);
+}
+
+EyeClosureResult NativeEyeClosureDetector::detectInRoi(const cv::Mat& roiImage, const cv::Rect& roi,
+																											 int frameWidth, const cv::Rect& faceHint,
+																											 float threshold) {
+	EyeClosureResult result;
+	if (!initialized || roiImage.empty() || frameWidth <= 0) {
+		return result;
+	}
+
+#ifdef USE_DLIB
+	try {
+		// 1. 원본 프레임을 폭 400(처리 모드에 따라 더 작게)으로 줄이는 것과 같은 비율로 ROI 축소 (얼굴 크기 유지)
+		double scale = static_cast<double>(detectionWidth) / frameWidth;
+		cv::Mat small = toScaledGray(roiImage, scale);
+		dlib::cv_image<unsigned char> dlibImage(small);
+
+		// 2. 추적 중이면 예측된 얼굴 위치 사용, 아니면 얼굴 검출 (업샘플링 없음)
+		dlib::rectangle face;
+		if (!faceHint.empty()) {
+			cv::Rect local = faceHint - roi.tl();
+			face = dlib::rectangle(static_cast<long>(local.x * scale), static_cast<long>(local.y * scale),
+														 static_cast<long>(local.br().x * scale),
+														 static_cast<long>(local.br().y * scale));
+		} else {
+			std::vector<dlib::rectangle> faces = faceDetector(dlibImage, 0);
+			if (faces.empty()) {
+				return result;
+			}
+			face = faces[0];
+		}
+
+		// 3. 랜드마크 검출 및 EAR 계산
+		result = analyzeFace(dlibImage, face, scale, roi.tl(), threshold);
+	} catch (const std::exception& e) {
+		std::cerr << "[ERROR] 네이티브 눈 감음 판별 중 오류: " << e.what() << std::endl;
+	}
+#else
+	(void)roi;
+	(void)faceHint;
+	(void)threshold;
+#endif
+
+	return result;
+}
+
+// PythonEyeClosureDetector implementation
+PythonEyeClosureDetector::PythonEyeClosureDetector() {}
+
+PythonEyeClosureDetector::~PythonEyeClosureDetector() {}
+
+bool PythonEyeClosureDetector::initialize() {
+	PyGilGuard gil;
+	bool result = false;
+
+	PyCallable initializeFunc;
+	if (!initializeFunc.resolve("eye_detection_lib", "initialize", 0)) {
+		std::cerr << "Failed to import eye_detection_lib module" << std::endl;
+	} else {
+		// 초기화 함수 호출
+		PyObject* pValue = initializeFunc.call();
+		if (pValue != nullptr) {
+			result = PyObject_IsTrue(pValue);
+			Py_DECREF(pValue);
+		}
+	}
+	initializeFunc.reset();
+
+	// 판별 함수 핸들은 한 번만 조회해 재사용
+	if (result && !measureEar.resolve("eye_detection_lib", "measure_ear", 1)) {
+		result = false;
+	}
+
+	if (result) {
+		std::cout << "Python eye detection initialized successfully" << std::endl;
+	} else {
+		std::cerr << "Python eye detection initialization failed" << std::endl;
+	}
+	return result;
+}
+
+EyeClosureResult PythonEyeClosureDetector::detectLocked(const cv::Mat& frame, float threshold) {
+	EyeClosureResult result;
+	if (frame.empty() || !measureEar.isResolved()) {
+		return result;
+	}
+
+	// cv::Mat 을 복사 없이 NumPy 배열로 감쌈 (ROI 처럼 행 간격이 있어도 그대로 전달)
+	PyObject* pArray = wrapMatAsNumpy(frame);
+	if (pArray == nullptr) {
+		std::cerr << "Failed to create NumPy array" << std::endl;
+		return result;
+	}
+	measureEar.setArg(0, pArray);
+
+	PyObject* pValue = measureEar.call();
+	// 프레임 버퍼를 가리키는 배열은 호출 후 바로 놓음
+	measureEar.clearArg(0);
+
+	if (pValue != nullptr) {
+		// 얼굴이 없으면 -1, 있으면 두 눈 EAR 평균 (임계값 비교는 네이티브 엔진과 같은 방식)
+		double ear = PyFloat_AsDouble(pValue);
+		Py_DECREF(pValue);
+		if (PyErr_Occurred()) {
+			PyErr_Print();
+		} else if (ear >= 0.0) {
+			result.faceFound = true;
+			result.ear = static_cast<float>(ear);
+			result.eyesClosed = result.ear < threshold;
+			result.confidence = std::min(1.0f, std::fabs(result.ear - threshold) / threshold);
+		}
+	}
+	return result;
+}
+
+EyeClosureResult PythonEyeClosureDetector::detect(const cv::Mat& frame, float threshold) {
+	PyGilGuard gil;
+	return detectLocked(frame, threshold);
+}
+
+void PythonEyeClosureDetector::detectBatch(const std::vector<cv::Mat>& frames, float threshold,
+																					 std::vector<EyeClosureResult>& results) {
+	results.clear();
+	results.reserve(frames.size());
+
+	PyGilGuard gil;
+	for (const auto& frame : frames) {
+		results.push_back(detectLocked(frame, threshold));
+	}
+}
+
+// EyeClosureDetector implementation
+EyeClosureDetector::EyeClosureDetector(bool useNative) : useNative(useNative) {
+	if (useNative) {
+		const char* modelPathC = std::getenv("SHAPE_PREDICTOR_PATH");
+		if (modelPathC) {
+			detector = std::make_unique<NativeEyeClosureDetector>(modelPathC);
+		} else {
+			detector = std::make_unique<NativeEyeClosureDetector>();
+		}
+	} else {
+		detector = std::make_unique<PythonEyeClosureDetector>();
+	}
+}
+
+EyeClosureDetector::~EyeClosureDetector() {}
+
+bool EyeClosureDetector::initialize() {
+	std::cout << "눈 감음 판별 엔진 초기화 중 (" << detector->getName() << ")..." << std::endl;
+
+	if (detector->initialize()) {
+		std::cout << "눈 감음 판별 엔진: " << detector->getName() << std::endl;
+		return true;
+	}
+
+	if (!useNative) {
+		return false;
+	}
+
+	// 네이티브 엔진 사용 불가 시 Python 경로로 대체
+	std::cerr << "네이티브 엔진 초기화 실패, Python 경로로 대체합니다." << std::endl;
+	detector = std::make_unique<PythonEyeClosureDetector>();
+	useNative = false;
+	return detector->initialize();
+}
+
+EyeClosureResult EyeClosureDetector::detect(const cv::Mat& frame, float threshold) {
+	return detector->detect(frame, threshold);
+}
+
+EyeClosureResult EyeClosureDetector::detectInRoi(const cv::Mat& roiImage, const cv::Rect& roi,
+																								 int frameWidth, const cv::Rect& faceHint,
+																								 float threshold) {
+	return detector->detectInRoi(roiImage, roi, frameWidth, faceHint, threshold);
+}
+
+void EyeClosureDetector::detectBatch(const std::vector<cv::Mat>& frames, float threshold,
+																		 std::vector<EyeClosureResult>& results) {
+	detector->detectBatch(frames, threshold, results);
+}
+
+void EyeClosureDetector::setDetectionWidth(int width) {
+	detector->setDetectionWidth(width);
+}
+
+bool EyeClosureDetector::supportsRoiTracking() const {
+	return detector->supportsRoiTracking();
+}
+
+std::string EyeClosureDetector::getBackendName() const {
+	return detector->getName();
+}
@@ -1,53 +1,179 @@
 #include "../include/EyeClosureQueueManagement.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
-EyeClosureQueueManagement::EyeClosureQueueManagement() {
-	// 덱 초기화
-	eyeClosureDeque.clear();
-}
+EyeClosureQueueManagement::EyeClosureQueueManagement(const SleepinessWindowConfig& config)
+		: config(config),
+			capacity(std::max<size_t>(2, config.historyCapacity)),
+			timestamps(capacity, 0),
+			ears(capacity, -1.0f),
+			confidences(capacity, 0.0f),
+			durations(capacity, 0),
+			flags(capacity, 0),
+			head(0),
+			closedRunMs(0),
+			perclosWindow{config.perclosWindowMs, 0, 0, 0, 0, 0.0, 0},
+			blinkWindow{config.blinkWindowMs, 0, 0, 0, 0, 0.0, 0} {}
+
+EyeClosureQueueManagement::~EyeClosureQueueManagement() {}
 
-EyeClosureQueueManagement::~EyeClosureQueueManagement() {
-	// 덱 비우기
-	eyeClosureDeque.clear();
+void EyeClosureQueueManagement::addToWindow(Window& window, size_t index) {
+	window.spanMs += durations[index];
+	if (flags[index] & FLAG_CLOSED) {
+		window.closedMs += durations[index];
+	}
+	if (flags[index] & FLAG_BLINK_END) {
+		window.blinks++;
+	}
+	if ((flags[index] & FLAG_FACE_FOUND) && ears[index] >= 0.0f) {
+		window.earSum += ears[index];
+		window.earCount++;
+	}
 }
 
-std::deque<bool> EyeClosureQueueManagement::getEyeClosureHistory() {
-	return eyeClosureDeque;
+void EyeClosureQueueManagement::evictFromWindow(Window& window, int64_t latestMs) {
+	// 구간을 벗어났거나 링에서 곧 덮어쓸 프레임을 뺌
+	while (window.start < head &&
+				 (timestamps[window.start % capacity] <= latestMs - window.durationMs ||
+					head - window.start >= capacity)) {
+		size_t index = window.start % capacity;
+		window.spanMs -= durations[index];
+		if (flags[index] & FLAG_CLOSED) {
+			window.closedMs -= durations[index];
+		}
+		if (flags[index] & FLAG_BLINK_END) {
+			window.blinks--;
+		}
+		if ((flags[index] & FLAG_FACE_FOUND) && ears[index] >= 0.0f) {
+			window.earSum -= ears[index];
+			window.earCount--;
+		}
+		window.start++;
+	}
 }
 
-void EyeClosureQueueManagement::saveEyeClosureStatus(bool eyeClosed) {
-	// 덱이 최대 크기에 도달했으면 가장 오래된 데이터 제거
-	if (eyeClosureDeque.size() >= MAX_DEQUE_SIZE) {
-		eyeClosureDeque.pop_front();
+template <typename Visitor>
+void EyeClosureQueueManagement::forEachRecent(int windowMs, Visitor visit) const {
+	if (head == 0) {
+		return;
+	}
+	int64_t latestMs = timestamps[(head - 1) % capacity];
+	uint64_t oldest = head > capacity ? head - capacity : 0;
+	for (uint64_t i = head; i > oldest; --i) {
+		size_t index = (i - 1) % capacity;
+		int64_t insideMs = timestamps[index] - (latestMs - windowMs);
+		if (insideMs <= 0) {
+			break;
+		}
+		// 구간 경계에 걸친 프레임은 구간 안쪽 시간만 반영
+		visit(index, std::min<int64_t>(durations[index], insideMs));
 	}
+}
 
-	// 새 데이터 추가
-	eyeClosureDeque.push_back(eyeClosed);
+std::vector<EyeStateSample> EyeClosureQueueManagement::getEyeClosureHistory(int durationMs) const {
+	std::lock_guard<std::mutex> lock(historyMutex);
+	std::vector<EyeStateSample> history;
+	forEachRecent(durationMs, [this, &history](size_t index, int64_t) {
+		history.push_back(EyeStateSample{timestamps[index], ears[index], confidences[index],
+																		 (flags[index] & FLAG_FACE_FOUND) != 0,
+																		 (flags[index] & FLAG_CLOSED) != 0});
+	});
+	std::reverse(history.begin(), history.end());
+	return history;
 }
 
-bool EyeClosureQueueManagement::detectSleepiness() {
-	if (eyeClosureDeque.size() < CONSECUTIVE_FRAMES_FOR_SLEEPINESS) {
-		return false;
+void EyeClosureQueueManagement::saveEyeClosureStatus(const EyeStateSample& sample) {
+	std::lock_guard<std::mutex> lock(historyMutex);
+
+	// 이 프레임이 차지하는 시간 = 직전 프레임 이후 경과 시간 (첫 프레임은 0)
+	int64_t elapsedMs = 0;
+	if (head > 0) {
+		elapsedMs = sample.timestampMs - timestamps[(head - 1) % capacity];
+		elapsedMs = std::max<int64_t>(0, std::min<int64_t>(elapsedMs, config.maxSampleGapMs));
+	}
+
+	// 짧게 감았다가 뜬 경우 이번 프레임에 깜빡임 1회 기록
+	uint8_t sampleFlags = (sample.eyesClosed ? FLAG_CLOSED : 0) |
+												(sample.faceFound ? FLAG_FACE_FOUND : 0);
+	if (!sample.eyesClosed && closedRunMs > 0 && closedRunMs <= config.maxBlinkMs) {
+		sampleFlags |= FLAG_BLINK_END;
 	}
+	closedRunMs = sample.eyesClosed ? closedRunMs + static_cast<int>(elapsedMs) : 0;
 
-	int consecutiveClosedFrames = 0;
-	int maxConsecutiveClosedFrames = 0;
+	// 덮어쓸 자리의 프레임이 구간에 남아 있으면 먼저 뺌
+	evictFromWindow(perclosWindow, sample.timestampMs);
+	evictFromWindow(blinkWindow, sample.timestampMs);
 
-	// deque의 뒤에서부터 앞으로 순회하면서 현재 연속된 감김 프레임 수를 계산
-	for (auto it = eyeClosureDeque.rbegin(); it != eyeClosureDeque.rend(); ++it) {
-		if (*it) {	// 눈이 감긴 상태
-			consecutiveClosedFrames++;
-			maxConsecutiveClosedFrames = std::max(maxConsecutiveClosedFrames, consecutiveClosedFrames);
-		} else {	// 눈이 열린 상태
-			break;	// 연속성이 깨졌으므로 중단
+	size_t index = head % capacity;
+	timestamps[index] = sample.timestampMs;
+	ears[index] = sample.ear;
+	confidences[index] = sample.confidence;
+	durations[index] = static_cast<uint16_t>(elapsedMs);
+	flags[index] = sampleFlags;
+	head++;
+
+	addToWindow(perclosWindow, index);
+	addToWindow(blinkWindow, index);
+}
+
+void EyeClosureQueueManagement::saveEyeClosureStatus(bool eyeClosed) {
+	EyeStateSample sample;
+	sample.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+													 std::chrono::steady_clock::now().time_since_epoch())
+													 .count();
+	sample.eyesClosed = eyeClosed;
+	saveEyeClosureStatus(sample);
+}
+
+EyeClosureStats EyeClosureQueueManagement::getStats() const {
+	std::lock_guard<std::mutex> lock(historyMutex);
+	EyeClosureStats stats{};
+	stats.closedRunMs = closedRunMs;
+	stats.samples = head;
+	stats.perclos = perclosWindow.spanMs > 0
+											? static_cast<double>(perclosWindow.closedMs) / perclosWindow.spanMs
+											: 0.0;
+	stats.blinksPerMinute =
+			blinkWindow.spanMs > 0 ? blinkWindow.blinks * 60000.0 / blinkWindow.spanMs : 0.0;
+	stats.meanEar = perclosWindow.earCount > 0
+											? static_cast<float>(perclosWindow.earSum / perclosWindow.earCount)
+											: -1.0f;
+	return stats;
+}
+
+int EyeClosureQueueManagement::getClosedDurationMs(int windowMs) const {
+	std::lock_guard<std::mutex> lock(historyMutex);
+	int closedMs = 0;
+	forEachRecent(windowMs, [this, &closedMs](size_t index, int64_t coveredMs) {
+		if (flags[index] & FLAG_CLOSED) {
+			closedMs += static_cast<int>(coveredMs);
 		}
-	}
+	});
+	return closedMs;
+}
 
-	std::cout << "Current consecutive closed frames from end: " << consecutiveClosedFrames
-						<< std::endl;
+float EyeClosureQueueManagement::getMeanEar(int windowMs) const {
+	std::lock_guard<std::mutex> lock(historyMutex);
+	double sum = 0.0;
+	size_t count = 0;
+	forEachRecent(windowMs, [this, &sum, &count](size_t index, int64_t) {
+		if ((flags[index] & FLAG_FACE_FOUND) && ears[index] >= 0.0f) {
+			sum += ears[index];
+			count++;
+		}
+	});
+	return count > 0 ? static_cast<float>(sum / count) : -1.0f;
+}
 
-	// 현재 시점에서 연속으로 감긴 프레임이 임계값 이상인지 확인
-	return consecutiveClosedFrames >= CONSECUTIVE_FRAMES_FOR_SLEEPINESS;
-}
\ No newline at end of file
+bool EyeClosureQueueManagement::detectSleepiness() const {
+	EyeClosureStats stats = getStats();
+
+	std::cout << "Current closed duration: " << stats.closedRunMs << "ms, PERCLOS "
+						<< stats.perclos * 100.0 << "%, blinks/min " << stats.blinksPerMinute << ", mean EAR "
+						<< stats.meanEar << std::endl;
+
+	// 현재 시점에서 연속으로 감긴 시간이 기준 이상인지 확인
+	return stats.closedRunMs >= config.closedDurationMs;
+}
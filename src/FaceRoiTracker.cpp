@@ -0,0 +1,196 @@
+#include "../include/FaceRoiTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// 광학 흐름 추적에 필요한 최소 랜드마크 비율
+const double MIN_TRACKED_RATIO = 0.5;
+
+double median(std::vector<double>& values) {
+	size_t mid = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + mid, values.end());
+	return values[mid];
+}
+}	 // namespace
+
+FaceRoiTracker::FaceRoiTracker(int redetectInterval, double roiMargin)
+		: redetectInterval(std::max(1, redetectInterval)),
+			roiMargin(roiMargin),
+			tracking(false),
+			framesSinceFullDetection(0),
+			fullDetectionCount(0),
+			trackedFrameCount(0),
+			lostCount(0) {}
+
+cv::Rect FaceRoiTracker::getSearchRoi(const cv::Size& frameSize) const {
+	cv::Rect fullFrame(cv::Point(0, 0), frameSize);
+
+	std::lock_guard<std::mutex> lock(trackerMutex);
+	if (!tracking || faceRect.empty() || framesSinceFullDetection >= redetectInterval) {
+		return fullFrame;
+	}
+
+	// 얼굴 주변 여백을 포함한 영역 (다음 프레임까지의 움직임 흡수)
+	int marginX = static_cast<int>(faceRect.width * roiMargin);
+	int marginY = static_cast<int>(faceRect.height * roiMargin);
+	cv::Rect roi(faceRect.x - marginX, faceRect.y - marginY, faceRect.width + 2 * marginX,
+							 faceRect.height + 2 * marginY);
+	roi &= fullFrame;
+	return roi.empty() ? fullFrame : roi;
+}
+
+cv::Rect FaceRoiTracker::predictFaceRect(const cv::Mat& roiImage, const cv::Rect& roi,
+																				 const cv::Size& frameSize) {
+	std::lock_guard<std::mutex> lock(trackerMutex);
+
+	// 프레임 전체가 들어왔으면 전체 검출 주기이므로 예측하지 않음
+	if (!tracking || roi == cv::Rect(cv::Point(0, 0), frameSize)) {
+		return cv::Rect();
+	}
+	if (previousImage.empty() || trackedPoints.empty()) {
+		return faceRect & roi;
+	}
+
+	// 이전 ROI 와 현재 ROI 가 겹치는 영역에서 랜드마크를 광학 흐름으로 추적
+	cv::Rect overlap = previousRoi & roi;
+	if (overlap.area() == 0) {
+		return cv::Rect();
+	}
+
+	cv::Mat previousPatch = previousImage(overlap - previousRoi.tl());
+	cv::Mat currentPatch = roiImage(overlap - roi.tl());
+
+	std::vector<cv::Point2f> previousPoints;
+	previousPoints.reserve(trackedPoints.size());
+	cv::Point2f overlapOrigin(static_cast<float>(overlap.x), static_cast<float>(overlap.y));
+	for (const auto& point : trackedPoints) {
+		if (overlap.contains(cv::Point(static_cast<int>(point.x), static_cast<int>(point.y)))) {
+			previousPoints.push_back(point - overlapOrigin);
+		}
+	}
+	if (previousPoints.size() < trackedPoints.size() * MIN_TRACKED_RATIO) {
+		return cv::Rect();
+	}
+
+	std::vector<cv::Point2f> currentPoints;
+	std::vector<uchar> status;
+	std::vector<float> error;
+	try {
+		cv::calcOpticalFlowPyrLK(previousPatch, currentPatch, previousPoints, currentPoints, status,
+														 error, cv::Size(21, 21), 2);
+	} catch (const cv::Exception& e) {
+		std::cerr << "Optical flow error during face tracking: " << e.what() << std::endl;
+		return cv::Rect();
+	}
+
+	// 추적 성공한 점들의 이동량(중앙값)과 크기 변화(중심 거리 비율의 중앙값) 계산
+	std::vector<cv::Point2f> goodPrevious, goodCurrent;
+	for (size_t i = 0; i < status.size(); ++i) {
+		if (status[i]) {
+			goodPrevious.push_back(previousPoints[i]);
+			goodCurrent.push_back(currentPoints[i]);
+		}
+	}
+	if (goodPrevious.size() < trackedPoints.size() * MIN_TRACKED_RATIO) {
+		return cv::Rect();
+	}
+
+	std::vector<double> dx, dy;
+	cv::Point2f previousCenter(0, 0), currentCenter(0, 0);
+	for (size_t i = 0; i < goodPrevious.size(); ++i) {
+		dx.push_back(goodCurrent[i].x - goodPrevious[i].x);
+		dy.push_back(goodCurrent[i].y - goodPrevious[i].y);
+		previousCenter += goodPrevious[i];
+		currentCenter += goodCurrent[i];
+	}
+	previousCenter *= 1.0f / goodPrevious.size();
+	currentCenter *= 1.0f / goodCurrent.size();
+
+	std::vector<double> scales;
+	for (size_t i = 0; i < goodPrevious.size(); ++i) {
+		double previousDistance = cv::norm(goodPrevious[i] - previousCenter);
+		if (previousDistance > 1.0) {
+			scales.push_back(cv::norm(goodCurrent[i] - currentCenter) / previousDistance);
+		}
+	}
+	double scale = scales.empty() ? 1.0 : median(scales);
+	double shiftX = median(dx);
+	double shiftY = median(dy);
+
+	// 이전 얼굴 영역을 이동/확대하여 예측 위치 계산
+	double centerX = faceRect.x + faceRect.width / 2.0 + shiftX;
+	double centerY = faceRect.y + faceRect.height / 2.0 + shiftY;
+	double width = faceRect.width * scale;
+	double height = faceRect.height * scale;
+	cv::Rect predicted(static_cast<int>(centerX - width / 2.0), static_cast<int>(centerY - height / 2.0),
+										 static_cast<int>(width), static_cast<int>(height));
+
+	// 예측 위치가 ROI 밖으로 많이 벗어나면 추적 실패로 보고 ROI 안에서 다시 검출
+	cv::Rect clipped = predicted & roi;
+	if (clipped.area() < predicted.area() / 2) {
+		return cv::Rect();
+	}
+	return clipped;
+}
+
+bool FaceRoiTracker::update(const EyeClosureResult& result, const cv::Mat& roiImage,
+														const cv::Rect& roi, const cv::Size& frameSize,
+														const cv::Rect& faceHint) {
+	std::lock_guard<std::mutex> lock(trackerMutex);
+
+	if (!result.faceFound || result.landmarks.empty() || result.faceRect.empty()) {
+		markLost();
+		return false;
+	}
+
+	// 예측 위치로 찾은 랜드마크가 예측 영역과 크게 어긋나면 추적 실패
+	if (!faceHint.empty()) {
+		cv::Rect landmarkBox = cv::boundingRect(result.landmarks);
+		cv::Point center = (landmarkBox.tl() + landmarkBox.br()) / 2;
+		double widthRatio = static_cast<double>(landmarkBox.width) / faceHint.width;
+		if (!faceHint.contains(center) || widthRatio < 0.4 || widthRatio > 1.6) {
+			markLost();
+			return false;
+		}
+		trackedFrameCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	faceRect = result.faceRect;
+	trackedPoints = result.landmarks;
+	previousImage = roiImage;
+	previousRoi = roi;
+	tracking = true;
+
+	if (roi == cv::Rect(cv::Point(0, 0), frameSize)) {
+		framesSinceFullDetection = 0;
+		fullDetectionCount.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		framesSinceFullDetection++;
+	}
+	return true;
+}
+
+void FaceRoiTracker::markLost() {
+	if (tracking) {
+		lostCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	tracking = false;
+	trackedPoints.clear();
+	previousImage.release();
+}
+
+void FaceRoiTracker::reset() {
+	std::lock_guard<std::mutex> lock(trackerMutex);
+	tracking = false;
+	framesSinceFullDetection = 0;
+	faceRect = cv::Rect();
+	trackedPoints.clear();
+	previousImage.release();
+}
+
+bool FaceRoiTracker::isTracking() const {
+	std::lock_guard<std::mutex> lock(trackerMutex);
+	return tracking;
+}
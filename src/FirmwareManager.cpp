@@ -4,14 +4,42 @@
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <opencv2/opencv.hpp>
 #include <sstream>
 #include <thread>
 
+#include "../include/BackendClient.h"
 #include "../include/DBThread.h"
 #include "../include/SleepinessDetector.h"
 
+namespace {
+// 시각을 yyyyMMdd_HHmmss_fff 형식 문자열로 변환 (프레임 파일명 및 진단 요청 시각)
+std::string makeTimestamp(const std::chrono::system_clock::time_point& time) {
+	auto in_time_t = std::chrono::system_clock::to_time_t(time);
+	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()) % 1000;
+
+	// 캡처/판별 스레드에서 동시에 호출되므로 재진입 가능한 localtime 사용
+	std::tm localTime{};
+#ifdef _WIN32
+	localtime_s(&localTime, &in_time_t);
+#else
+	localtime_r(&in_time_t, &localTime);
+#endif
+
+	std::stringstream ss;
+	ss << std::put_time(&localTime, "%Y%m%d_%H%M%S");
+	ss << '_' << std::setfill('0') << std::setw(3) << ms.count();
+	return ss.str();
+}
+
+// steady_clock 시각을 밀리초로 (눈 감김 구간/근거 영상 구간 등 시간 간격 계산용)
+int64_t steadyMs(const std::chrono::steady_clock::time_point& time) {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+}	 // namespace
+
 // NumPy 배열 초기화를 위한 헬퍼 함수
 bool FirmwareManager::initializePythonAndNumpy() {
 	Py_Initialize();
@@ -30,12 +58,22 @@ bool FirmwareManager::initializePythonAndNumpy() {
 }
 
 FirmwareManager::FirmwareManager(const std::string& uid)
-		: deviceUID(uid), isRunning(false), isPaused(false), frameCycle(0), diagnosticCycle(0) {
+		: deviceUID(uid),
+			isRunning(false),
+			isPaused(false),
+			frameScheduler(std::chrono::nanoseconds(1000000000 / FRAMES_PER_SECOND)),
+			nextDiagnosisSlot(DIAGNOSIS_INTERVAL_SLOTS),
+			diagnosticCycle(0),
+			captureQueue("capture", 4, DropPolicy::DropOldest),
+			preprocessQueue("preprocess", 4, DropPolicy::DropOldest),
+			persistenceQueue("persistence", 32, DropPolicy::DropNewest),
+			uplinkQueue("uplink", 16, DropPolicy::DropOldest) {
 	std::cout << "NoSleep Drive 펌웨어 매니저 초기화 중 (ID: " << uid << ")..." << std::endl;
 
 	try {
 		// 환경 변수에 장치 UID 설정
 		setEnvVar("DEVICE_UID", deviceUID);
+		BackendClient::getInstance().reloadConfig();	// 서버 설정은 이후 다시 읽지 않음
 
 		// Python 및 NumPy 초기화
 		std::cout << "Python 및 NumPy 초기화 중..." << std::endl;
@@ -44,43 +82,48 @@ FirmwareManager::FirmwareManager(const std::string& uid)
 			throw std::runtime_error("Python/NumPy 초기화 실패");
 		}
 
-		// Python 모듈 로드 (눈 감음 감지 라이브러리)
-		std::cout << "Python 모듈 로드 중..." << std::endl;
-		PyObject* pModule = PyImport_ImportModule("eye_detection_lib");
-		if (pModule == nullptr) {
-			PyErr_Print();
-			std::cerr << "Failed to import eye_detection_lib module" << std::endl;
-		} else {
-			// 초기화 함수 호출
-			PyObject* pFunc = PyObject_GetAttrString(pModule, "initialize");
-			if (pFunc != nullptr && PyCallable_Check(pFunc)) {
-				PyObject* pValue = PyObject_CallObject(pFunc, nullptr);
-				if (pValue != nullptr) {
-					bool result = PyObject_IsTrue(pValue);
-					if (result) {
-						std::cout << "Python eye detection initialized successfully" << std::endl;
-					} else {
-						std::cerr << "Python eye detection initialization failed" << std::endl;
-					}
-					Py_DECREF(pValue);
-				}
-				Py_DECREF(pFunc);
-			}
-			Py_DECREF(pModule);
-		}
-
 		PyEval_InitThreads();
 		PyEval_SaveThread();
 
 		// 객체들 초기화
 		std::cout << "컴포넌트 객체들 초기화 중..." << std::endl;
 		camera = std::make_unique<Camera>();
-		accelerationSensor = std::make_unique<AccelerationSensor>(true);	// 목업 센서 사용
+		// ACCEL_SOURCE 가 없으면 목업 센서 사용 (i2c: ADXL345 네이티브 드라이버, 파일 경로: 궤적 재생)
+		const char* accelSourceC = std::getenv("ACCEL_SOURCE");
+		accelerationSensor =
+				std::make_unique<AccelerationSensor>(!accelSourceC || std::string(accelSourceC).empty());
+		motionMonitor = MotionStateMonitor::fromEnvironment(*accelerationSensor);
 		speaker = std::make_unique<Speaker>();
 		sleepinessDetector = std::make_unique<SleepinessDetector>();
 		eyeClosureQueue = std::make_unique<EyeClosureQueueManagement>();
+		earCalibrator = EarCalibrator::fromEnvironment();	// DRIVER_ID 별 저장된 EAR 프로필 복원
 		utils = std::make_unique<Utils>("./frames");
+		recentFrames = std::make_unique<FrameRingBuffer>(RECENT_FRAME_CAPACITY);
 		threadMonitor = std::make_unique<DBThreadMonitoring>();
+		diagnosisClient = std::make_unique<DiagnosisClient>();
+		if (!diagnosisClient->initialize()) {
+			std::cerr << "AI 진단 클라이언트 초기화 실패, 로컬 진단만 사용" << std::endl;
+		}
+		frameUplink = FrameUplink::fromEnvironment();	// 배치 전송 (설정된 경우에만)
+		uplinkRoiOnly = frameUplink ? frameUplink->isRoiOnly() : FrameUplink::roiOnlyFromEnvironment();
+		governor = ProcessingGovernor::fromEnvironment();
+		thermalMonitor = ThermalMonitor::fromEnvironment();
+		metricsExporter = MetricsExporter::fromEnvironment();	// METRICS_PORT/METRICS_FILE 설정 시
+
+		// 눈 감음 판별 엔진 선택 (EYE_DETECTOR=python 이면 Python 경로 사용)
+		const char* detectorC = std::getenv("EYE_DETECTOR");
+		bool useNativeDetector = !(detectorC && std::string(detectorC) == "python");
+		eyeClosureDetector = std::make_unique<EyeClosureDetector>(useNativeDetector);
+		if (!eyeClosureDetector->initialize()) {
+			std::cerr << "눈 감음 판별 엔진 초기화 실패" << std::endl;
+		}
+		eyeClosureDetector->setDetectionWidth(governor->getProfile().detectionWidth);
+
+		// 얼굴 ROI 추적은 랜드마크 좌표를 제공하는 엔진에서만 사용
+		if (eyeClosureDetector->supportsRoiTracking()) {
+			faceTracker = std::make_unique<FaceRoiTracker>();
+			std::cout << "얼굴 ROI 추적 사용" << std::endl;
+		}
 
 		std::cout << "FirmwareManager initialized with device UID: " << deviceUID << std::endl;
 		std::cout << "NoSleep Drive 펌웨어 매니저 초기화 완료" << std::endl;
@@ -127,8 +170,9 @@ void FirmwareManager::initializeDevices() {
 void FirmwareManager::sendDeviceStatusToBackend() {
 	std::cout << "=== 장치 상태 백엔드 전송 ===" << std::endl;
 
-	// 전역 장치 상태 매니저를 통해 백엔드로 상태 전송
-	DeviceStatusManager::getInstance().sendDeviceStatusToBackend();
+	// 전역 장치 상태 매니저를 통해 백엔드로 상태 전송 (업로드 워커에서 가장 낮은 우선순위로 처리)
+	threadMonitor->submitJob(UploadPriority::Telemetry, "device status",
+													 [] { DeviceStatusManager::getInstance().sendDeviceStatusToBackend(); });
 
 	// 장치 상태 로깅
 	auto deviceStatus = DeviceStatusManager::getInstance().getAllDeviceStatus();
@@ -145,15 +189,25 @@ void FirmwareManager::start() {
 	}
 
 	try {
+		// 업로드 워커 시작 (stop() 이후 재시작하는 경우 포함)
+		threadMonitor->startDBMonitoring();
+
 		// 장치 초기화
 		initializeDevices();
 
 		isRunning.store(true);
 		isPaused.store(false);
 
-		// 메인 루프 스레드 시작
+		// 가속도 샘플링, 파이프라인 워커 및 캡처(메인 루프) 스레드 시작
 		speaker->triggerStart();	// 시작 사운드 재생
+		motionMonitor->start();
+		thermalMonitor->start();
+		if (metricsExporter) {
+			metricsExporter->start();
+		}
+		startPipelineThreads();
 		mainThread = std::thread(&FirmwareManager::mainLoop, this);
+		setThreadAffinity(mainThread, 0);
 
 		std::cout << "FirmwareManager started" << std::endl;
 	} catch (const std::exception& e) {
@@ -173,6 +227,19 @@ void FirmwareManager::stop() {
 	if (mainThread.joinable()) {
 		mainThread.join();
 	}
+	motionMonitor->stop();
+	thermalMonitor->stop();
+	stopPipelineThreads();
+
+	// 이번 주행의 EAR 구간 평균을 프로필에 반영하고 저장
+	earCalibrator->endTrip();
+
+	// 남은 근거 영상 업로드를 마친 뒤 워커 종료 (진단 작업이 이 객체를 참조하므로 소멸 전에 정리)
+	threadMonitor->shutdown();
+	logPipelineStats();
+	if (metricsExporter) {
+		metricsExporter->stop();	// 종료 직전 값을 파일에 남김
+	}
 
 	std::cout << "FirmwareManager stopped" << std::endl;
 }
@@ -195,52 +262,372 @@ bool FirmwareManager::isDeviceRunning() const {
 	return isRunning.load();
 }
 
+std::vector<QueueStats> FirmwareManager::getPipelineStats() const {
+	return {captureQueue.getStats(), preprocessQueue.getStats(), persistenceQueue.getStats(),
+					uplinkQueue.getStats()};
+}
+
+uint64_t FirmwareManager::getReorderDropCount() const {
+	return reorderDropCount.load(std::memory_order_relaxed);
+}
+
+void FirmwareManager::logPipelineStats() const {
+	std::cout << "[Pipeline] ";
+	for (const auto& stats : getPipelineStats()) {
+		std::cout << stats.name << "(depth " << stats.depth << "/" << stats.capacity << ", drop "
+							<< stats.dropped << ") ";
+	}
+	std::cout << "reorder-drop " << getReorderDropCount() << ", evidence-missing "
+						<< missingEvidenceCount.load(std::memory_order_relaxed);
+	if (faceTracker) {
+		std::cout << " | face full-detect " << faceTracker->getFullDetectionCount() << ", tracked "
+							<< faceTracker->getTrackedFrameCount() << ", lost " << faceTracker->getLostCount();
+	}
+	if (frameUplink) {
+		std::cout << " | uplink batches " << frameUplink->getSentBatches() << " ("
+							<< frameUplink->getSentFrames() << " frames, " << frameUplink->getSentBytes()
+							<< " bytes), failed " << frameUplink->getFailedBatches();
+	}
+	std::cout << std::endl;
+	motionMonitor->logStats();
+	governor->logStats();
+	thermalMonitor->logStats();
+	LatencyMetrics::getInstance().logStats();
+	diagnosisClient->logStats();
+	BackendClient::getInstance().logStats();
+	threadMonitor->logStats();
+}
+
+void FirmwareManager::startPipelineThreads() {
+	// 단계별 워커 스레드 시작 후 가능한 경우 서로 다른 코어에 고정
+	for (int i = 0; i < PREPROCESS_WORKER_COUNT; ++i) {
+		preprocessThreads.emplace_back(&FirmwareManager::preprocessLoop, this);
+		setThreadAffinity(preprocessThreads.back(), 1 + i);
+	}
+	detectionThread = std::thread(&FirmwareManager::detectionLoop, this);
+	setThreadAffinity(detectionThread, 3);
+	persistenceThread = std::thread(&FirmwareManager::persistenceLoop, this);
+	uplinkThread = std::thread(&FirmwareManager::uplinkLoop, this);
+}
+
+void FirmwareManager::stopPipelineThreads() {
+	captureQueue.wakeAll();
+	preprocessQueue.wakeAll();
+	persistenceQueue.wakeAll();
+	uplinkQueue.wakeAll();
+
+	for (auto& thread : preprocessThreads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	preprocessThreads.clear();
+
+	if (detectionThread.joinable()) {
+		detectionThread.join();
+	}
+	if (persistenceThread.joinable()) {
+		persistenceThread.join();
+	}
+	if (uplinkThread.joinable()) {
+		uplinkThread.join();
+	}
+}
+
 void FirmwareManager::mainLoop() {
 	std::cout << "Main loop started" << std::endl;
 
-	const auto frameInterval = std::chrono::microseconds(42000);	// 0.042초 (42ms)
-	auto lastFrameTime = std::chrono::high_resolution_clock::now();
+	// 카메라 프레임이 도착하는 즉시 처리 (고정 격자로 기다린 뒤 다시 appsink 를 기다리지 않음)
+	// 스케줄러는 도착한 프레임에 슬롯 번호를 매기고 대기 시간 제한만 정함
+	// 파일 재생처럼 스스로 주기를 맞추지 않는 공급원만 절대 시각 격자(24fps)에 맞춰 읽음
+	frameScheduler.reset();
+	const uint64_t statsIntervalSlots = FRAMES_PER_SECOND * 10;
+	const auto captureTimeout = frameScheduler.arrivalTimeout(CAPTURE_TIMEOUT_SLOTS);
+	uint64_t nextStatsSlot = statsIntervalSlots;
 
 	while (isRunning.load()) {
-		auto currentTime = std::chrono::high_resolution_clock::now();
-		auto elapsedTime = currentTime - lastFrameTime;
+		// 차량이 움직이고 있지 않으면 처리하지 않음 (샘플링 스레드가 히스테리시스를 거쳐 공개한 상태)
+		if (!motionMonitor->isMoving()) {
+			// 차량이 정차 중일 때 처리 로직
+			handleVehicleStopped();
+
+			// 짧은 대기 후 다음 반복으로 (재개 시 격자를 다시 맞춰 건너뛴 슬롯으로 세지 않음)
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			frameScheduler.reset();
+			continue;
+		}
 
-		// 0.042초마다 프레임 처리 (1주기)
-		if (elapsedTime >= frameInterval) {
-			lastFrameTime = currentTime;
+		// 일시 중지 상태면 처리하지 않음
+		if (isPaused.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			frameScheduler.reset();
+			continue;
+		}
 
-			// 차량이 움직이고 있지 않으면 처리하지 않음
-			if (!accelerationSensor->isMoving()) {
-				// 차량이 정차 중일 때 처리 로직
-				handleVehicleStopped();
+		CapturedFrame captured;
+		uint64_t slot = 0;
+		bool live = camera->isLive();
+		if (!live) {
+			slot = frameScheduler.waitNextSlot();
+		}
+		// 제한 시간 안에 프레임이 없으면 정차/일시 중지/종료 여부를 다시 확인
+		// (공백은 다음 프레임 도착 시 건너뛴 슬롯으로 기록)
+		auto captureStartedAt = std::chrono::steady_clock::now();
+		if (!camera->capture(captured, captureTimeout)) {
+			// 카메라가 없거나 파이프라인이 끊기면 capture() 가 즉시 실패하며 재초기화를 시도하므로,
+			// 최소 제한 시간만큼 쉬어 재초기화/오류 로그가 연속으로 반복되지 않도록 함
+			std::this_thread::sleep_until(captureStartedAt + captureTimeout);
+			continue;
+		}
+		if (live) {
+			slot = frameScheduler.frameArrived();
+		}
+
+		// 프레임 캡처 후 전처리 큐에 전달, 이후 단계는 파이프라인 스레드에서 처리
+		// 처리 모드에 따라 일부 슬롯만 캡처 (나머지 프레임은 버퍼를 바로 반환)
+		if (governor->shouldCapture(slot)) {
+			captureFrameToPipeline(slot, captured);
+		}
+
+		if (slot >= nextStatsSlot) {
+			nextStatsSlot = slot + statsIntervalSlots;
+			logSchedulerStats();
+		}
+	}
+
+	logSchedulerStats();
+	std::cout << "Main loop ended" << std::endl;
+}
+
+void FirmwareManager::logSchedulerStats() const {
+	FrameSchedulerStats stats = frameScheduler.getStats();
+	std::cout << "[Scheduler] frames " << stats.ticks << ", skipped " << stats.skippedSlots
+						<< " (overruns " << stats.overruns << ") | jitter p50/p99/max " << stats.jitterP50Us
+						<< "/" << stats.jitterP99Us << "/" << stats.jitterMaxUs << "us" << std::endl;
+}
+
+void FirmwareManager::preprocessLoop() {
+	// 정규화기는 내부 버퍼를 재사용하므로 워커마다 하나씩 사용 (커널은 판별 스트림 해상도 기준)
+	IlluminationNormalizer normalizer(
+			IlluminationNormalizer::kernelSizeForHeight(camera->getResolution()[1]));
+	FramePacketPtr packet;
+	while (isRunning.load()) {
+		if (!captureQueue.popWait(packet, std::chrono::milliseconds(100))) {
+			continue;
+		}
 
-				// 짧은 대기 후 다음 반복으로
-				std::this_thread::sleep_for(std::chrono::milliseconds(100));
-				continue;
+		// 발열 단계에 따라 배경 추정 해상도를 낮춤
+		// 커널은 실제 프레임 높이 기준 (단일 스트림 대체 경로는 판별 프레임이 근거 영상 해상도)
+		normalizer.setDownscaleFactor(thermalMonitor->getDegradation().normalizerDownscale);
+		normalizer.setMedianKernelSize(
+				IlluminationNormalizer::kernelSizeForHeight(packet->frameSize.height));
+		bool preprocessed = preprocessFrame(*packet, normalizer);
+
+		// 이후 단계는 전처리 결과만 쓰므로 캡처 버퍼를 바로 반환 (전체 프레임 전송 모드에서 ROI 만
+		// 전처리한 경우는 전송 단계에서 전체 프레임을 다시 전처리해야 하므로 유지)
+		if (uplinkRoiOnly || packet->roi.size() == packet->frameSize) {
+			packet->buffers.reset();
+		}
+		if (preprocessed) {
+			preprocessQueue.push(std::move(packet));
+		}
+		packet.reset();
+	}
+}
+
+void FirmwareManager::detectionLoop() {
+	// 전처리 워커가 여러 개이므로 캡처 순번 기준으로 순서를 복원한 뒤 판별
+	std::map<uint64_t, FramePacketPtr> pending;
+	std::vector<FramePacketPtr> readyBatch;
+	uint64_t nextSequence = 0;
+	FramePacketPtr packet;
+
+	while (isRunning.load()) {
+		bool received = preprocessQueue.popWait(packet, std::chrono::milliseconds(100));
+
+		// 진단 결과는 판별 스레드에서 반영 (응답이 늦으면 기한 시점에 로컬 판별로 대체)
+		pollDiagnosis();
+		if (!received) {
+			continue;
+		}
+
+		// 이미 도착해 있는 프레임도 함께 꺼내 한 번에 판별
+		do {
+			if (packet->sequence < nextSequence) {
+				// 이미 뒤 프레임을 판별했으므로 늦게 도착한 프레임은 버림
+				reorderDropCount.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				pending[packet->sequence] = std::move(packet);
 			}
+		} while (preprocessQueue.tryPop(packet));
 
-			// 일시 중지 상태면 처리하지 않음
-			if (isPaused.load()) {
-				std::this_thread::sleep_for(std::chrono::milliseconds(10));
-				continue;
+		while (!pending.empty()) {
+			auto it = pending.begin();
+
+			// 앞선 프레임이 다른 워커에서 아직 처리 중일 수 있으면 대기 (드롭된 순번은 건너뜀)
+			if (it->first != nextSequence &&
+					pending.size() < static_cast<size_t>(PREPROCESS_WORKER_COUNT)) {
+				break;
 			}
 
-			// 프레임 처리
-			processSingleFrame();
+			nextSequence = it->first + 1;
+			readyBatch.push_back(std::move(it->second));
+			pending.erase(it);
+		}
+		if (readyBatch.empty()) {
+			continue;
+		}
 
-			// 24 주기(1초)마다 진단 요청
-			frameCycle++;
-			if (frameCycle >= 24) {
-				frameCycle = 0;
+		// 순서가 맞춰진 프레임을 한 번에 판별 (Python 경로는 GIL 을 한 번만 획득)
+		detectEyeClosures(readyBatch);
+
+		// 캡처부터 판별 완료까지 걸린 시간 (프레임 예산 42ms 대비)
+		auto decidedAt = std::chrono::steady_clock::now();
+		for (const auto& ready : readyBatch) {
+			auto frameLatency = decidedAt - ready->capturedAtSteady;
+			LatencyMetrics::getInstance().record(
+					LatencyStage::FrameTotal,
+					std::chrono::duration_cast<std::chrono::microseconds>(frameLatency).count());
+		}
+
+		// 최근 EAR 추세로 다음 프레임들의 처리 모드 결정 (눈이 감기기 시작하면 바로 최대 처리)
+		updateProcessingMode(steadyMs(readyBatch.back()->capturedAtSteady));
+
+		// 스로틀 직전에는 AI 서버 전송을 멈추고 로컬 판별만 사용
+		bool uplinkAllowed = !thermalMonitor->getDegradation().skipUplink;
+		for (auto& ready : readyBatch) {
+			// 전송 단계로 전달 (저장 단계는 캡처 직후 따로 받음)
+			if (uplinkAllowed && governor->shouldUplink(ready->sequence)) {
+				uplinkQueue.push(ready);
+			}
+
+			// 24 슬롯(1초)마다 진단 요청 (드롭/건너뛴 프레임이 있어도 주기가 늘어나지 않도록 슬롯 기준)
+			if (ready->frameSlot >= nextDiagnosisSlot) {
+				nextDiagnosisSlot =
+						(ready->frameSlot / DIAGNOSIS_INTERVAL_SLOTS + 1) * DIAGNOSIS_INTERVAL_SLOTS;
 				requestDiagnosis();
+
+				if (diagnosticCycle % 10 == 0) {
+					logPipelineStats();
+				}
+			}
+		}
+		readyBatch.clear();
+	}
+}
+
+void FirmwareManager::updateProcessingMode(int64_t nowMs) {
+	GovernorInputs inputs;
+	inputs.nowMs = nowMs;
+
+	MotionStats motion = motionMonitor->getStats();
+	inputs.moving = motion.moving;
+	inputs.motionVariance = motion.variance;
+
+	EyeClosureStats eyes = eyeClosureQueue->getStats();
+	inputs.closedRunMs = eyes.closedRunMs;
+	inputs.perclos = eyes.perclos;
+	inputs.recentEar = eyeClosureQueue->getMeanEar(RECENT_EAR_WINDOW_MS);
+	inputs.earThreshold = earCalibrator->getThreshold();
+
+	// CPU 온도/사용률은 발열 감시 스레드가 1초마다 갱신
+	inputs.cpuTemperatureC = thermalMonitor->getTemperatureC();
+	inputs.cpuLoad = thermalMonitor->getCpuUtilization();
+
+	ProcessingMode previous = governor->getMode();
+	ProcessingMode mode = governor->evaluate(inputs);
+	if (mode != previous) {
+		eyeClosureDetector->setDetectionWidth(governor->profileOf(mode).detectionWidth);
+		std::cout << "처리 모드 전환: " << ProcessingGovernor::modeName(previous) << " -> "
+							<< ProcessingGovernor::modeName(mode) << " (EAR " << inputs.recentEar << ", 감김 "
+							<< inputs.closedRunMs << "ms, PERCLOS " << inputs.perclos << ")" << std::endl;
+	}
+}
+
+void FirmwareManager::persistenceLoop() {
+	FramePacketPtr packet;
+	while (isRunning.load()) {
+		if (!persistenceQueue.popWait(packet, std::chrono::milliseconds(100))) {
+			continue;
+		}
+		persistFrame(*packet);
+		packet.reset();
+	}
+}
+
+void FirmwareManager::uplinkLoop() {
+	IlluminationNormalizer normalizer(
+			IlluminationNormalizer::kernelSizeForHeight(camera->getResolution()[1]));
+	cv::Mat uplinkFrame;
+	FramePacketPtr packet;
+	while (isRunning.load()) {
+		if (!uplinkQueue.popWait(packet, std::chrono::milliseconds(100))) {
+			// 프레임이 끊겨도 모아 둔 배치는 오래 붙잡지 않음
+			if (frameUplink) {
+				frameUplink->flushIfDue();
+			}
+			continue;
+		}
+
+		// 서버에는 벽시계 기준 캡처 시각 전달
+		int64_t capturedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+															 packet->capturedAt.time_since_epoch())
+															 .count();
+
+		// 발열 단계에 따라 JPEG 화질과 전체 프레임 전처리 해상도를 낮춤
+		const ThermalDegradation& degradation = thermalMonitor->getDegradation();
+		normalizer.setDownscaleFactor(degradation.normalizerDownscale);
+		normalizer.setMedianKernelSize(
+				IlluminationNormalizer::kernelSizeForHeight(packet->frameSize.height));
+		if (frameUplink) {
+			frameUplink->limitJpegQuality(degradation.jpegQuality);
+		}
+
+		// 얼굴 ROI 모드 (FRAME_UPLINK_ROI_ONLY=1): 전처리된 ROI 에서 얼굴 주변만 잘라 ROI 좌표와 함께 전송하고,
+		// 얼굴이 없으면 추적 ROI 를 그대로 전송 (전체 프레임 재전처리 없음)
+		// 전체 프레임 모드에서도 ROI 가 프레임 전체면 전처리 결과를 그대로 사용
+		cv::Rect uplinkRoi;
+		if (uplinkRoiOnly || packet->roi.size() == packet->frameSize) {
+			uplinkRoi = uplinkRoiOnly ? getUplinkFaceRoi(*packet) : cv::Rect();
+			if (uplinkRoi.empty()) {
+				uplinkRoi = packet->roi;
+			}
+			uplinkFrame = packet->preprocessedFrame(uplinkRoi - packet->roi.tl());
+			if (uplinkRoi.size() == packet->frameSize) {
+				uplinkRoi = cv::Rect();	// 전체 프레임
 			}
+		} else if (!packet->buffers || !normalizer.normalize(packet->buffers->frame, uplinkFrame)) {
+			// 전체 프레임 전송 모드 (기본) 에서 ROI 만 전처리된 경우 전체 프레임 전처리
+			packet.reset();
+			continue;
+		}
+
+		// AI 서버로 이미지 전송 (배치 모드면 여러 장을 모아 한 요청으로 전송)
+		if (frameUplink) {
+			frameUplink->addFrame(uplinkFrame, uplinkRoi, packet->sequence, capturedAtMs);
 		} else {
-			// CPU 점유율 감소를 위해 짧은 시간 대기
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			sleepinessDetector->sendDriverFrame(uplinkFrame, degradation.jpegQuality, uplinkRoi);
 		}
+		packet.reset();
 	}
 
-	std::cout << "Main loop ended" << std::endl;
+	if (frameUplink) {
+		frameUplink->flush();
+	}
+}
+
+cv::Rect FirmwareManager::getUplinkFaceRoi(const FramePacket& packet) const {
+	const cv::Rect& faceRect = packet.detection.faceRect;
+	if (!packet.detection.faceFound || faceRect.empty()) {
+		return cv::Rect();
+	}
+
+	// 얼굴 영역에 약간의 여백을 두고, 전처리된 영역 안으로 제한
+	int marginX = faceRect.width / 5;
+	int marginY = faceRect.height / 5;
+	cv::Rect faceRoi(faceRect.x - marginX, faceRect.y - marginY, faceRect.width + 2 * marginX,
+									 faceRect.height + 2 * marginY);
+	return faceRoi & packet.roi;
 }
 
 void FirmwareManager::handleVehicleStopped() {
@@ -252,153 +639,192 @@ void FirmwareManager::handleVehicleStopped() {
 		// 스레드가 이미 실행 중이므로 추가 작업 없음
 	} else {
 		std::cout << "차량 정차 감지: 실시간 영상 데이터 삭제" << std::endl;
-		// 실시간 영상을 저장하는 폴더 내의 모든 이미지 데이터 삭제
-		utils->removeFolder("recent");
+		// 최근 프레임 링 버퍼 비우기
+		recentFrames->clear();
 	}
 }
 
-bool FirmwareManager::processSingleFrame() {
-	// 1. 카메라에서 프레임 가져오기
-	cv::Mat frame = camera->captureFrame();
-	if (frame.empty()) {
-		std::cerr << "Error: Empty frame captured" << std::endl;
-		return false;
-	}
-
-	// 2. 이미지 전처리
-	cv::Mat preprocessedFrame;
-	try {
-		// 2.1 LAB 변환 및 L 채널 추출
-		cv::Mat lab;
-		cv::cvtColor(frame, lab, cv::COLOR_BGR2Lab);
-		std::vector<cv::Mat> labChannels(3);
-		cv::split(lab, labChannels);
-		cv::Mat lChannel = labChannels[0].clone();
-
-		// 2.2 미디안 필터 적용
-		cv::Mat medianL;
-		cv::medianBlur(lChannel, medianL, 99);
-
-		// 2.3 L 채널 반전
-		cv::Mat invertedL;
-		cv::bitwise_not(medianL, invertedL);
-
-		// 2.4 그레이스케일 변환
-		cv::Mat gray;
-		cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-
-		// 2.5 그레이스케일과 반전된 L 채널 합성
-		cv::addWeighted(gray, 0.75, invertedL, 0.25, 0, preprocessedFrame);
-	} catch (const cv::Exception& e) {
-		std::cerr << "OpenCV error during preprocessing: " << e.what() << std::endl;
-		return false;
-	}
+bool FirmwareManager::captureFrameToPipeline(uint64_t frameSlot, CapturedFrame& captured) {
+	ScopedLatency timer(LatencyStage::Capture);
+
+	auto packet = std::make_shared<FramePacket>();
+	packet->sequence = captureSequence++;
+	packet->frameSlot = frameSlot;
+	packet->capturedAt = std::chrono::system_clock::now();
+	packet->capturedAtSteady = std::chrono::steady_clock::now();
+	packet->timestamp = makeTimestamp(packet->capturedAt);
+	packet->frameSize = captured.image.size();
+	// 캡처 버퍼 뷰는 원본 픽셀이 필요한 전처리/저장 단계만 버퍼 소유권과 함께 참조
+	auto buffers = std::make_shared<CaptureBuffers>();
+	buffers->frame = std::move(captured.image);
+	buffers->evidenceFrame = std::move(captured.evidence);
+	buffers->owner = std::move(captured.owner);
+	packet->buffers = buffers;
+
+	// 저장 단계는 판별 결과와 무관하므로 캡처 직후 전처리와 나란히 처리 (별도 패킷으로 경합 없음)
+	auto persistPacket = std::make_shared<FramePacket>();
+	persistPacket->sequence = packet->sequence;
+	persistPacket->frameSlot = packet->frameSlot;
+	persistPacket->capturedAt = packet->capturedAt;
+	persistPacket->capturedAtSteady = packet->capturedAtSteady;
+	persistPacket->timestamp = packet->timestamp;
+	persistPacket->frameSize = packet->frameSize;
+	persistPacket->buffers = std::move(buffers);
+	persistenceQueue.push(std::move(persistPacket));
+
+	// 전처리 단계가 밀리면 가장 오래된 프레임부터 버려 캡처가 멈추지 않도록 함
+	return captureQueue.push(std::move(packet));
+}
 
-	// 3. 눈 감음 판단 (Python 함수 호출)
-	bool eyesClosed = false;
-	PyGILState_STATE gstate;
-	try {
-		gstate = PyGILState_Ensure();	 // GIL 획득
-		PyObject* pModule = PyImport_ImportModule("eye_detection_lib");
-		if (pModule != nullptr) {
-			PyObject* pFunc = PyObject_GetAttrString(pModule, "is_eye_closed");
-			if (pFunc != nullptr && PyCallable_Check(pFunc)) {
-				// cv::Mat을 NumPy 배열로 변환
-				npy_intp dims[3];
-				int nd;
-				int typenum;
-
-				if (preprocessedFrame.channels() == 1) {
-					// 그레이스케일 이미지
-					nd = 2;
-					dims[0] = preprocessedFrame.rows;
-					dims[1] = preprocessedFrame.cols;
-					typenum = NPY_UINT8;
-				} else {
-					// 컬러 이미지
-					nd = 3;
-					dims[0] = preprocessedFrame.rows;
-					dims[1] = preprocessedFrame.cols;
-					dims[2] = preprocessedFrame.channels();
-					typenum = NPY_UINT8;
-				}
+bool FirmwareManager::preprocessFrame(FramePacket& packet, IlluminationNormalizer& normalizer) {
+	ScopedLatency timer(LatencyStage::Preprocess);
 
-				PyObject* pArray = PyArray_SimpleNewFromData(nd, dims, typenum, preprocessedFrame.data);
-				if (pArray == nullptr) {
-					std::cerr << "Failed to create NumPy array" << std::endl;
-					Py_DECREF(pModule);
-					PyGILState_Release(gstate);
-					return false;
-				}
+	// 2. 얼굴 추적 중이면 얼굴 주변 ROI 만, 아니면 프레임 전체를 처리
+	cv::Rect fullFrame(cv::Point(), packet.frameSize);
+	packet.roi = faceTracker ? faceTracker->getSearchRoi(packet.frameSize) : fullFrame;
 
-				// 함수 인자 설정
-				float threshold = 0.25f;
-				PyObject* pThreshold = PyFloat_FromDouble(threshold);
-				PyObject* pArgs = PyTuple_New(2);
-				PyTuple_SetItem(pArgs, 0, pArray);
-				PyTuple_SetItem(pArgs, 1, pThreshold);
+	// 이미지 전처리 (축소 해상도 배경 추정 기반 조명 보정)
+	return normalizer.normalize(packet.buffers->frame(packet.roi), packet.preprocessedFrame);
+}
 
-				// 함수 호출
-				PyObject* pValue = PyObject_CallObject(pFunc, pArgs);
-				Py_DECREF(pArgs);
+void FirmwareManager::detectEyeClosure(FramePacket& packet) {
+	// 3. 눈 감음 판단 (시작 시 선택된 엔진 사용, 임계값은 운전자별 보정값)
+	float threshold = earCalibrator->getThreshold();
+	if (faceTracker) {
+		// 추적 중이면 예측된 얼굴 위치로 랜드마크만 검출, 아니면 ROI(또는 전체)에서 얼굴 검출
+		cv::Rect faceHint =
+				faceTracker->predictFaceRect(packet.preprocessedFrame, packet.roi, packet.frameSize);
+		packet.detection = eyeClosureDetector->detectInRoi(packet.preprocessedFrame, packet.roi,
+																											 packet.frameSize.width, faceHint, threshold);
+		if (!faceTracker->update(packet.detection, packet.preprocessedFrame, packet.roi,
+														 packet.frameSize, faceHint)) {
+			// 추적 실패 시 같은 프레임의 ROI 전체에서 예측 위치 없이 다시 검출
+			// (눈을 감은 채 고개를 끄덕이거나 잠깐 가려져도 감김 구간이 끊기지 않도록 함)
+			if (!faceHint.empty()) {
+				packet.detection = eyeClosureDetector->detectInRoi(
+						packet.preprocessedFrame, packet.roi, packet.frameSize.width, cv::Rect(), threshold);
+				faceTracker->update(packet.detection, packet.preprocessedFrame, packet.roi,
+														packet.frameSize, cv::Rect());
+			}
+			// ROI 에서도 얼굴을 못 찾으면 미검출로 기록하지 않고 건너뜀 (다음 프레임은 전체 검출)
+			// 전체 프레임에서 못 찾은 경우는 실제 미검출이므로 그대로 기록
+			if (!packet.detection.faceFound && packet.roi.size() != packet.frameSize) {
+				packet.detection = EyeClosureResult();
+				return;
+			}
+		}
+	} else {
+		packet.detection = eyeClosureDetector->detect(packet.preprocessedFrame, threshold);
+	}
+	recordEyeState(packet);
+}
 
-				if (pValue != nullptr) {
-					eyesClosed = PyObject_IsTrue(pValue);
-					Py_DECREF(pValue);
-				}
+void FirmwareManager::detectEyeClosures(std::vector<FramePacketPtr>& packets) {
+	ScopedLatency timer(LatencyStage::Detection);	// 배치 단위
 
-				Py_DECREF(pFunc);
-			}
-			Py_DECREF(pModule);
+	// ROI 추적은 프레임마다 이전 결과가 필요하므로 배치 판별은 추적을 쓰지 않는 경로에서만 사용
+	if (faceTracker || packets.size() == 1) {
+		for (auto& packet : packets) {
+			detectEyeClosure(*packet);
 		}
-	} catch (const std::exception& e) {
-		std::cerr << "Error during eye detection: " << e.what() << std::endl;
+		return;
 	}
-	PyGILState_Release(gstate);
 
-	std::cout << "눈 감음 상태: " << (eyesClosed ? "감김" : "열림") << std::endl;
+	batchFrames.clear();
+	for (const auto& packet : packets) {
+		batchFrames.push_back(packet->preprocessedFrame);
+	}
+	eyeClosureDetector->detectBatch(batchFrames, earCalibrator->getThreshold(), batchResults);
+	batchFrames.clear();	// 캡처 버퍼 참조를 바로 놓음
 
-	// 4. 눈 감음 상태 저장
-	eyeClosureQueue->saveEyeClosureStatus(eyesClosed);
+	for (size_t i = 0; i < packets.size(); ++i) {
+		packets[i]->detection = i < batchResults.size() ? batchResults[i] : EyeClosureResult();
+		recordEyeState(*packets[i]);
+	}
+}
 
-	// 5. 프레임 저장 (720p로 변환)
-	cv::Mat resizedFrame;
-	cv::resize(frame, resizedFrame, cv::Size(1280, 720));
+void FirmwareManager::recordEyeState(FramePacket& packet) {
+	bool eyesClosed = packet.detection.eyesClosed;
+	int64_t capturedAtMs = steadyMs(packet.capturedAtSteady);
 
-	// 현재 시간을 파일명으로 사용하여 최근 프레임 폴더에 저장
-	auto now = std::chrono::system_clock::now();
-	auto in_time_t = std::chrono::system_clock::to_time_t(now);
-	std::stringstream ss;
-	ss << std::put_time(std::localtime(&in_time_t), "%Y%m%d_%H%M%S");
-	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-	ss << '_' << std::setfill('0') << std::setw(3) << ms.count();
-	std::string timestamp = ss.str();
+	std::cout << "눈 감음 상태: " << (eyesClosed ? "감김" : "열림") << std::endl;
 
-	// 프레임 저장
-	bool result = utils->saveFrameToCurrentFrameFolder(resizedFrame, timestamp + ".jpg");
-	if (!result) {
-		std::cerr << "Error saving frame to current folder" << std::endl;
+	// 4. 눈 상태를 캡처 시각과 함께 저장 (프레임 드롭이 있어도 시간 기준으로 판별)
+	EyeStateSample sample;
+	sample.timestampMs = capturedAtMs;
+	sample.ear = packet.detection.ear;
+	sample.confidence = packet.detection.confidence;
+	sample.faceFound = packet.detection.faceFound;
+	sample.eyesClosed = eyesClosed;
+	eyeClosureQueue->saveEyeClosureStatus(sample);
+
+	// 운전자 EAR 분포 누적 (긴 감김/PERCLOS 상승/졸음 상태 중인 표본은 적응에서 제외)
+	EyeClosureStats eyes = eyeClosureQueue->getStats();
+	bool drowsySignal = eyes.closedRunMs >= CALIBRATION_FREEZE_CLOSED_RUN_MS ||
+											eyes.perclos >= CALIBRATION_FREEZE_PERCLOS || previousSleepy.load();
+	earCalibrator->addSample(capturedAtMs, packet.detection.ear, packet.detection.faceFound,
+													 drowsySignal);
+}
+
+bool FirmwareManager::persistFrame(const FramePacket& packet) {
+	ScopedLatency timer(LatencyStage::Persistence);
+
+	// 5. 프레임 저장 (720p 근거 영상 스트림을 JPEG 인코딩)
+	const cv::Size evidenceSize(1280, 720);
+	cv::Mat colorFrame;
+	const CaptureBuffers& buffers = *packet.buffers;
+	const cv::Mat* source = &buffers.frame;
+	if (!buffers.evidenceFrame.empty()) {
+		cv::cvtColor(buffers.evidenceFrame, colorFrame, cv::COLOR_YUV2BGR_NV12);
+		source = &colorFrame;
+	} else if (buffers.frame.channels() == 1) {
+		// 근거 영상 스트림 프레임을 놓침: 판별용 그레이 프레임을 확대해 넣으면 컬러 720p 와 섞이므로
+		// 이번 프레임은 건너뜀 (영상 PTS 는 캡처 시각 기준이라 빈 구간은 이전 프레임이 이어서 표시됨)
+		missingEvidenceCount.fetch_add(1, std::memory_order_relaxed);
 		return false;
 	}
 
-	if (utils->IsSavingSleepinessEvidence) {
-		// 졸음 근거 영상 저장
-		if (!utils->saveFrameToSleepinessFolder(resizedFrame, timestamp + ".jpg")) {
-			std::cerr << "Error saving sleepiness evidence frame" << std::endl;
-		}
+	// 파일 재생처럼 해상도가 다를 때만 리사이즈
+	cv::Mat resizedFrame;
+	if (source->size() == evidenceSize) {
+		resizedFrame = *source;
+	} else {
+		cv::resize(*source, resizedFrame, evidenceSize);
+	}
+
+	// 인코딩 버퍼는 저장 스레드만 사용하며, 링 버퍼 슬롯과 교환되며 재사용됨
+	int thermalQuality = thermalMonitor->getDegradation().jpegQuality;
+	evidenceEncodeParams[1] = thermalQuality > 0 ? thermalQuality : 95;
+	bool encoded;
+	{
+		ScopedLatency encodeTimer(LatencyStage::Encode);
+		encoded = cv::imencode(".jpg", resizedFrame, encodeBuffer, evidenceEncodeParams);
+	}
+	if (!encoded) {
+		std::cerr << "Error encoding frame" << std::endl;
+		return false;
+	}
 
-		// 졸음 근거 영상 카운트 증가
-		utils->sleepinessEvidenceCount++;
+	// 캡처 시각을 파일명으로 사용
+	std::string fileName = packet.timestamp + ".jpg";
+	int64_t capturedAtMs = steadyMs(packet.capturedAtSteady);
 
-		if (utils->sleepinessEvidenceCount >= utils->MAX_SLEEPINESS_EVIDENCE_COUNT) {
-			std::cout << "졸음 근거 영상 저장 완료" << std::endl;
-			utils->IsSavingSleepinessEvidence = false;
-			utils->sleepinessEvidenceCount = 0;
+	{
+		std::lock_guard<std::mutex> lock(detectionMutex);
+		// 졸음 감지 이후 프레임을 근거 영상용으로 복사 (SD 카드 기록 없음)
+		if (recordingEvidence) {
+			if (recordingEvidence->appendFrame(capturedAtMs, fileName, encodeBuffer)) {
+				std::cout << "졸음 근거 영상 저장 완료" << std::endl;
+			}
+			// 목표 개수를 채웠거나 DBThread 가 먼저 가져간 경우 수집 종료
+			if (recordingEvidence->isComplete()) {
+				recordingEvidence.reset();
+			}
 		}
 	}
 
-	// 6. AI 서버로 이미지 전송
-	sleepinessDetector->sendDriverFrame(preprocessedFrame);
+	// 최근 프레임 링 버퍼에 저장 (파일 시스템 접근 없음)
+	recentFrames->push(capturedAtMs, fileName, encodeBuffer);
 
 	return true;
 }
@@ -406,97 +832,94 @@ bool FirmwareManager::processSingleFrame() {
 void FirmwareManager::requestDiagnosis() {
 	std::cout << "Requesting sleepiness diagnosis (cycle " << diagnosticCycle << ")" << std::endl;
 
-	auto now = std::chrono::system_clock::now();
-	auto now_time_t = std::chrono::system_clock::to_time_t(now);
-	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+	// 서버용 시각 문자열은 벽시계, 근거 영상 구간 계산용 시각은 캡처 시각과 같은 steady_clock
+	std::string timestamp = makeTimestamp(std::chrono::system_clock::now());
+	int64_t requestedAtMs = steadyMs(std::chrono::steady_clock::now());
 
-	std::stringstream ss;
-	ss << std::put_time(std::localtime(&now_time_t), "%Y%m%d_%H%M%S");
-	ss << '_' << std::setfill('0') << std::setw(3) << ms.count();
-	std::string timestamp = ss.str();
-
-	// 별도 스레드에서 비동기 호출
-	std::thread([this, timestamp]() {
-		sleepinessDetector->requestAIDetection(
-				deviceUID, timestamp,
-				[this, timestamp](bool success, bool isDrowsy, const std::string& message) {
-					bool finalSleepy = false;
-
-					if (success) {
-						if (isDrowsy) {
-							std::cout << "AI 서버가 졸음으로 판단했습니다." << std::endl;
-							finalSleepy = true;
-						} else {
-							std::cout << "AI 서버 진단 결과: 졸음 아님 (" << message << ")" << std::endl;
-						}
-					} else {
-						std::cerr << "AI 서버 진단 실패: " << message << std::endl;
-						std::cout << "로컬 알고리즘으로 진단을 실시합니다." << std::endl;
-						std::lock_guard<std::mutex> lock(detectionMutex);
-						finalSleepy = sleepinessDetector->getLocalDetection(*eyeClosureQueue);
-						std::cout << "로컬 진단 호출 사이클" << diagnosticCycle << ": "
-											<< (finalSleepy ? "졸음 감지됨" : "졸음 아님") << std::endl;
-					}
-
-					if (finalSleepy) {
-						std::lock_guard<std::mutex> lock(detectionMutex);
-						handleSleepinessDetected(timestamp);
-					} else {
-						previousSleepy = false;
-
-						std::string sleepDir = utils->saveDirectory + sleepImgPathStack.top();
-						sleepImgPathStack.pop();
-
-						auto dbThread = std::make_shared<DBThread>(deviceUID, sleepDir, threadMonitor.get());
-						threadMonitor->addDBThread(dbThread);
-						threadMonitor->setIsDBThreadRunning(true);
-
-						while (!sleepImgPathStack.empty()) {
-							sleepImgPathStack.pop();
-						}
-					}
-					diagnosticCycle++;
-				});
-	}).detach();
-}
-
-void FirmwareManager::handleSleepinessDetected(const std::string& timestamp) {
+	// 이전 요청이 진행 중이면 새로 보내지 않음 (결과는 판별 스레드에서 pollDiagnosis 로 반영)
+	if (!diagnosisClient->request(timestamp, requestedAtMs)) {
+		std::cout << "이전 진단 요청 응답 대기 중, 이번 주기 요청 생략" << std::endl;
+	}
+}
+
+void FirmwareManager::pollDiagnosis() {
+	DiagnosisResult result;
+	while (diagnosisClient->poll(result)) {
+		applyDiagnosisResult(result);
+	}
+}
+
+void FirmwareManager::applyDiagnosisResult(const DiagnosisResult& result) {
+	bool finalSleepy = false;
+
+	if (result.success) {
+		if (result.isDrowsy) {
+			std::cout << "AI 서버가 졸음으로 판단했습니다." << std::endl;
+			finalSleepy = true;
+		} else {
+			std::cout << "AI 서버 진단 결과: 졸음 아님 (" << result.message << ")" << std::endl;
+		}
+	} else {
+		std::cerr << "AI 서버 진단 실패: " << result.message << std::endl;
+		std::cout << "로컬 알고리즘으로 진단을 실시합니다." << std::endl;
+		finalSleepy = sleepinessDetector->getLocalDetection(*eyeClosureQueue);
+		std::cout << "로컬 진단 호출 사이클" << diagnosticCycle << ": "
+							<< (finalSleepy ? "졸음 감지됨" : "졸음 아님") << std::endl;
+	}
+
+	if (finalSleepy) {
+		std::lock_guard<std::mutex> lock(detectionMutex);
+		handleSleepinessDetected(result.timestamp, result.requestedAtMs);
+	} else {
+		std::shared_ptr<SleepinessEvidence> evidence;
+		{
+			std::lock_guard<std::mutex> lock(detectionMutex);
+			previousSleepy = false;
+			evidence = std::move(pendingEvidence);
+			pendingEvidence.reset();
+		}
+
+		// 졸음 상태가 끝났으면 근거 영상 전송 (수집 중이면 DBThread 가 완료를 기다림)
+		if (evidence) {
+			auto dbThread = std::make_shared<DBThread>(deviceUID, evidence, threadMonitor.get());
+			threadMonitor->addDBThread(dbThread);
+			threadMonitor->setIsDBThreadRunning(true);
+		}
+	}
+	diagnosticCycle++;
+}
+
+void FirmwareManager::handleSleepinessDetected(const std::string& timestamp,
+																							 int64_t detectedAtMs) {
 	std::cout << "***** 졸음 감지! 알람 작동 *****" << std::endl;
 
 	// 1. 경고음 출력
 	speaker->triggerAlert();
 
-	// 이전 졸음 진단이 true일때, 이전 졸음 근거 영상 폴더를 삭제 후 현재 폴더로 변경
-	if (previousSleepy) {
-		std::cout << "이전 졸음 근거 영상 폴더 삭제" << std::endl;
-		utils->removeSleepinessEvidenceFolder();
-		sleepImgPathStack.pop();
+	// 이전 졸음 진단이 true일때, 이전 졸음 근거 영상을 버리고 현재 이벤트로 교체
+	if (previousSleepy && pendingEvidence) {
+		std::cout << "이전 졸음 근거 영상 폐기: " << pendingEvidence->getId() << std::endl;
+		pendingEvidence.reset();
 	}
 
-	std::string sleepDir = utils->createSleepinessDir(timestamp);
-	std::cout << "졸음 영상 저장 경로: " << sleepDir << std::endl;
-
-	// 3. 진단 시점부터 앞 2.5초 프레임 가져오기 (파일 경로와 파일명도 같이 가져오도록 수정 필요)
-	std::vector<std::pair<std::string, std::string>> recentFrames =
-			utils->getRecentFramePathsAndNames(timestamp);
-
-	// 4. 최근 프레임을 졸음 근거 영상 폴더에 원본 파일명으로 저장
-	for (const auto& [filePath, fileName] : recentFrames) {
-		// .frames/yyyyMMdd_HHmmss_fff/fimename.jpg 형태로 저장
-		std::string destPath = utils->saveDirectory + sleepDir + "/" + fileName;
-		try {
-			std::filesystem::copy_file(filePath, destPath,
-																 std::filesystem::copy_options::overwrite_existing);
-		} catch (const std::exception& e) {
-			std::cerr << "Error copying frame file: " << e.what() << std::endl;
-		}
+	// 아직 수집 중인 이전 이벤트는 지금까지 모은 프레임으로 마감 (전송 대기 중이면 그대로 전송)
+	if (recordingEvidence) {
+		recordingEvidence->markComplete();
 	}
 
-	utils->IsSavingSleepinessEvidence = true;
-	utils->sleepinessEvidenceCount = 0;
+	// 3. 진단 시점부터 앞 2.5초 프레임을 링 버퍼에서 가져오기 (디렉토리 탐색 없음)
+	std::vector<BufferedFrame> preEventFrames = recentFrames->snapshot(
+			detectedAtMs - RECENT_FRAME_WINDOW_MS, detectedAtMs, utils->MAX_SLEEPINESS_EVIDENCE_COUNT);
+	std::cout << "졸음 근거 영상: " << timestamp << " (감지 이전 프레임 " << preEventFrames.size()
+						<< "개)" << std::endl;
+
+	// 4. 감지 이전 프레임으로 근거 영상을 만들고, 이후 프레임은 저장 스레드가 이어서 채움
+	auto evidence = std::make_shared<SleepinessEvidence>(
+			timestamp, detectedAtMs, std::move(preEventFrames), utils->MAX_SLEEPINESS_EVIDENCE_COUNT);
 
-	// 5. 졸음 근거 영상 폴더 경로를 스택에 추가
-	sleepImgPathStack.push(sleepDir);
+	// 5. 졸음 상태가 끝나면 DBThread 로 넘길 근거 영상으로 보관
+	recordingEvidence = evidence;
+	pendingEvidence = evidence;
 
 	// 6. 이전 졸음 상태 업데이트
 	previousSleepy = true;
@@ -0,0 +1,74 @@
+#include "../include/FrameRingBuffer.h"
+
+#include <algorithm>
+
+FrameRingBuffer::FrameRingBuffer(size_t capacity, size_t reserveBytesPerFrame)
+		: slots(std::max<size_t>(1, capacity)), head(0), count(0) {
+	// 실행 중 재할당이 없도록 슬롯별 JPEG 버퍼 미리 확보
+	for (auto& slot : slots) {
+		slot.jpeg.reserve(reserveBytesPerFrame);
+		slot.name.reserve(32);
+	}
+}
+
+size_t FrameRingBuffer::slotIndex(size_t logicalIndex) const {
+	return (head + slots.size() - count + logicalIndex) % slots.size();
+}
+
+void FrameRingBuffer::push(int64_t timestampMs, const std::string& name, std::vector<uchar>& jpeg) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+
+	BufferedFrame& slot = slots[head];
+	slot.timestampMs = timestampMs;
+	slot.name = name;
+	slot.jpeg.swap(jpeg);
+
+	head = (head + 1) % slots.size();
+	if (count < slots.size()) {
+		count++;
+	}
+}
+
+std::vector<BufferedFrame> FrameRingBuffer::snapshot(int64_t fromMs, int64_t toMs,
+																										 size_t maxFrames) const {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+
+	// 프레임은 시간순으로 쌓이므로 논리 인덱스 기준 이진 탐색으로 구간 경계 계산
+	auto lowerBound = [this](int64_t timeMs) {
+		size_t low = 0;
+		size_t high = count;
+		while (low < high) {
+			size_t mid = low + (high - low) / 2;
+			if (slots[slotIndex(mid)].timestampMs < timeMs) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+		return low;
+	};
+
+	size_t begin = lowerBound(fromMs);
+	size_t end = toMs == INT64_MAX ? count : lowerBound(toMs + 1);
+	if (end > begin + maxFrames) {
+		begin = end - maxFrames;	// 최신 프레임 우선
+	}
+
+	std::vector<BufferedFrame> frames;
+	frames.reserve(end > begin ? end - begin : 0);
+	for (size_t i = begin; i < end; ++i) {
+		frames.push_back(slots[slotIndex(i)]);
+	}
+	return frames;
+}
+
+void FrameRingBuffer::clear() {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	head = 0;
+	count = 0;
+}
+
+size_t FrameRingBuffer::size() const {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	return count;
+}
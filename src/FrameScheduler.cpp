@@ -0,0 +1,109 @@
+#include "../include/FrameScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+FrameScheduler::FrameScheduler(std::chrono::nanoseconds interval)
+		: interval(interval),
+			originSlot(0),
+			nextSlot(0),
+			anchored(false),
+			tickCount(0),
+			skippedCount(0),
+			overrunCount(0),
+			jitterNext(0) {
+	jitterSamples.reserve(JITTER_SAMPLE_COUNT);
+	reset();
+}
+
+void FrameScheduler::reset() {
+	// 첫 슬롯은 바로 실행
+	origin = std::chrono::steady_clock::now();
+	originSlot = nextSlot;
+	anchored = false;
+}
+
+std::chrono::steady_clock::time_point FrameScheduler::deadlineOf(uint64_t slot) const {
+	// 누적 덧셈 대신 곱셈으로 계산해 오차가 쌓이지 않도록 함
+	return origin + interval * static_cast<int64_t>(slot - originSlot);
+}
+
+uint64_t FrameScheduler::waitNextSlot() {
+	uint64_t slot = nextSlot;
+	auto deadline = deadlineOf(slot);
+	auto now = std::chrono::steady_clock::now();
+
+	// 이미 다음 슬롯 시각도 지났으면 현재 시각 이후 첫 슬롯으로 건너뜀
+	if (now >= deadline + interval) {
+		uint64_t target = originSlot + static_cast<uint64_t>((now - origin) / interval) + 1;
+		skippedCount += target - slot;
+		overrunCount++;
+		slot = target;
+		deadline = deadlineOf(slot);
+	}
+
+	std::this_thread::sleep_until(deadline);
+
+	double jitterUs =
+			std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - deadline)
+					.count();
+	recordTick(slot, jitterUs);
+	return slot;
+}
+
+uint64_t FrameScheduler::frameArrived() {
+	auto now = std::chrono::steady_clock::now();
+	uint64_t slot = nextSlot;
+	double jitterUs = 0.0;
+
+	if (anchored) {
+		// 직전 프레임 이후 가장 가까운 주기 수만큼 슬롯을 진행 (반 주기 이내의 흔들림은 같은 슬롯으로 봄)
+		auto elapsed = now - origin;
+		uint64_t periods = static_cast<uint64_t>((elapsed + interval / 2) / interval);
+		if (periods > 1) {
+			skippedCount += periods - 1;
+			overrunCount++;
+			slot += periods - 1;
+		}
+		jitterUs = std::chrono::duration<double, std::micro>(
+									 elapsed - interval * static_cast<int64_t>(std::max<uint64_t>(periods, 1)))
+									 .count();
+	}
+
+	// 다음 프레임은 이번 도착 시각 기준으로 계산
+	origin = now;
+	originSlot = slot;
+	anchored = true;
+	recordTick(slot, jitterUs);
+	return slot;
+}
+
+void FrameScheduler::recordTick(uint64_t slot, double jitterUs) {
+	if (jitterSamples.size() < JITTER_SAMPLE_COUNT) {
+		jitterSamples.push_back(jitterUs);
+	} else {
+		jitterSamples[jitterNext] = jitterUs;
+	}
+	jitterNext = (jitterNext + 1) % JITTER_SAMPLE_COUNT;
+
+	tickCount++;
+	nextSlot = slot + 1;
+}
+
+FrameSchedulerStats FrameScheduler::getStats() const {
+	FrameSchedulerStats stats{tickCount, skippedCount, overrunCount, 0.0, 0.0, 0.0};
+	if (jitterSamples.empty()) {
+		return stats;
+	}
+
+	std::vector<double> sorted = jitterSamples;
+	std::sort(sorted.begin(), sorted.end());
+	auto at = [&sorted](double ratio) {
+		return sorted[std::min(static_cast<size_t>(ratio * (sorted.size() - 1) + 0.5),
+													 sorted.size() - 1)];
+	};
+	stats.jitterP50Us = at(0.50);
+	stats.jitterP99Us = at(0.99);
+	stats.jitterMaxUs = sorted.back();
+	return stats;
+}
@@ -0,0 +1,172 @@
+#include "../include/FrameUplink.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "../include/BackendClient.h"
+#include "../include/LatencyMetrics.h"
+
+namespace {
+int envInt(const char* name, int defaultValue) {
+	const char* value = std::getenv(name);
+	if (!value) {
+		return defaultValue;
+	}
+	try {
+		return std::stoi(value);
+	} catch (const std::exception&) {
+		return defaultValue;
+	}
+}
+}	 // namespace
+
+FrameUplink::FrameUplink(size_t batchSize, bool roiOnly, int jpegQuality,
+												 std::chrono::milliseconds maxBatchDelay)
+		: batchSize(std::max<size_t>(1, batchSize)),
+			roiOnly(roiOnly),
+			jpegQuality(std::clamp(jpegQuality, 10, 100)),
+			maxBatchDelay(maxBatchDelay),
+			initialized(false),
+			batch(this->batchSize),
+			batchCount(0),
+			encodeParams{cv::IMWRITE_JPEG_QUALITY, this->jpegQuality},
+			sentBatches(0),
+			sentFrames(0),
+			sentBytes(0),
+			failedBatches(0) {}
+
+FrameUplink::~FrameUplink() {
+	flush();
+}
+
+bool FrameUplink::roiOnlyFromEnvironment() {
+	return envInt("FRAME_UPLINK_ROI_ONLY", 0) != 0;
+}
+
+std::unique_ptr<FrameUplink> FrameUplink::fromEnvironment() {
+	const char* modeC = std::getenv("FRAME_UPLINK_MODE");
+	if (!modeC || std::string(modeC) != "batch") {
+		return nullptr;
+	}
+
+	bool roiOnly = roiOnlyFromEnvironment();
+	int batchSize = envInt("FRAME_UPLINK_BATCH_SIZE", 8);
+	// 얼굴 ROI 만 보낼 때는 화질을 더 낮춤 (판별에 필요한 눈 영역 해상도는 유지됨)
+	int quality = envInt("FRAME_UPLINK_JPEG_QUALITY", roiOnly ? 60 : 80);
+
+	auto uplink = std::make_unique<FrameUplink>(static_cast<size_t>(std::max(1, batchSize)), roiOnly,
+																							quality);
+	if (!uplink->initialize()) {
+		return nullptr;
+	}
+	std::cout << "프레임 배치 전송 사용: " << batchSize << "장/요청, JPEG 품질 " << quality
+						<< (roiOnly ? ", 얼굴 ROI 만 전송" : ", 전체 프레임 전송") << std::endl;
+	return uplink;
+}
+
+bool FrameUplink::initialize() {
+	BackendClient& client = BackendClient::getInstance();
+	if (!client.isConfigured(BackendServer::AiServer)) {
+		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
+		return false;
+	}
+
+	deviceUid = client.getDeviceUid();
+	initialized = true;
+	return true;
+}
+
+void FrameUplink::limitJpegQuality(int maxQuality) {
+	encodeParams[1] = maxQuality > 0 ? std::min(jpegQuality, std::max(10, maxQuality)) : jpegQuality;
+}
+
+void FrameUplink::addFrame(const cv::Mat& image, const cv::Rect& roi, uint64_t frameIndex,
+													 int64_t capturedAtMs) {
+	if (image.empty() || !initialized) {
+		return;
+	}
+
+	// 슬롯의 JPEG 버퍼를 재사용하여 인코딩
+	UplinkFrame& slot = batch[batchCount];
+	bool encoded;
+	{
+		ScopedLatency timer(LatencyStage::Encode);
+		encoded = cv::imencode(".jpg", image, slot.jpeg, encodeParams);
+	}
+	if (!encoded) {
+		std::cerr << "업링크 프레임 인코딩 실패" << std::endl;
+		return;
+	}
+	slot.frameIndex = frameIndex;
+	slot.capturedAtMs = capturedAtMs;
+	slot.roi = roi;
+
+	if (batchCount == 0) {
+		batchStartedAt = std::chrono::steady_clock::now();
+	}
+	batchCount++;
+
+	if (batchCount >= batchSize) {
+		flush();
+	} else {
+		flushIfDue();
+	}
+}
+
+void FrameUplink::flushIfDue() {
+	if (batchCount > 0 && std::chrono::steady_clock::now() - batchStartedAt >= maxBatchDelay) {
+		flush();
+	}
+}
+
+bool FrameUplink::flush() {
+	if (batchCount == 0 || !initialized) {
+		return true;
+	}
+
+	// 프레임 메타데이터 (순번, 캡처 시각, ROI 좌표)
+	nlohmann::json frames = nlohmann::json::array();
+	for (size_t i = 0; i < batchCount; ++i) {
+		const UplinkFrame& frame = batch[i];
+		nlohmann::json meta = {{"frameIdx", frame.frameIndex}, {"capturedAt", frame.capturedAtMs}};
+		if (!frame.roi.empty()) {
+			meta["roi"] = {frame.roi.x, frame.roi.y, frame.roi.width, frame.roi.height};
+		}
+		frames.push_back(meta);
+	}
+	nlohmann::json meta = {{"deviceUid", deviceUid}, {"frames", frames}};
+
+	// 이미지 파트는 JPEG 바이트를 그대로 사용 (base64/JSON 변환 없음)
+	cpr::Multipart multipart{{"meta", meta.dump(), "application/json"}};
+	size_t payloadBytes = 0;
+	for (size_t i = 0; i < batchCount; ++i) {
+		const UplinkFrame& frame = batch[i];
+		multipart.parts.emplace_back(
+				"driverFrame",
+				cpr::Buffer{frame.jpeg.begin(), frame.jpeg.end(), std::to_string(frame.frameIndex) + ".jpg"},
+				"image/jpeg");
+		payloadBytes += frame.jpeg.size();
+	}
+
+	cpr::Response r = BackendClient::getInstance().post(BackendEndpoints::DriverFrameBatch, multipart);
+
+	size_t frameCount = batchCount;
+	batchCount = 0;
+
+	if (r.error || r.status_code < 200 || r.status_code >= 300) {
+		// 실시간 스트림이므로 재전송하지 않고 다음 배치로 넘어감
+		uint64_t failures = failedBatches.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (failures % 20 == 1) {
+			std::cerr << "프레임 배치 전송 실패 (" << r.status_code << "): " << r.error.message
+								<< std::endl;
+		}
+		return false;
+	}
+
+	sentBatches.fetch_add(1, std::memory_order_relaxed);
+	sentFrames.fetch_add(frameCount, std::memory_order_relaxed);
+	sentBytes.fetch_add(payloadBytes, std::memory_order_relaxed);
+	return true;
+}
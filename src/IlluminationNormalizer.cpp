@@ -0,0 +1,152 @@
+#include "../include/IlluminationNormalizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// cv::COLOR_BGR2GRAY 와 동일한 고정소수점 계수 (합 = 1 << 14)
+const int GRAY_B = 1868;
+const int GRAY_G = 9617;
+const int GRAY_R = 4899;
+const int GRAY_SHIFT = 14;
+
+// sRGB(D65) 선형 RGB -> Y 계수 (OpenCV Lab 변환과 동일)
+const float Y_B = 0.072169f;
+const float Y_G = 0.715160f;
+const float Y_R = 0.212671f;
+
+// CIE L* 계산 (0~255 범위로 스케일, OpenCV 8비트 Lab 과 동일)
+inline uchar lightnessFromY(float y) {
+	float l = y > 0.008856f ? 116.0f * std::cbrt(y) - 16.0f : 903.3f * y;
+	return cv::saturate_cast<uchar>(l * 2.55f);
+}
+
+// 0.75 * gray + 0.25 * (255 - background) 를 정수 연산으로 계산 (반올림 포함)
+inline uchar blend(int gray, int background) {
+	return static_cast<uchar>((3 * gray + 255 - background + 2) >> 2);
+}
+}	 // namespace
+
+IlluminationNormalizer::IlluminationNormalizer(int medianKernelSize, int downscaleFactor)
+		: medianKernelSize(medianKernelSize), downscaleFactor(std::max(1, downscaleFactor)) {
+	for (int i = 0; i < 256; ++i) {
+		float v = i / 255.0f;
+		srgbToLinear[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+	}
+}
+
+int IlluminationNormalizer::kernelSizeForHeight(int frameHeight) {
+	int kernel = (REFERENCE_KERNEL_SIZE * frameHeight + REFERENCE_FRAME_HEIGHT / 2) /
+							 REFERENCE_FRAME_HEIGHT;
+	return std::max(3, kernel | 1);
+}
+
+void IlluminationNormalizer::computeLightness(const cv::Mat& image, cv::Mat& lightness) const {
+	// Lab 전체 변환 없이 L 채널만 계산
+	lightness.create(image.size(), CV_8UC1);
+
+	for (int y = 0; y < image.rows; ++y) {
+		uchar* dst = lightness.ptr<uchar>(y);
+
+		if (image.channels() == 1) {
+			const uchar* src = image.ptr<uchar>(y);
+			for (int x = 0; x < image.cols; ++x) {
+				dst[x] = lightnessFromY(srgbToLinear[src[x]]);
+			}
+		} else {
+			const uchar* src = image.ptr<uchar>(y);
+			const int step = image.channels();
+			for (int x = 0; x < image.cols; ++x, src += step) {
+				float luminance = Y_B * srgbToLinear[src[0]] + Y_G * srgbToLinear[src[1]] +
+													Y_R * srgbToLinear[src[2]];
+				dst[x] = lightnessFromY(luminance);
+			}
+		}
+	}
+}
+
+bool IlluminationNormalizer::normalize(const cv::Mat& frame, cv::Mat& output) {
+	if (frame.empty() || frame.depth() != CV_8U) {
+		std::cerr << "Error: IlluminationNormalizer expects a non-empty 8-bit frame" << std::endl;
+		return false;
+	}
+
+	try {
+		// 1. 축소 해상도에서 L 채널 계산
+		cv::Size smallSize(std::max(1, frame.cols / downscaleFactor),
+											 std::max(1, frame.rows / downscaleFactor));
+		cv::resize(frame, smallFrame, smallSize, 0, 0, cv::INTER_AREA);
+		computeLightness(smallFrame, smallLightness);
+
+		// 2. 축소 비율에 맞춘 커널로 미디안 필터 (8비트 큰 커널은 히스토그램 기반 O(1) 구현 사용)
+		int kernel = std::max(3, (medianKernelSize / downscaleFactor) | 1);
+		kernel = std::min(kernel, (std::min(smallSize.width, smallSize.height) - 1) | 1);
+		if (kernel >= 3) {
+			cv::medianBlur(smallLightness, smallBackground, kernel);
+		} else {
+			smallBackground = smallLightness;
+		}
+
+		// 3. 원본 해상도로 업샘플링
+		cv::resize(smallBackground, background, frame.size(), 0, 0, cv::INTER_LINEAR);
+
+		// 4. 그레이스케일 변환 + 배경 반전 + 가중 합성을 한 번의 순회로 처리
+		output.create(frame.size(), CV_8UC1);
+		for (int y = 0; y < frame.rows; ++y) {
+			const uchar* bg = background.ptr<uchar>(y);
+			uchar* dst = output.ptr<uchar>(y);
+
+			if (frame.channels() == 1) {
+				const uchar* src = frame.ptr<uchar>(y);
+				for (int x = 0; x < frame.cols; ++x) {
+					dst[x] = blend(src[x], bg[x]);
+				}
+			} else {
+				const uchar* src = frame.ptr<uchar>(y);
+				const int step = frame.channels();
+				for (int x = 0; x < frame.cols; ++x, src += step) {
+					int gray = (GRAY_B * src[0] + GRAY_G * src[1] + GRAY_R * src[2] +
+											(1 << (GRAY_SHIFT - 1))) >>
+										 GRAY_SHIFT;
+					dst[x] = blend(gray, bg[x]);
+				}
+			}
+		}
+	} catch (const cv::Exception& e) {
+		std::cerr << "OpenCV error during preprocessing: " << e.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool IlluminationNormalizer::normalizeReference(const cv::Mat& frame, cv::Mat& output,
+																								int medianKernelSize) {
+	try {
+		// LAB 변환 및 L 채널 추출
+		cv::Mat lab;
+		cv::cvtColor(frame, lab, cv::COLOR_BGR2Lab);
+		std::vector<cv::Mat> labChannels(3);
+		cv::split(lab, labChannels);
+		cv::Mat lChannel = labChannels[0].clone();
+
+		// 미디안 필터 적용
+		cv::Mat medianL;
+		cv::medianBlur(lChannel, medianL, medianKernelSize);
+
+		// L 채널 반전
+		cv::Mat invertedL;
+		cv::bitwise_not(medianL, invertedL);
+
+		// 그레이스케일과 반전된 L 채널 합성
+		cv::Mat gray;
+		cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+		cv::addWeighted(gray, 0.75, invertedL, 0.25, 0, output);
+	} catch (const cv::Exception& e) {
+		std::cerr << "OpenCV error during preprocessing: " << e.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,232 @@
+#include "../include/LatencyMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// 스레드별 샤드 핸들 (스레드 종료 시 샤드를 반납해 다음 스레드가 재사용)
+struct LatencyShardHandle {
+	LatencyMetrics::Shard* shard = nullptr;
+	~LatencyShardHandle() {
+		if (shard) {
+			LatencyMetrics::getInstance().releaseShard(shard);
+		}
+	}
+};
+
+namespace {
+thread_local LatencyShardHandle currentShard;
+
+// Prometheus 버킷 경계로 내보낼 범위 (256us ~ 약 16.8초, 2 배 구간마다 1x/1.5x 경계)
+const int EXPORT_FIRST_OCTAVE = 6;
+const int EXPORT_LAST_OCTAVE = 22;
+
+// 버킷 한 칸을 증가 (샤드는 한 스레드만 기록하므로 RMW 불필요)
+inline void increment(std::atomic<uint64_t>& counter, uint64_t amount) {
+	counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+}	 // namespace
+
+LatencyMetrics& LatencyMetrics::getInstance() {
+	static LatencyMetrics instance;
+	return instance;
+}
+
+int LatencyMetrics::bucketIndex(uint64_t durationUs) {
+	if (durationUs < static_cast<uint64_t>(SUB_BUCKETS)) {
+		return static_cast<int>(durationUs);
+	}
+	// 최상위 비트 위치로 2 배 구간을 찾고, 그 아래 3 비트로 구간 내 8 등분 위치를 정함
+	int msb = 63 - __builtin_clzll(durationUs);
+	int sub = static_cast<int>((durationUs >> (msb - 3)) & (SUB_BUCKETS - 1));
+	int index = (msb - 2) * SUB_BUCKETS + sub;
+	return std::min(index, BUCKET_COUNT - 1);
+}
+
+uint64_t LatencyMetrics::bucketLowerUs(int index) {
+	if (index < SUB_BUCKETS) {
+		return static_cast<uint64_t>(index);
+	}
+	int octave = index / SUB_BUCKETS;
+	uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS);
+	return (SUB_BUCKETS + sub) << (octave - 1);
+}
+
+LatencyMetrics::Shard* LatencyMetrics::acquireShard() {
+	std::lock_guard<std::mutex> lock(shardMutex);
+	for (auto& shard : shards) {
+		if (!shard->inUse.load(std::memory_order_relaxed)) {
+			shard->inUse.store(true, std::memory_order_relaxed);
+			return shard.get();
+		}
+	}
+	shards.push_back(std::make_unique<Shard>());
+	shards.back()->inUse.store(true, std::memory_order_relaxed);
+	return shards.back().get();
+}
+
+void LatencyMetrics::releaseShard(Shard* shard) {
+	// 잠금으로 이전 스레드의 기록이 다음 소유 스레드보다 먼저 보이도록 함
+	std::lock_guard<std::mutex> lock(shardMutex);
+	shard->inUse.store(false, std::memory_order_relaxed);
+}
+
+void LatencyMetrics::record(LatencyStage stage, int64_t durationUs) {
+	if (!currentShard.shard) {
+		currentShard.shard = acquireShard();
+	}
+	Shard& shard = *currentShard.shard;
+	int s = static_cast<int>(stage);
+	uint64_t value = static_cast<uint64_t>(std::max<int64_t>(0, durationUs));
+
+	increment(shard.buckets[s][bucketIndex(value)], 1);
+	increment(shard.sumUs[s], value);
+	if (value > shard.maxUs[s].load(std::memory_order_relaxed)) {
+		shard.maxUs[s].store(value, std::memory_order_relaxed);
+	}
+}
+
+LatencyMetrics::Snapshot LatencyMetrics::snapshot(LatencyStage stage) const {
+	int s = static_cast<int>(stage);
+	Snapshot result;
+	std::lock_guard<std::mutex> lock(shardMutex);
+	for (const auto& shard : shards) {
+		for (int i = 0; i < BUCKET_COUNT; ++i) {
+			uint64_t count = shard->buckets[s][i].load(std::memory_order_relaxed);
+			result.buckets[i] += count;
+			result.count += count;
+		}
+		result.sumUs += shard->sumUs[s].load(std::memory_order_relaxed);
+		result.maxUs = std::max(result.maxUs, shard->maxUs[s].load(std::memory_order_relaxed));
+	}
+	return result;
+}
+
+LatencySummary LatencyMetrics::summarize(const Snapshot& snapshot) {
+	LatencySummary summary{snapshot.count, 0.0, 0.0, 0.0, 0.0, snapshot.maxUs / 1000.0};
+	if (snapshot.count == 0) {
+		return summary;
+	}
+	summary.meanMs = static_cast<double>(snapshot.sumUs) / snapshot.count / 1000.0;
+
+	// 순위가 속한 버킷의 중앙값 (최댓값을 넘지 않도록 제한)
+	auto at = [&snapshot](double ratio) {
+		uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(ratio * snapshot.count)));
+		uint64_t cumulative = 0;
+		for (int i = 0; i < BUCKET_COUNT; ++i) {
+			cumulative += snapshot.buckets[i];
+			if (cumulative >= rank) {
+				double lower = static_cast<double>(bucketLowerUs(i));
+				double upper = i + 1 < BUCKET_COUNT ? static_cast<double>(bucketLowerUs(i + 1)) : lower;
+				double middle = (lower + upper - 1.0) / 2.0;
+				return std::min(middle, static_cast<double>(snapshot.maxUs)) / 1000.0;
+			}
+		}
+		return snapshot.maxUs / 1000.0;
+	};
+	summary.p50Ms = at(0.50);
+	summary.p90Ms = at(0.90);
+	summary.p99Ms = at(0.99);
+	return summary;
+}
+
+LatencySummary LatencyMetrics::getSummary(LatencyStage stage) const {
+	return summarize(snapshot(stage));
+}
+
+std::string LatencyMetrics::renderPrometheus() const {
+	std::ostringstream histogram;
+	std::ostringstream quantiles;
+	histogram << "# HELP nosleep_stage_latency_seconds Pipeline stage latency.\n"
+						<< "# TYPE nosleep_stage_latency_seconds histogram\n";
+	quantiles << "# HELP nosleep_stage_latency_quantile_seconds Stage latency quantiles since start.\n"
+						<< "# TYPE nosleep_stage_latency_quantile_seconds gauge\n";
+
+	for (int s = 0; s < STAGE_COUNT; ++s) {
+		LatencyStage stage = static_cast<LatencyStage>(s);
+		Snapshot data = snapshot(stage);
+		std::string label = std::string("stage=\"") + stageName(stage) + "\"";
+
+		// 경계 값보다 작은 버킷까지의 누적 개수
+		int next = 0;
+		uint64_t cumulative = 0;
+		for (int octave = EXPORT_FIRST_OCTAVE; octave <= EXPORT_LAST_OCTAVE; ++octave) {
+			for (int sub : {0, SUB_BUCKETS / 2}) {
+				int boundary = octave * SUB_BUCKETS + sub;
+				for (; next < boundary; ++next) {
+					cumulative += data.buckets[next];
+				}
+				// 경계는 정수 마이크로초이므로 소수점 6 자리로 정확히 표기
+				histogram << "nosleep_stage_latency_seconds_bucket{" << label << ",le=\"" << std::fixed
+									<< std::setprecision(6) << bucketLowerUs(boundary) / 1e6 << std::defaultfloat
+									<< "\"} " << cumulative << "\n";
+			}
+		}
+		histogram << "nosleep_stage_latency_seconds_bucket{" << label << ",le=\"+Inf\"} " << data.count
+							<< "\n"
+							<< "nosleep_stage_latency_seconds_sum{" << label << "} " << data.sumUs / 1e6 << "\n"
+							<< "nosleep_stage_latency_seconds_count{" << label << "} " << data.count << "\n";
+
+		LatencySummary summary = summarize(data);
+		quantiles << "nosleep_stage_latency_quantile_seconds{" << label << ",quantile=\"0.5\"} "
+							<< summary.p50Ms / 1000.0 << "\n"
+							<< "nosleep_stage_latency_quantile_seconds{" << label << ",quantile=\"0.9\"} "
+							<< summary.p90Ms / 1000.0 << "\n"
+							<< "nosleep_stage_latency_quantile_seconds{" << label << ",quantile=\"0.99\"} "
+							<< summary.p99Ms / 1000.0 << "\n";
+	}
+	return histogram.str() + quantiles.str();
+}
+
+const char* LatencyMetrics::stageName(LatencyStage stage) {
+	switch (stage) {
+		case LatencyStage::Capture:
+			return "capture";
+		case LatencyStage::Preprocess:
+			return "preprocess";
+		case LatencyStage::Detection:
+			return "detection";
+		case LatencyStage::FrameTotal:
+			return "frame_total";
+		case LatencyStage::Persistence:
+			return "persistence";
+		case LatencyStage::Encode:
+			return "encode";
+		case LatencyStage::VideoEncode:
+			return "video_encode";
+		case LatencyStage::Upload:
+			return "upload";
+		case LatencyStage::Diagnosis:
+			return "diagnosis";
+		default:
+			return "unknown";
+	}
+}
+
+void LatencyMetrics::reset() {
+	std::lock_guard<std::mutex> lock(shardMutex);
+	for (auto& shard : shards) {
+		for (int s = 0; s < STAGE_COUNT; ++s) {
+			for (auto& bucket : shard->buckets[s]) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+			shard->sumUs[s].store(0, std::memory_order_relaxed);
+			shard->maxUs[s].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+void LatencyMetrics::logStats() const {
+	std::cout << "[Latency] p50/p99 ms";
+	for (int s = 0; s < STAGE_COUNT; ++s) {
+		LatencyStage stage = static_cast<LatencyStage>(s);
+		LatencySummary summary = getSummary(stage);
+		if (summary.count == 0) {
+			continue;
+		}
+		std::cout << " | " << stageName(stage) << " " << summary.p50Ms << "/" << summary.p99Ms;
+	}
+	std::cout << std::endl;
+}
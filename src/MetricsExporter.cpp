@@ -0,0 +1,191 @@
+#include "../include/MetricsExporter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "../include/LatencyMetrics.h"
+
+namespace {
+const char* const CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+bool sendAll(int fd, const std::string& data) {
+	size_t sent = 0;
+	while (sent < data.size()) {
+		ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		sent += static_cast<size_t>(n);
+	}
+	return true;
+}
+}	 // namespace
+
+MetricsExporter::MetricsExporter(int port, const std::string& filePath,
+																 std::chrono::milliseconds fileInterval)
+		: port(port),
+			filePath(filePath),
+			fileInterval(std::max(fileInterval, std::chrono::milliseconds(1000))),
+			listenFd(-1),
+			terminate(false),
+			servedRequests(0),
+			fileWrites(0) {}
+
+MetricsExporter::~MetricsExporter() {
+	stop();
+}
+
+std::unique_ptr<MetricsExporter> MetricsExporter::fromEnvironment() {
+	const char* portC = std::getenv("METRICS_PORT");
+	const char* fileC = std::getenv("METRICS_FILE");
+	const char* intervalC = std::getenv("METRICS_FILE_INTERVAL_MS");
+
+	int port = portC ? std::atoi(portC) : 0;
+	std::string filePath = fileC ? fileC : "";
+	if (port <= 0 && filePath.empty()) {
+		return nullptr;
+	}
+	long intervalMs = intervalC ? std::atol(intervalC) : 10000;
+
+	std::cout << "지연 지표 내보내기:";
+	if (port > 0) {
+		std::cout << " http://127.0.0.1:" << port << "/metrics";
+	}
+	if (!filePath.empty()) {
+		std::cout << " " << filePath << " (" << intervalMs << "ms)";
+	}
+	std::cout << std::endl;
+	return std::make_unique<MetricsExporter>(port, filePath, std::chrono::milliseconds(intervalMs));
+}
+
+bool MetricsExporter::openListener() {
+	listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listenFd < 0) {
+		std::cerr << "지표 소켓 생성 실패: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+	int reuse = 1;
+	::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	// 차량 내부 수집기만 접근하도록 루프백에만 바인드
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+			::listen(listenFd, 4) < 0) {
+		std::cerr << "지표 포트 " << port << " 열기 실패: " << std::strerror(errno) << std::endl;
+		::close(listenFd);
+		listenFd = -1;
+		return false;
+	}
+	return true;
+}
+
+bool MetricsExporter::start() {
+	if (exporterThread.joinable()) {
+		return true;
+	}
+	// 포트를 열지 못해도 파일 기록은 계속
+	bool listening = port <= 0 || openListener();
+	terminate.store(false);
+	exporterThread = std::thread(&MetricsExporter::exporterLoop, this);
+	return listening;
+}
+
+void MetricsExporter::stop() {
+	terminate.store(true);
+	if (exporterThread.joinable()) {
+		exporterThread.join();
+	}
+	if (listenFd >= 0) {
+		::close(listenFd);
+		listenFd = -1;
+	}
+}
+
+void MetricsExporter::exporterLoop() {
+	auto nextWrite = std::chrono::steady_clock::now();
+	while (!terminate.load()) {
+		auto now = std::chrono::steady_clock::now();
+		if (!filePath.empty() && now >= nextWrite) {
+			writeFile();
+			nextWrite = now + fileInterval;
+		}
+
+		// 정지 요청을 확인할 수 있도록 짧게 대기
+		int waitMs = 200;
+		if (listenFd < 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+			continue;
+		}
+		pollfd listener{listenFd, POLLIN, 0};
+		if (::poll(&listener, 1, waitMs) > 0 && (listener.revents & POLLIN)) {
+			int clientFd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (clientFd >= 0) {
+				serveClient(clientFd);
+				::close(clientFd);
+			}
+		}
+	}
+
+	// 종료 직전 값도 남김
+	if (!filePath.empty()) {
+		writeFile();
+	}
+}
+
+void MetricsExporter::serveClient(int clientFd) {
+	// 요청 줄만 확인 (수집기 요청은 작으므로 한 번에 읽고, 느린 클라이언트는 1초 뒤 포기)
+	timeval timeout{1, 0};
+	::setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	char request[1024];
+	ssize_t n = ::recv(clientFd, request, sizeof(request) - 1, 0);
+	if (n <= 0) {
+		return;
+	}
+	request[n] = '\0';
+
+	std::string line(request, strcspn(request, "\r\n"));
+	bool metricsPath = line.rfind("GET /metrics ", 0) == 0 || line.rfind("GET / ", 0) == 0;
+	std::string body = metricsPath ? LatencyMetrics::getInstance().renderPrometheus() : "not found\n";
+	std::string response = std::string("HTTP/1.1 ") + (metricsPath ? "200 OK" : "404 Not Found") +
+												 "\r\nContent-Type: " + CONTENT_TYPE +
+												 "\r\nContent-Length: " + std::to_string(body.size()) +
+												 "\r\nConnection: close\r\n\r\n" + body;
+	if (sendAll(clientFd, response) && metricsPath) {
+		servedRequests.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool MetricsExporter::writeFile() const {
+	std::string temporaryPath = filePath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::trunc);
+		if (!file || !(file << LatencyMetrics::getInstance().renderPrometheus())) {
+			std::cerr << "지표 파일 기록 실패: " << temporaryPath << std::endl;
+			return false;
+		}
+	}
+	if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0) {
+		std::cerr << "지표 파일 교체 실패: " << filePath << std::endl;
+		return false;
+	}
+	fileWrites.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
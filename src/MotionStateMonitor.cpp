@@ -0,0 +1,230 @@
+#include "../include/MotionStateMonitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+int envInt(const char* name, int defaultValue) {
+	const char* value = std::getenv(name);
+	if (!value) {
+		return defaultValue;
+	}
+	try {
+		return std::stoi(value);
+	} catch (const std::exception&) {
+		return defaultValue;
+	}
+}
+
+float envFloat(const char* name, float defaultValue) {
+	const char* value = std::getenv(name);
+	if (!value) {
+		return defaultValue;
+	}
+	try {
+		return std::stof(value);
+	} catch (const std::exception&) {
+		return defaultValue;
+	}
+}
+
+// 샘플 간격에 맞춘 지수 평활 계수
+float smoothingFactor(float dtMs, float tauMs) {
+	return tauMs <= 0.0f ? 1.0f : 1.0f - std::exp(-dtMs / tauMs);
+}
+}	 // namespace
+
+MotionStateFilter::MotionStateFilter(const MotionFilterConfig& config) : config(config) {
+	reset();
+}
+
+void MotionStateFilter::reset() {
+	initialized = false;
+	moving = config.initiallyMoving;
+	magnitude = 0.0f;
+	variance = 0.0f;
+	lastTimestampUs = 0;
+	candidateSinceUs = -1;
+	transitions = 0;
+}
+
+bool MotionStateFilter::update(const AccelerationSample& sample) {
+	float current = std::sqrt(sample.x * sample.x + sample.y * sample.y + sample.z * sample.z);
+
+	if (!initialized) {
+		magnitude = current;
+		variance = 0.0f;
+		initialized = true;
+	} else {
+		// 시간이 거꾸로 가거나 오래 끊긴 경우에도 계수가 1 을 넘지 않도록 제한
+		float dtMs = std::min(1000.0f, std::max(0.0f, (sample.timestampUs - lastTimestampUs) / 1000.0f));
+		float alpha = smoothingFactor(dtMs, config.varianceTauMs);
+		float deviation = std::min(config.maxDeviation, std::fabs(current - magnitude));
+		magnitude += alpha * (current - magnitude);
+		variance += alpha * (deviation * deviation - variance);
+	}
+	lastTimestampUs = sample.timestampUs;
+
+	bool towardMoving = sample.activity || variance >= config.movingVariance;
+	bool towardStopped = !sample.activity && variance <= config.stoppedVariance;
+	if (!(moving ? towardStopped : towardMoving)) {
+		candidateSinceUs = -1;
+		return moving;
+	}
+
+	if (candidateSinceUs < 0) {
+		candidateSinceUs = sample.timestampUs;
+	}
+	int64_t holdMs = moving ? config.stoppedHoldMs : config.movingHoldMs;
+	if (sample.timestampUs - candidateSinceUs >= holdMs * 1000) {
+		moving = !moving;
+		transitions++;
+		candidateSinceUs = -1;
+	}
+	return moving;
+}
+
+MotionStateMonitor::MotionStateMonitor(AccelerationSensor& sensor, const MotionFilterConfig& config)
+		: sensor(sensor),
+			config(config),
+			filter(config),
+			history(new HistorySlot[HISTORY_CAPACITY]),
+			written(0),
+			moving(config.initiallyMoving),
+			magnitude(0.0f),
+			variance(0.0f),
+			sampleCount(0),
+			transitionCount(0),
+			emptyPollCount(0),
+			terminate(false) {}
+
+MotionStateMonitor::~MotionStateMonitor() {
+	stop();
+}
+
+std::unique_ptr<MotionStateMonitor> MotionStateMonitor::fromEnvironment(AccelerationSensor& sensor) {
+	MotionFilterConfig config;
+	config.sampleRateHz = std::max(1, envInt("MOTION_SAMPLE_RATE_HZ", config.sampleRateHz));
+	config.movingVariance = envFloat("MOTION_MOVING_VARIANCE", config.movingVariance);
+	config.stoppedVariance =
+			std::min(config.movingVariance, envFloat("MOTION_STOPPED_VARIANCE", config.stoppedVariance));
+	config.movingHoldMs = std::max(0, envInt("MOTION_MOVING_HOLD_MS", config.movingHoldMs));
+	config.stoppedHoldMs = std::max(0, envInt("MOTION_STOPPED_HOLD_MS", config.stoppedHoldMs));
+
+	std::cout << "움직임 판정: " << config.sampleRateHz << "Hz, 분산 " << config.stoppedVariance
+						<< "~" << config.movingVariance << ", 전환 유지 " << config.movingHoldMs << "/"
+						<< config.stoppedHoldMs << "ms" << std::endl;
+	return std::make_unique<MotionStateMonitor>(sensor, config);
+}
+
+void MotionStateMonitor::start() {
+	if (samplerThread.joinable()) {
+		return;
+	}
+	filter.reset();
+	moving.store(config.initiallyMoving, std::memory_order_release);
+	terminate.store(false);
+	samplerThread = std::thread(&MotionStateMonitor::samplerLoop, this);
+}
+
+void MotionStateMonitor::stop() {
+	terminate.store(true);
+	if (samplerThread.joinable()) {
+		samplerThread.join();
+	}
+}
+
+void MotionStateMonitor::samplerLoop() {
+	const auto period = std::chrono::microseconds(1000000 / config.sampleRateHz);
+	auto nextPoll = std::chrono::steady_clock::now();
+	AccelerationSample batch[READ_BATCH];
+
+	while (!terminate.load()) {
+		size_t count = sensor.readSamples(batch, READ_BATCH);
+		if (count == 0) {
+			emptyPollCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		for (size_t i = 0; i < count; ++i) {
+			filter.update(batch[i]);
+			appendHistory(batch[i]);
+		}
+
+		if (count > 0) {
+			magnitude.store(filter.getMagnitude(), std::memory_order_relaxed);
+			variance.store(filter.getVariance(), std::memory_order_relaxed);
+			sampleCount.fetch_add(count, std::memory_order_relaxed);
+			if (filter.isMoving() != moving.load(std::memory_order_relaxed)) {
+				transitionCount.fetch_add(1, std::memory_order_relaxed);
+				std::cout << "차량 상태 전환: " << (filter.isMoving() ? "주행" : "정차") << " (분산 "
+									<< filter.getVariance() << ")" << std::endl;
+				moving.store(filter.isMoving(), std::memory_order_release);
+			}
+		}
+
+		// 절대 시각 기준으로 폴링, 한 주기 이상 밀리면 현재 시각부터 다시 맞춤
+		nextPoll += period;
+		auto now = std::chrono::steady_clock::now();
+		if (now > nextPoll + period) {
+			nextPoll = now;
+		}
+		std::this_thread::sleep_until(nextPoll);
+	}
+}
+
+void MotionStateMonitor::appendHistory(const AccelerationSample& sample) {
+	uint64_t index = written.load(std::memory_order_relaxed);
+	HistorySlot& slot = history[index % HISTORY_CAPACITY];
+
+	// 값 기록은 release 로 홀수 시퀀스 뒤에 오도록 하여, 새 값을 본 독자는 바뀐 시퀀스도 보게 됨
+	slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+	slot.timestampUs.store(sample.timestampUs, std::memory_order_release);
+	slot.x.store(sample.x, std::memory_order_release);
+	slot.y.store(sample.y, std::memory_order_release);
+	slot.z.store(sample.z, std::memory_order_release);
+	slot.activity.store(sample.activity, std::memory_order_release);
+	slot.sequence.store(2 * (index + 1), std::memory_order_release);
+	written.store(index + 1, std::memory_order_release);
+}
+
+size_t MotionStateMonitor::getRecentSamples(AccelerationSample* samples, size_t capacity) const {
+	uint64_t end = written.load(std::memory_order_acquire);
+	uint64_t available = std::min<uint64_t>(end, HISTORY_CAPACITY);
+	uint64_t begin = end - std::min<uint64_t>(available, capacity);
+
+	size_t count = 0;
+	for (uint64_t index = begin; index < end; ++index) {
+		const HistorySlot& slot = history[index % HISTORY_CAPACITY];
+		uint64_t before = slot.sequence.load(std::memory_order_acquire);
+		AccelerationSample sample;
+		sample.timestampUs = slot.timestampUs.load(std::memory_order_acquire);
+		sample.x = slot.x.load(std::memory_order_acquire);
+		sample.y = slot.y.load(std::memory_order_acquire);
+		sample.z = slot.z.load(std::memory_order_acquire);
+		sample.activity = slot.activity.load(std::memory_order_acquire);
+		uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+		// 읽는 동안 기록자가 한 바퀴 돌아 덮어쓴 슬롯은 버림
+		if (before != 2 * (index + 1) || after != before) {
+			continue;
+		}
+		samples[count++] = sample;
+	}
+	return count;
+}
+
+MotionStats MotionStateMonitor::getStats() const {
+	return MotionStats{moving.load(),				 magnitude.load(),			 variance.load(),
+										 sampleCount.load(),	 transitionCount.load(), emptyPollCount.load()};
+}
+
+void MotionStateMonitor::logStats() const {
+	MotionStats stats = getStats();
+	std::cout << "[Motion] " << (stats.moving ? "moving" : "stopped") << ", samples " << stats.samples
+						<< ", transitions " << stats.transitions << ", empty-poll " << stats.emptyPolls
+						<< " | magnitude " << stats.magnitude << " m/s^2, variance " << stats.variance
+						<< std::endl;
+}
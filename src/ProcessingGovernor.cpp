@@ -0,0 +1,141 @@
+#include "../include/ProcessingGovernor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+ProcessingGovernor::ProcessingGovernor(const GovernorConfig& config, bool enabled)
+		: config(config),
+			enabled(enabled),
+			mode(static_cast<int>(enabled ? ProcessingMode::Normal : ProcessingMode::Alert)),
+			alertUntilMs(0),
+			steadySinceMs(-1),
+			lastEvaluatedMs(0),
+			modeChanges(0),
+			alertTriggers(0) {
+	for (auto& time : modeTimeMs) {
+		time.store(0);
+	}
+}
+
+std::unique_ptr<ProcessingGovernor> ProcessingGovernor::fromEnvironment() {
+	const char* enabledC = std::getenv("PROCESSING_GOVERNOR");
+	bool enabled = !(enabledC && std::string(enabledC) == "0");
+	if (!enabled) {
+		std::cout << "처리 모드 조정 사용 안 함: 모든 프레임을 최대 해상도로 처리" << std::endl;
+	}
+	return std::make_unique<ProcessingGovernor>(GovernorConfig(), enabled);
+}
+
+ProcessingMode ProcessingGovernor::evaluate(const GovernorInputs& inputs) {
+	ProcessingMode current = getMode();
+	if (!enabled) {
+		return current;
+	}
+
+	// 직전 평가 이후 시간은 그동안 유지된 모드에 누적
+	if (lastEvaluatedMs > 0 && inputs.nowMs > lastEvaluatedMs) {
+		modeTimeMs[static_cast<int>(current)].fetch_add(inputs.nowMs - lastEvaluatedMs,
+																										std::memory_order_relaxed);
+	}
+	lastEvaluatedMs = inputs.nowMs;
+
+	// EAR 이 임계값보다 얼마나 위에 있는지 (임계값 대비 비율)
+	bool earKnown = inputs.recentEar >= 0.0f && inputs.earThreshold > 0.0f;
+	float earMargin = earKnown ? (inputs.recentEar - inputs.earThreshold) / inputs.earThreshold : 0.0f;
+
+	bool closing = inputs.closedRunMs >= config.alertClosedRunMs ||
+								 inputs.perclos >= config.alertPerclos ||
+								 (earKnown && earMargin < config.alertEarMargin);
+	if (closing) {
+		if (inputs.nowMs >= alertUntilMs) {
+			alertTriggers.fetch_add(1, std::memory_order_relaxed);
+		}
+		alertUntilMs = inputs.nowMs + config.alertHoldMs;
+	}
+
+	// 평소 깜빡임은 안정 구간을 끊지 않음, 정차 후 다시 출발하면 처음부터 다시 셈
+	bool steady = inputs.moving && earKnown && earMargin >= config.steadyEarMargin &&
+								inputs.perclos < config.alertPerclos / 2;
+	if (!steady) {
+		steadySinceMs = -1;
+	} else if (steadySinceMs < 0) {
+		steadySinceMs = inputs.nowMs;
+	}
+
+	bool hot = (inputs.cpuTemperatureC >= 0.0f && inputs.cpuTemperatureC >= config.hotTemperatureC) ||
+						 (inputs.cpuLoad >= 0.0f && inputs.cpuLoad >= config.busyLoad);
+
+	ProcessingMode next = ProcessingMode::Normal;
+	if (inputs.nowMs < alertUntilMs) {
+		next = ProcessingMode::Alert;
+	} else if (hot && earKnown) {
+		// 얼굴을 놓친 상태에서는 재검출을 위해 Normal 유지
+		next = ProcessingMode::Economy;
+	} else if (steady && inputs.nowMs - steadySinceMs >= config.economyAfterMs &&
+						 inputs.motionVariance < config.roughMotionVariance) {
+		next = ProcessingMode::Economy;
+	}
+
+	if (next != current) {
+		modeChanges.fetch_add(1, std::memory_order_relaxed);
+		mode.store(static_cast<int>(next), std::memory_order_release);
+	}
+	return next;
+}
+
+const ProcessingProfile& ProcessingGovernor::profileOf(ProcessingMode mode) const {
+	switch (mode) {
+		case ProcessingMode::Economy:
+			return config.economy;
+		case ProcessingMode::Normal:
+			return config.normal;
+		case ProcessingMode::Alert:
+		default:
+			return config.alert;
+	}
+}
+
+ProcessingProfile ProcessingGovernor::getProfile() const {
+	return profileOf(getMode());
+}
+
+bool ProcessingGovernor::shouldCapture(uint64_t frameSlot) const {
+	int divisor = profileOf(getMode()).captureDivisor;
+	return divisor <= 1 || frameSlot % static_cast<uint64_t>(divisor) == 0;
+}
+
+bool ProcessingGovernor::shouldUplink(uint64_t sequence) const {
+	int divisor = profileOf(getMode()).uplinkDivisor;
+	return divisor <= 1 || sequence % static_cast<uint64_t>(divisor) == 0;
+}
+
+const char* ProcessingGovernor::modeName(ProcessingMode mode) {
+	switch (mode) {
+		case ProcessingMode::Economy:
+			return "economy";
+		case ProcessingMode::Normal:
+			return "normal";
+		case ProcessingMode::Alert:
+		default:
+			return "alert";
+	}
+}
+
+GovernorStats ProcessingGovernor::getStats() const {
+	return GovernorStats{getMode(),
+											 modeChanges.load(),
+											 alertTriggers.load(),
+											 modeTimeMs[static_cast<int>(ProcessingMode::Economy)].load(),
+											 modeTimeMs[static_cast<int>(ProcessingMode::Normal)].load(),
+											 modeTimeMs[static_cast<int>(ProcessingMode::Alert)].load()};
+}
+
+void ProcessingGovernor::logStats() const {
+	GovernorStats stats = getStats();
+	std::cout << "[Governor] mode " << modeName(stats.mode) << ", changes " << stats.modeChanges
+						<< ", alert-triggers " << stats.alertTriggers << " | economy/normal/alert "
+						<< stats.economyMs / 1000 << "/" << stats.normalMs / 1000 << "/"
+						<< stats.alertMs / 1000 << "s" << std::endl;
+}
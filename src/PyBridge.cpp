@@ -0,0 +1,142 @@
+#include "../include/PyBridge.h"
+
+#include <iostream>
+
+// NumPy C API는 FirmwareManager.cpp 에서 초기화됨
+#define NO_IMPORT_ARRAY
+#define PY_ARRAY_UNIQUE_SYMBOL NOSLEEP_ARRAY_API
+#define NPY_NO_DEPRECATED_API	 NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+PyCallable::PyCallable() : function(nullptr), args(nullptr), argCount(0) {}
+
+PyCallable::~PyCallable() {
+	// 인터프리터가 이미 종료되었으면 참조를 정리하지 않음
+	if (Py_IsInitialized() && (function || args)) {
+		PyGilGuard gil;
+		reset();
+	}
+}
+
+void PyCallable::releaseArgs() {
+	Py_CLEAR(args);
+}
+
+void PyCallable::reset() {
+	releaseArgs();
+	Py_CLEAR(function);
+	argCount = 0;
+}
+
+bool PyCallable::resolve(const char* moduleName, const char* functionName, Py_ssize_t count) {
+	reset();
+	name = std::string(moduleName) + "." + functionName;
+
+	PyObject* module = PyImport_ImportModule(moduleName);
+	if (module == nullptr) {
+		PyErr_Print();
+		std::cerr << "Python 모듈 import 실패: " << moduleName << std::endl;
+		return false;
+	}
+	PyObject* attr = PyObject_GetAttrString(module, functionName);
+	Py_DECREF(module);
+	if (attr == nullptr || !PyCallable_Check(attr)) {
+		PyErr_Print();
+		Py_XDECREF(attr);
+		std::cerr << "Python 함수 조회 실패: " << name << std::endl;
+		return false;
+	}
+
+	function = attr;
+	argCount = count;
+	return true;
+}
+
+bool PyCallable::resolveMethod(PyObject* instance, const char* methodName, const std::string& label) {
+	reset();
+	name = label + "." + methodName;
+
+	PyObject* method = instance ? PyObject_GetAttrString(instance, methodName) : nullptr;
+	if (method == nullptr || !PyCallable_Check(method)) {
+		PyErr_Print();
+		Py_XDECREF(method);
+		std::cerr << "Python 메서드 조회 실패: " << name << std::endl;
+		return false;
+	}
+
+	function = method;
+	argCount = 0;
+	return true;
+}
+
+void PyCallable::setArg(Py_ssize_t index, PyObject* value) {
+	if (index < 0 || index >= argCount) {
+		Py_XDECREF(value);
+		return;
+	}
+
+	// 함수가 이전 호출의 인자 튜플을 붙잡고 있으면 수정할 수 없으므로 새로 만듦
+	if (args == nullptr || Py_REFCNT(args) != 1) {
+		PyObject* fresh = PyTuple_New(argCount);
+		if (args != nullptr) {
+			for (Py_ssize_t i = 0; i < argCount; ++i) {
+				PyObject* item = PyTuple_GET_ITEM(args, i);
+				if (item != nullptr) {
+					Py_INCREF(item);
+					PyTuple_SET_ITEM(fresh, i, item);
+				}
+			}
+			Py_DECREF(args);
+		}
+		args = fresh;
+	}
+
+	// 튜플이 가지고 있던 이전 인자를 놓고 새 인자로 교체
+	PyObject* previous = PyTuple_GET_ITEM(args, index);
+	PyTuple_SET_ITEM(args, index, value);
+	Py_XDECREF(previous);
+}
+
+void PyCallable::clearArg(Py_ssize_t index) {
+	Py_INCREF(Py_None);
+	setArg(index, Py_None);
+}
+
+PyObject* PyCallable::call() {
+	if (function == nullptr) {
+		return nullptr;
+	}
+	if (argCount > 0 && args == nullptr) {
+		std::cerr << "Python 함수 인자가 설정되지 않음: " << name << std::endl;
+		return nullptr;
+	}
+
+	for (Py_ssize_t i = 0; i < argCount; ++i) {
+		if (PyTuple_GET_ITEM(args, i) == nullptr) {
+			std::cerr << "Python 함수 인자가 설정되지 않음: " << name << std::endl;
+			return nullptr;
+		}
+	}
+
+	PyObject* result = PyObject_CallObject(function, argCount > 0 ? args : nullptr);
+	if (result == nullptr) {
+		PyErr_Print();
+		std::cerr << "Python 함수 호출 실패: " << name << std::endl;
+	}
+	return result;
+}
+
+PyObject* wrapMatAsNumpy(const cv::Mat& mat) {
+	if (mat.empty() || mat.depth() != CV_8U || mat.dims != 2) {
+		return nullptr;
+	}
+
+	int channels = mat.channels();
+	npy_intp dims[3] = {mat.rows, mat.cols, channels};
+	npy_intp strides[3] = {static_cast<npy_intp>(mat.step[0]), static_cast<npy_intp>(channels), 1};
+	int nd = channels == 1 ? 2 : 3;
+
+	// 쓰기 플래그 없이 만들어 Python 쪽에서 캡처 버퍼를 수정하지 못하게 함
+	return PyArray_New(&PyArray_Type, nd, dims, NPY_UINT8, strides, mat.data, 0, NPY_ARRAY_ALIGNED,
+										 nullptr);
+}
@@ -1,7 +1,5 @@
 #include "../include/SleepinessDetector.h"
 
-#include <cpr/cpr.h>
-
 #include <cstdlib>
 #include <ctime>
 #include <filesystem>
@@ -12,135 +10,63 @@
 #include <sstream>
 #include <string>
 
+#include "../include/BackendClient.h"
+#include "../include/Base64.h"
 #include "../include/EyeClosureQueueManagement.h"
+#include "../include/LatencyMetrics.h"
 
-namespace {
-std::string base64_encode(const std::string& input) {
-	const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-	std::string encoded;
-	int val = 0;
-	int valb = -6;
-
-	for (unsigned char c : input) {
-		val = (val << 8) + c;
-		valb += 8;
-		while (valb >= 0) {
-			encoded.push_back(chars[(val >> valb) & 0x3F]);
-			valb -= 6;
-		}
-	}
-
-	if (valb > -6) {
-		encoded.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
-	}
-
-	while (encoded.size() % 4) {
-		encoded.push_back('=');
-	}
-
-	return encoded;
-}
-}	 // namespace
-
-SleepinessDetector::SleepinessDetector() {
+SleepinessDetector::SleepinessDetector() : frameIndex(0) {
 	sleepImgPath = "./frames";
 }
 
-void SleepinessDetector::sendDriverFrame(const cv::Mat& frame) {
-	static int frameIndex = 0;
-
-	// 이미지 데이터 인코딩
-	std::vector<uchar> buffer;
-	cv::imencode(".jpg", frame, buffer);
-
-	std::string base64Image = base64_encode(std::string(buffer.begin(), buffer.end()));
-
-	const char* uidC = std::getenv("DEVICE_UID");
-	const char* ipC = std::getenv("AI_SERVER_IP");
-
-	if (!uidC || !ipC) {
-		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
-		return;
+void SleepinessDetector::buildFramePayload(const std::string& deviceUid, int frameIdx,
+																					 const std::vector<uchar>& jpeg, std::string& payload,
+																					 const cv::Rect& roi) {
+	// {"deviceUid":"...","frameIdx":N,"driverFrame":"<base64>"} 를 최종 크기로 한 번만 할당해 직접 작성
+	std::string prefix = "{\"deviceUid\":" + nlohmann::json(deviceUid).dump() +
+											 ",\"frameIdx\":" + std::to_string(frameIdx);
+	if (!roi.empty()) {
+		prefix += ",\"roi\":[" + std::to_string(roi.x) + "," + std::to_string(roi.y) + "," +
+							std::to_string(roi.width) + "," + std::to_string(roi.height) + "]";
 	}
-
-	std::string deviceUidEnv(uidC);
-	std::string serverIP(ipC);
-
-	// 요청 데이터 생성
-	nlohmann::json jsonData = {
-			{"deviceUid", deviceUidEnv}, {"frameIdx", frameIndex++}, {"driverFrame", base64Image}};
-
-	// 요청 URL 생성
-	std::string url = serverIP + "/save/frame";
-
-	// 콜백 기반 비동기 요청
-	cpr::PostCallback(
-			[](cpr::Response r) {
-				if (r.error) {
-					// std::cerr << "통신 오류: " << r.error.message << std::endl;
-				}
-			},
-			cpr::Url{url}, cpr::Header{{"Content-Type", "application/json"}}, cpr::Body{jsonData.dump()},
-			cpr::Timeout{5000}	// 5초 타임아웃
-	);
+	prefix += ",\"driverFrame\":\"";
+	static const char suffix[] = "\"}";
+
+	payload.clear();
+	payload.reserve(prefix.size() + base64EncodedSize(jpeg.size()) + sizeof(suffix) - 1);
+	payload.append(prefix);
+	base64Append(jpeg.data(), jpeg.size(), payload);
+	payload.append(suffix, sizeof(suffix) - 1);
 }
 
-void SleepinessDetector::requestAIDetection(
-		const std::string& uid, const std::string& requestTime,
-		std::function<void(bool success, bool isDrowsy, const std::string& message)> callback) {
-	std::cout << "AI Server 진단 요청하는 파이 UID : " << uid << " 및 요청 시각 : " << requestTime
-						<< std::endl;
-
-	const char* uidC = std::getenv("DEVICE_UID");
-	const char* ipC = std::getenv("AI_SERVER_IP");
-
-	if (!uidC || !ipC) {
-		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
-		callback(false, false, "환경 변수 설정 오류");
-		return;
+void SleepinessDetector::sendDriverFrame(const cv::Mat& frame, int jpegQuality,
+																				 const cv::Rect& roi) {
+	// 이미지 데이터 인코딩 (업링크 스레드에서만 호출되므로 버퍼 재사용)
+	std::vector<int> params;
+	if (jpegQuality > 0) {
+		params = {cv::IMWRITE_JPEG_QUALITY, jpegQuality};
 	}
-
-	std::string deviceUidEnv(uidC);
-	std::string serverIP(ipC);
-
-	auto encodedSecure = cpr::util::urlEncode(deviceUidEnv);
-	std::string encodedUid(encodedSecure.begin(), encodedSecure.end());
-
-	std::string url = serverIP + "/diagnosis/drowsiness?deviceUid=" + encodedUid;
-
-	// 동기 HTTP 요청 (2초 타임아웃)
-	cpr::Response r = cpr::Get(cpr::Url{url}, cpr::Timeout{2000});
-
-	if (r.error) {
-		std::cerr << "통신 오류: " << r.error.message << std::endl;
-		callback(false, false, "통신 오류: " + r.error.message);
+	bool encoded;
+	{
+		ScopedLatency timer(LatencyStage::Encode);
+		encoded = cv::imencode(".jpg", frame, encodeBuffer, params);
+	}
+	if (!encoded) {
 		return;
 	}
 
-	if (r.status_code != 200) {
-		std::cerr << "서버 응답 실패 - 상태 코드: " << r.status_code << "\n본문: " << r.text
-							<< std::endl;
-		callback(false, false, "HTTP 오류: " + std::to_string(r.status_code));
+	BackendClient& client = BackendClient::getInstance();
+	if (!client.isConfigured(BackendServer::AiServer)) {
+		std::cerr << "환경 변수 설정 오류: 통신에 필요한 정보 누락" << std::endl;
 		return;
 	}
 
-	try {
-		nlohmann::json jsonResp = nlohmann::json::parse(r.text);
+	// 요청 데이터 생성 (JPEG -> base64 -> JSON 본문을 중간 복사 없이 작성)
+	std::string payload;
+	buildFramePayload(client.getDeviceUid(), frameIndex++, encodeBuffer, payload, roi);
 
-		if (jsonResp.contains("success") && jsonResp["success"] == true) {
-			bool isDrowsy = jsonResp["isDrowsinessDrive"];
-			std::string detectionTime = jsonResp["detectionTime"];
-			std::cout << "AI 진단 성공 - 졸음 여부: " << (isDrowsy ? "예" : "아니오") << std::endl;
-			callback(true, isDrowsy, "AI 진단 성공, 감지 시각: " + detectionTime);
-		} else {
-			const auto& err = jsonResp["error"];
-			std::cerr << "AI 서버 오류 - 메시지: " << err["message"] << std::endl;
-			callback(false, false, "AI 서버 오류: " + std::string(err["message"]));
-		}
-	} catch (const std::exception& e) {
-		std::cerr << "JSON 파싱 오류: " << e.what() << std::endl;
-		callback(false, false, "JSON 파싱 오류: " + std::string(e.what()));
-	}
+	// 공용 클라이언트의 비동기 워커에서 keep-alive 연결로 전송
+	client.postAsync(BackendEndpoints::DriverFrame, std::move(payload), "application/json");
 }
 
 bool SleepinessDetector::getLocalDetection(EyeClosureQueueManagement& eyeManager) {
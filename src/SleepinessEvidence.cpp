@@ -0,0 +1,59 @@
+#include "../include/SleepinessEvidence.h"
+
+SleepinessEvidence::SleepinessEvidence(const std::string& id, int64_t detectedAtMs,
+																			 std::vector<BufferedFrame> preEventFrames,
+																			 size_t postEventFrames)
+		: id(id),
+			detectedAtMs(detectedAtMs),
+			postEventFrames(postEventFrames),
+			frames(std::move(preEventFrames)),
+			postEventCount(0),
+			complete(postEventFrames == 0) {
+	frames.reserve(frames.size() + postEventFrames);
+}
+
+bool SleepinessEvidence::appendFrame(int64_t timestampMs, const std::string& name,
+																		 const std::vector<uchar>& jpeg) {
+	std::lock_guard<std::mutex> lock(evidenceMutex);
+	if (complete) {
+		return false;
+	}
+
+	// 감지 직전 프레임과 겹치는 프레임은 건너뜀
+	if (!frames.empty() && timestampMs <= frames.back().timestampMs) {
+		return false;
+	}
+
+	frames.push_back(BufferedFrame{timestampMs, name, jpeg});
+	postEventCount++;
+
+	if (postEventCount >= postEventFrames) {
+		complete = true;
+		completeCondition.notify_all();
+		return true;
+	}
+	return false;
+}
+
+void SleepinessEvidence::markComplete() {
+	std::lock_guard<std::mutex> lock(evidenceMutex);
+	complete = true;
+	completeCondition.notify_all();
+}
+
+bool SleepinessEvidence::waitUntilComplete(std::chrono::milliseconds timeout) {
+	std::unique_lock<std::mutex> lock(evidenceMutex);
+	return completeCondition.wait_for(lock, timeout, [this] { return complete; });
+}
+
+std::vector<BufferedFrame> SleepinessEvidence::takeFrames() {
+	std::lock_guard<std::mutex> lock(evidenceMutex);
+	complete = true;
+	completeCondition.notify_all();
+	return std::move(frames);
+}
+
+bool SleepinessEvidence::isComplete() {
+	std::lock_guard<std::mutex> lock(evidenceMutex);
+	return complete;
+}
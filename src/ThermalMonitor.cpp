@@ -0,0 +1,344 @@
+#include "../include/ThermalMonitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+// 정수 하나만 들어 있는 sysfs 파일 읽기
+bool readLong(const fs::path& path, long& value) {
+	std::ifstream file(path);
+	return static_cast<bool>(file >> value);
+}
+
+bool readWord(const fs::path& path, std::string& value) {
+	std::ifstream file(path);
+	return static_cast<bool>(file >> value);
+}
+
+int64_t steadyNowMs() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+						 std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
+}	 // namespace
+
+ThermalMonitor::ThermalMonitor(const std::string& root, const ThermalConfig& config, bool enabled)
+		: root(root),
+			config(config),
+			enabled(enabled),
+			previousBusy(0),
+			previousTotal(0),
+			releaseSinceMs(-1),
+			lastSampledMs(-1),
+			level(static_cast<int>(ThermalLevel::Normal)),
+			temperatureC(-1.0f),
+			trendCPerMin(0.0f),
+			predictedC(-1.0f),
+			throttleC(config.throttleTemperatureC),
+			cpuUtilization(-1.0f),
+			frequencyCapped(false),
+			sampleCount(0),
+			levelChanges(0),
+			terminate(false) {
+	for (auto& time : levelTimeMs) {
+		time.store(0);
+	}
+}
+
+ThermalMonitor::~ThermalMonitor() {
+	stop();
+}
+
+std::unique_ptr<ThermalMonitor> ThermalMonitor::fromEnvironment() {
+	const char* rootC = std::getenv("THERMAL_SYSFS_ROOT");
+	std::string root = rootC ? rootC : "";
+	const char* enabledC = std::getenv("THERMAL_THROTTLE");
+	bool enabled = !(enabledC && std::string(enabledC) == "0");
+
+	if (!root.empty()) {
+		std::cout << "발열 감시: 시뮬레이션 루트 " << root << std::endl;
+	}
+	if (!enabled) {
+		std::cout << "발열 감시: 처리 축소 사용 안 함" << std::endl;
+	}
+	return std::make_unique<ThermalMonitor>(root, ThermalConfig(), enabled);
+}
+
+void ThermalMonitor::start() {
+	if (monitorThread.joinable()) {
+		return;
+	}
+	terminate.store(false);
+	monitorThread = std::thread(&ThermalMonitor::monitorLoop, this);
+}
+
+void ThermalMonitor::stop() {
+	{
+		std::lock_guard<std::mutex> lock(waitMutex);
+		terminate.store(true);
+	}
+	waitCondition.notify_all();
+	if (monitorThread.joinable()) {
+		monitorThread.join();
+	}
+}
+
+void ThermalMonitor::monitorLoop() {
+	std::unique_lock<std::mutex> lock(waitMutex);
+	while (!terminate.load()) {
+		lock.unlock();
+		sample(steadyNowMs());
+		lock.lock();
+		// 정지 요청 시 바로 깨어나도록 조건 변수로 대기
+		waitCondition.wait_for(lock, std::chrono::milliseconds(config.sampleIntervalMs),
+													 [this] { return terminate.load(); });
+	}
+}
+
+float ThermalMonitor::readTemperature() const {
+	// 가장 뜨거운 zone 기준 (Pi 는 cpu-thermal 하나, 다른 보드는 여러 개일 수 있음)
+	float hottest = -1.0f;
+	std::error_code error;
+	for (const auto& entry : fs::directory_iterator(root + "/sys/class/thermal", error)) {
+		if (entry.path().filename().string().rfind("thermal_zone", 0) != 0) {
+			continue;
+		}
+		long milliCelsius = 0;
+		if (readLong(entry.path() / "temp", milliCelsius)) {
+			hottest = std::max(hottest, milliCelsius / 1000.0f);
+		}
+	}
+	return hottest;
+}
+
+float ThermalMonitor::readThrottleTemperature() const {
+	// 커널 passive 트립 포인트가 있으면 그 온도부터 클럭이 내려감 (Pi 는 펌웨어가 80도에서 스로틀)
+	float lowest = config.throttleTemperatureC;
+	std::error_code error;
+	for (const auto& entry : fs::directory_iterator(root + "/sys/class/thermal", error)) {
+		if (entry.path().filename().string().rfind("thermal_zone", 0) != 0) {
+			continue;
+		}
+		for (int trip = 0; trip < 16; ++trip) {
+			std::string prefix = "trip_point_" + std::to_string(trip);
+			std::string type;
+			if (!readWord(entry.path() / (prefix + "_type"), type)) {
+				break;
+			}
+			long milliCelsius = 0;
+			if (type == "passive" && readLong(entry.path() / (prefix + "_temp"), milliCelsius) &&
+					milliCelsius > 0) {
+				lowest = std::min(lowest, milliCelsius / 1000.0f);
+			}
+		}
+	}
+	return lowest;
+}
+
+float ThermalMonitor::readCpuUtilization() {
+	// 첫 줄: cpu user nice system idle iowait irq softirq steal ...
+	std::ifstream stat(root + "/proc/stat");
+	std::string line;
+	if (!std::getline(stat, line) || line.rfind("cpu ", 0) != 0) {
+		return -1.0f;
+	}
+	std::istringstream fields(line.substr(4));
+	uint64_t values[8] = {0};
+	for (auto& value : values) {
+		if (!(fields >> value)) {
+			break;
+		}
+	}
+	uint64_t idle = values[3] + values[4];
+	uint64_t total = 0;
+	for (uint64_t value : values) {
+		total += value;
+	}
+	uint64_t busy = total - idle;
+
+	// 직전 샘플과의 차이로 계산 (첫 샘플이나 카운터가 되돌아간 경우 알 수 없음)
+	float utilization = -1.0f;
+	if (previousTotal > 0 && total > previousTotal && busy >= previousBusy) {
+		utilization = static_cast<float>(busy - previousBusy) / (total - previousTotal);
+	}
+	previousBusy = busy;
+	previousTotal = total;
+	return utilization;
+}
+
+bool ThermalMonitor::readFrequencyCapped() const {
+	const std::string cpufreq = root + "/sys/devices/system/cpu/cpu0/cpufreq/";
+	long current = 0;
+	long maximum = 0;
+	if (!readLong(cpufreq + "scaling_cur_freq", current) ||
+			!readLong(cpufreq + "cpuinfo_max_freq", maximum) || maximum <= 0) {
+		return false;
+	}
+	return current < maximum * 9 / 10;
+}
+
+float ThermalMonitor::computeTrend() const {
+	// 최근 구간 온도의 최소 제곱 기울기 (도/분), 5초 미만이면 추세 없음
+	if (history.size() < 5 || history.back().first - history.front().first < 5000) {
+		return 0.0f;
+	}
+	double meanT = 0.0;
+	double meanC = 0.0;
+	for (const auto& point : history) {
+		meanT += point.first - history.front().first;
+		meanC += point.second;
+	}
+	meanT /= history.size();
+	meanC /= history.size();
+
+	double covariance = 0.0;
+	double variance = 0.0;
+	for (const auto& point : history) {
+		double dt = point.first - history.front().first - meanT;
+		covariance += dt * (point.second - meanC);
+		variance += dt * dt;
+	}
+	return variance > 0.0 ? static_cast<float>(covariance / variance * 60000.0) : 0.0f;
+}
+
+ThermalLevel ThermalMonitor::levelFor(float temperature, float predicted, float utilization,
+																			float offsetC) const {
+	if (temperature < 0.0f) {
+		return ThermalLevel::Normal;
+	}
+	float throttle = throttleC.load(std::memory_order_relaxed);
+	float current = temperature + offsetC;
+	float ahead = predicted + offsetC;
+
+	// 이미 스로틀 직전이거나, 경고 구간에서 예측 구간 안에 스로틀 온도에 닿을 때
+	if (current >= throttle - config.criticalMarginC ||
+			(current >= throttle - config.elevatedMarginC && ahead >= throttle)) {
+		return ThermalLevel::Critical;
+	}
+	if (current >= throttle - config.elevatedMarginC || ahead >= throttle - config.criticalMarginC ||
+			(utilization >= config.busyUtilization && ahead >= throttle - config.elevatedMarginC)) {
+		return ThermalLevel::Elevated;
+	}
+	return ThermalLevel::Normal;
+}
+
+ThermalLevel ThermalMonitor::sample(int64_t nowMs) {
+	float temperature = readTemperature();
+	float utilization = readCpuUtilization();
+	throttleC.store(readThrottleTemperature(), std::memory_order_relaxed);
+	bool capped = utilization >= config.busyUtilization && readFrequencyCapped();
+
+	if (temperature >= 0.0f) {
+		history.emplace_back(nowMs, temperature);
+		while (history.size() > static_cast<size_t>(std::max(2, config.historySamples))) {
+			history.pop_front();
+		}
+	}
+	float trend = computeTrend();
+	// 식는 추세로는 예측 온도를 낮추지 않음 (단계 하향은 실제 온도로만 판단)
+	float predicted = temperature + std::max(0.0f, trend) * config.predictionHorizonMs / 60000.0f;
+
+	temperatureC.store(temperature, std::memory_order_relaxed);
+	cpuUtilization.store(utilization, std::memory_order_relaxed);
+	trendCPerMin.store(trend, std::memory_order_relaxed);
+	predictedC.store(predicted, std::memory_order_relaxed);
+	frequencyCapped.store(capped, std::memory_order_relaxed);
+	sampleCount.fetch_add(1, std::memory_order_relaxed);
+
+	ThermalLevel current = getLevel();
+	if (lastSampledMs >= 0 && nowMs > lastSampledMs) {
+		levelTimeMs[static_cast<int>(current)].fetch_add(nowMs - lastSampledMs,
+																										 std::memory_order_relaxed);
+	}
+	lastSampledMs = nowMs;
+	if (!enabled) {
+		return current;
+	}
+
+	// 올릴 때는 즉시, 내릴 때는 히스테리시스만큼 더 식은 상태가 releaseHoldMs 동안 이어져야 함
+	ThermalLevel next = capped ? ThermalLevel::Critical
+														 : levelFor(temperature, predicted, utilization, 0.0f);
+	if (next > current) {
+		releaseSinceMs = -1;
+	} else if (next < current) {
+		ThermalLevel relaxed = capped ? ThermalLevel::Critical
+																	: levelFor(temperature, predicted, utilization,
+																						 config.releaseHysteresisC);
+		if (relaxed >= current) {
+			releaseSinceMs = -1;
+			next = current;
+		} else {
+			if (releaseSinceMs < 0) {
+				releaseSinceMs = nowMs;
+			}
+			next = nowMs - releaseSinceMs >= config.releaseHoldMs ? relaxed : current;
+		}
+	} else {
+		releaseSinceMs = -1;
+	}
+
+	if (next != current) {
+		releaseSinceMs = -1;
+		levelChanges.fetch_add(1, std::memory_order_relaxed);
+		level.store(static_cast<int>(next), std::memory_order_release);
+		std::cout << "발열 단계 전환: " << levelName(current) << " -> " << levelName(next) << " ("
+							<< temperature << "C, 추세 " << trend << "C/min, 예측 " << predicted << "C, 기준 "
+							<< throttleC.load(std::memory_order_relaxed) << "C)" << std::endl;
+	}
+	return next;
+}
+
+const ThermalDegradation& ThermalMonitor::getDegradation() const {
+	switch (getLevel()) {
+		case ThermalLevel::Critical:
+			return config.critical;
+		case ThermalLevel::Elevated:
+			return config.elevated;
+		case ThermalLevel::Normal:
+		default:
+			return config.normal;
+	}
+}
+
+const char* ThermalMonitor::levelName(ThermalLevel level) {
+	switch (level) {
+		case ThermalLevel::Critical:
+			return "critical";
+		case ThermalLevel::Elevated:
+			return "elevated";
+		case ThermalLevel::Normal:
+		default:
+			return "normal";
+	}
+}
+
+ThermalStats ThermalMonitor::getStats() const {
+	return ThermalStats{getLevel(),
+											temperatureC.load(),
+											trendCPerMin.load(),
+											predictedC.load(),
+											throttleC.load(),
+											cpuUtilization.load(),
+											frequencyCapped.load(),
+											sampleCount.load(),
+											levelChanges.load(),
+											levelTimeMs[static_cast<int>(ThermalLevel::Elevated)].load(),
+											levelTimeMs[static_cast<int>(ThermalLevel::Critical)].load()};
+}
+
+void ThermalMonitor::logStats() const {
+	ThermalStats stats = getStats();
+	std::cout << "[Thermal] " << levelName(stats.level) << ", " << stats.temperatureC << "C ("
+						<< stats.trendCPerMin << "C/min, predicted " << stats.predictedC << "C, throttle "
+						<< stats.throttleC << "C), cpu " << stats.cpuUtilization
+						<< (stats.frequencyCapped ? ", clock capped" : "") << " | changes "
+						<< stats.levelChanges << ", elevated/critical " << stats.elevatedMs / 1000 << "/"
+						<< stats.criticalMs / 1000 << "s" << std::endl;
+}
@@ -0,0 +1,391 @@
+#include "../include/UploadOutbox.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+const char* const JOURNAL_FILE = "journal.log";
+const char* const CONTENT_EXTENSION = ".mp4";
+
+// 백오프: 2초부터 두 배씩, 최대 5분
+const double BACKOFF_BASE_MS = 2000.0;
+const double BACKOFF_MAX_MS = 300000.0;
+
+// 버퍼를 파일에 쓰고 디스크까지 반영 (전원 차단 대비)
+bool writeDurably(const std::string& path, const char* mode, const void* data, size_t size) {
+	FILE* file = std::fopen(path.c_str(), mode);
+	if (!file) {
+		return false;
+	}
+
+	bool ok = std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0;
+#ifndef _WIN32
+	ok = ok && ::fsync(fileno(file)) == 0;
+#endif
+	return std::fclose(file) == 0 && ok;
+}
+
+// id(yyyyMMdd_HHmmss_fff) 를 밀리초로 변환 (id 끼리 비교만 하므로 시간대는 무시)
+bool idToMs(const std::string& id, int64_t& ms) {
+	int year, month, day, hour, minute, second, millis;
+	if (id.size() < 19 || std::sscanf(id.c_str(), "%4d%2d%2d_%2d%2d%2d_%3d", &year, &month, &day,
+																		 &hour, &minute, &second, &millis) != 7) {
+		return false;
+	}
+	// 그레고리력 날짜 -> 1970-01-01 기준 일 수
+	year -= month <= 2;
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	int64_t yearOfEra = year - era * 400;
+	int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	int64_t days = era * 146097 + dayOfEra - 719468;
+	ms = ((days * 24 + hour) * 60 + minute) * 60000LL + second * 1000LL + millis;
+	return true;
+}
+
+std::vector<std::string> splitFields(const std::string& line) {
+	std::vector<std::string> fields;
+	std::stringstream ss(line);
+	std::string field;
+	while (std::getline(ss, field, '\t')) {
+		fields.push_back(field);
+	}
+	return fields;
+}
+}	 // namespace
+
+UploadOutbox::UploadOutbox(const std::string& directory, uint64_t maxBytes,
+													 int64_t coalesceWindowMs)
+		: directory(directory),
+			maxBytes(maxBytes),
+			coalesceWindowMs(coalesceWindowMs),
+			pendingBytes(0),
+			evictedCount(0),
+			coalescedCount(0),
+			journalAppends(0),
+			consecutiveFailures(0),
+			nextAttemptAt(std::chrono::steady_clock::now()),
+			jitterEngine(std::random_device{}()) {}
+
+std::string UploadOutbox::contentPath(const std::string& id) const {
+	return directory + "/" + id + CONTENT_EXTENSION;
+}
+
+std::string UploadOutbox::journalPath() const {
+	return directory + "/" + JOURNAL_FILE;
+}
+
+bool UploadOutbox::appendJournal(const std::string& line) {
+	std::string record = line + "\n";
+	if (!writeDurably(journalPath(), "ab", record.data(), record.size())) {
+		std::cerr << "[Outbox] 저널 기록 실패: " << line << std::endl;
+		return false;
+	}
+	journalAppends++;
+	return true;
+}
+
+bool UploadOutbox::open() {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+
+	try {
+		std::filesystem::create_directories(directory);
+	} catch (const std::filesystem::filesystem_error& e) {
+		std::cerr << "[Outbox] 디렉토리 생성 실패: " << e.what() << std::endl;
+		return false;
+	}
+
+	replayJournal();
+	if (!compactJournal()) {
+		return false;
+	}
+
+	if (!pending.empty()) {
+		std::cout << "[Outbox] 미전송 졸음 근거 영상 " << pending.size() << "개 복원 (" << pendingBytes
+							<< " bytes)" << std::endl;
+	}
+	return true;
+}
+
+void UploadOutbox::replayJournal() {
+	pending.clear();
+	pendingBytes = 0;
+
+	std::ifstream journal(journalPath());
+	std::string line;
+	while (std::getline(journal, line)) {
+		std::vector<std::string> fields = splitFields(line);
+
+		// 기록 도중 전원이 꺼져 잘린 마지막 줄은 무시
+		if (fields.size() == 5 && fields[0] == "ADD") {
+			OutboxEntry entry;
+			entry.id = fields[1];
+			entry.detectedAt = fields[2];
+			entry.checksum = fields[3];
+			try {
+				entry.size = std::stoull(fields[4]);
+			} catch (const std::exception&) {
+				continue;
+			}
+			pending[entry.id] = entry;
+		} else if (fields.size() == 2 && (fields[0] == "DONE" || fields[0] == "DROP")) {
+			pending.erase(fields[1]);
+		}
+	}
+
+	// 저널에는 있지만 영상 파일이 없거나 크기가 다르면 복구 불가로 보고 제외
+	for (auto it = pending.begin(); it != pending.end();) {
+		std::error_code error;
+		uint64_t fileSize = std::filesystem::file_size(contentPath(it->first), error);
+		if (error || fileSize != it->second.size) {
+			std::cerr << "[Outbox] 손상된 영상 제외: " << it->first << std::endl;
+			it = pending.erase(it);
+		} else {
+			pendingBytes += fileSize;
+			++it;
+		}
+	}
+
+	// 저널에 없는 영상 파일 (ADD 기록 전에 전원이 꺼진 경우) 및 임시 파일 정리
+	std::error_code error;
+	std::vector<std::filesystem::path> orphans;
+	for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+		if (file.path().filename() == JOURNAL_FILE) {
+			continue;
+		}
+		std::string id = file.path().stem().string();
+		if (file.path().extension() != CONTENT_EXTENSION || pending.find(id) == pending.end()) {
+			orphans.push_back(file.path());
+		}
+	}
+	for (const auto& orphan : orphans) {
+		std::filesystem::remove(orphan, error);
+	}
+}
+
+bool UploadOutbox::compactJournal() {
+	// 남은 영상의 ADD 기록만으로 저널을 다시 써서 크기가 계속 늘어나지 않도록 함
+	std::string content;
+	for (const auto& [id, entry] : pending) {
+		content += "ADD\t" + id + "\t" + entry.detectedAt + "\t" + entry.checksum + "\t" +
+							 std::to_string(entry.size) + "\n";
+	}
+
+	std::string tempPath = journalPath() + ".tmp";
+	if (!writeDurably(tempPath, "wb", content.data(), content.size())) {
+		std::cerr << "[Outbox] 저널 압축 실패" << std::endl;
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, journalPath(), error);
+	if (error) {
+		std::cerr << "[Outbox] 저널 교체 실패: " << error.message() << std::endl;
+		return false;
+	}
+	journalAppends = 0;
+	return true;
+}
+
+bool UploadOutbox::compact() {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	if (journalAppends == 0) {
+		return true;
+	}
+	return compactJournal();
+}
+
+bool UploadOutbox::enqueue(const std::string& id, const std::string& detectedAt,
+													 const std::string& checksum, std::vector<uchar> video) {
+	if (video.empty() || video.size() > maxBytes) {
+		std::cerr << "[Outbox] 저장할 수 없는 영상 크기: " << video.size() << " bytes" << std::endl;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(outboxMutex);
+
+	// 영상 파일을 먼저 완전히 기록한 뒤 이름을 바꾸고, 그 다음 저널에 추가
+	std::string path = contentPath(id);
+	std::string tempPath = path + ".tmp";
+	if (!writeDurably(tempPath, "wb", video.data(), video.size())) {
+		std::cerr << "[Outbox] 영상 파일 기록 실패: " << tempPath << std::endl;
+		return false;
+	}
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		std::cerr << "[Outbox] 영상 파일 이름 변경 실패: " << error.message() << std::endl;
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+
+	// 같은 이벤트가 다시 들어오면 기존 항목을 교체 (중복 전송 방지)
+	auto existing = pending.find(id);
+	if (existing != pending.end()) {
+		pendingBytes -= existing->second.size;
+		pending.erase(existing);
+	}
+
+	OutboxEntry entry;
+	entry.id = id;
+	entry.detectedAt = detectedAt;
+	entry.checksum = checksum;
+	entry.size = video.size();
+	if (!appendJournal("ADD\t" + id + "\t" + detectedAt + "\t" + checksum + "\t" +
+										 std::to_string(entry.size))) {
+		std::filesystem::remove(path, error);
+		return false;
+	}
+	pending[id] = entry;
+	pendingBytes += entry.size;
+	cachedId = id;
+	cachedVideo = std::move(video);
+
+	// 같은 졸음 구간에서 겹치거나 이어진 이전 이벤트는 최신 영상 하나로 합침
+	int64_t detectedMs = 0;
+	if (coalesceWindowMs > 0 && idToMs(id, detectedMs)) {
+		for (auto it = pending.begin(); it != pending.end();) {
+			int64_t previousMs = 0;
+			if (it->first != id && idToMs(it->first, previousMs) && previousMs <= detectedMs &&
+					detectedMs - previousMs <= coalesceWindowMs) {
+				std::string merged = (it++)->first;
+				removeEntry(merged, "DROP");
+				coalescedCount++;
+			} else {
+				++it;
+			}
+		}
+	}
+
+	// 디스크 사용량 상한 초과 시 가장 오래된 영상부터 폐기
+	while (pendingBytes > maxBytes && pending.size() > 1) {
+		std::string oldest = pending.begin()->first;
+		std::cerr << "[Outbox] 저장 공간 초과, 오래된 영상 폐기: " << oldest << std::endl;
+		removeEntry(oldest, "DROP");
+		evictedCount++;
+	}
+
+	std::cout << "[Outbox] 영상 저장: " << id << " (" << entry.size << " bytes, 대기 "
+						<< pending.size() << "개)" << std::endl;
+	return true;
+}
+
+void UploadOutbox::removeEntry(const std::string& id, const char* journalTag) {
+	auto it = pending.find(id);
+	if (it == pending.end()) {
+		return;
+	}
+
+	// 저널에 먼저 기록해야 파일 삭제 후 전원이 꺼져도 다시 전송하지 않음
+	appendJournal(std::string(journalTag) + "\t" + id);
+	pendingBytes -= it->second.size;
+	pending.erase(it);
+	if (cachedId == id) {
+		cachedId.clear();
+		cachedVideo.clear();
+		cachedVideo.shrink_to_fit();
+	}
+
+	std::error_code error;
+	std::filesystem::remove(contentPath(id), error);
+}
+
+std::vector<OutboxEntry> UploadOutbox::dueEntries() {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	std::vector<OutboxEntry> entries;
+
+	if (std::chrono::steady_clock::now() < nextAttemptAt) {
+		return entries;
+	}
+	for (const auto& [id, entry] : pending) {
+		entries.push_back(entry);
+	}
+	return entries;
+}
+
+bool UploadOutbox::loadContent(const OutboxEntry& entry, std::vector<uchar>& video) const {
+	{
+		std::lock_guard<std::mutex> lock(outboxMutex);
+		if (entry.id == cachedId && cachedVideo.size() == entry.size) {
+			video = cachedVideo;
+			return true;
+		}
+	}
+
+	std::ifstream file(contentPath(entry.id), std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	video.resize(entry.size);
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(video.data()), entry.size));
+}
+
+void UploadOutbox::markSent(const std::string& id) {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	removeEntry(id, "DONE");
+	consecutiveFailures = 0;
+	nextAttemptAt = std::chrono::steady_clock::now();
+}
+
+void UploadOutbox::markRejected(const std::string& id) {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	std::cerr << "[Outbox] 서버가 거부한 영상 폐기: " << id << std::endl;
+	removeEntry(id, "DROP");
+}
+
+void UploadOutbox::markRetry(const std::string& id) {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+
+	// 지수 백오프 + 지터 (차량 여러 대가 동시에 재연결해도 요청이 몰리지 않도록)
+	consecutiveFailures = std::min(consecutiveFailures + 1, 16);
+	double backoffMs = std::min(BACKOFF_MAX_MS, BACKOFF_BASE_MS * (1 << (consecutiveFailures - 1)));
+	std::uniform_real_distribution<double> jitter(0.5, 1.0);
+	auto delay = std::chrono::milliseconds(static_cast<int64_t>(backoffMs * jitter(jitterEngine)));
+	nextAttemptAt = std::chrono::steady_clock::now() + delay;
+
+	int attempts = 0;
+	auto it = pending.find(id);
+	if (it != pending.end()) {
+		attempts = ++it->second.attempts;
+	}
+	std::cerr << "[Outbox] 전송 실패, " << delay.count() << "ms 후 재시도: " << id << " (실패 "
+						<< attempts << "회)" << std::endl;
+}
+
+bool UploadOutbox::nextAttemptTime(std::chrono::steady_clock::time_point& time) const {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	if (pending.empty()) {
+		return false;
+	}
+	time = nextAttemptAt;
+	return true;
+}
+
+size_t UploadOutbox::pendingCount() const {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	return pending.size();
+}
+
+uint64_t UploadOutbox::getPendingBytes() const {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	return pendingBytes;
+}
+
+uint64_t UploadOutbox::getEvictedCount() const {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	return evictedCount;
+}
+
+uint64_t UploadOutbox::getCoalescedCount() const {
+	std::lock_guard<std::mutex> lock(outboxMutex);
+	return coalescedCount;
+}
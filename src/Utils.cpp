@@ -6,6 +6,11 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 namespace fs = std::filesystem;
 
 void setEnvVar(const std::string& key, const std::string& value) {
@@ -16,6 +21,24 @@ void setEnvVar(const std::string& key, const std::string& value) {
 #endif
 }
 
+bool setThreadAffinity(std::thread& thread, int core) {
+#ifdef __linux__
+	unsigned int coreCount = std::thread::hardware_concurrency();
+	if (coreCount == 0) {
+		return false;
+	}
+
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(core % coreCount, &cpuset);
+	return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+	(void)thread;
+	(void)core;
+	return false;
+#endif
+}
+
 Utils::Utils(const std::string& saveDirectory)
 		: saveDirectory(saveDirectory), recentFolder("/recent"), sleepFolder("") {
 	if (!std::filesystem::exists(saveDirectory)) {
@@ -1,85 +1,306 @@
 #include "../include/VideoEncoder.h"
 
+#include <openssl/evp.h>
+
+#include <algorithm>
 #include <chrono>
-#include <filesystem>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include <sstream>
 #include <vector>
 
-std::vector<uchar> VideoEncoder::convertFramesToMP4(const std::string& path) {
-	std::vector<cv::String> framePaths;
-	std::vector<uchar> videoBuffer;
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/opt.h>
+#include <libswscale/swscale.h>
+}
+
+namespace {
+// 하드웨어 인코더(라즈베리파이 V4L2 M2M) 우선, 없으면 소프트웨어 인코더 사용
+const char* const ENCODER_CANDIDATES[] = {"h264_v4l2m2m", "libx264", "mpeg4"};
+const int AVIO_BUFFER_SIZE = 64 * 1024;
+
+std::string avErrorString(int error) {
+	char buffer[AV_ERROR_MAX_STRING_SIZE] = {0};
+	av_strerror(error, buffer, sizeof(buffer));
+	return buffer;
+}
+
+// 먹서 출력 대상: 메모리 버퍼 + 기록과 동시에 갱신되는 SHA256 다이제스트
+struct OutputSink {
+	std::vector<uchar>* buffer = nullptr;
+	EVP_MD_CTX* digest = nullptr;
+	bool digestFailed = false;
+};
+
+// 먹싱된 바이트를 출력 버퍼 뒤에 이어 붙임 (fragmented MP4 는 seek 없이 순차 기록)
+#if LIBAVFORMAT_VERSION_MAJOR >= 61
+int writePacket(void* opaque, const uint8_t* data, int size) {
+#else
+int writePacket(void* opaque, uint8_t* data, int size) {
+#endif
+	auto* sink = static_cast<OutputSink*>(opaque);
+	sink->buffer->insert(sink->buffer->end(), data, data + size);
+	if (EVP_DigestUpdate(sink->digest, data, size) != 1) {
+		sink->digestFailed = true;
+	}
+	return size;
+}
+
+std::string finalizeDigest(EVP_MD_CTX* digest) {
+	unsigned char hash[EVP_MAX_MD_SIZE];
+	unsigned int hashLength = 0;
+	if (EVP_DigestFinal_ex(digest, hash, &hashLength) != 1) {
+		return "";
+	}
+
+	// 바이트를 16진수 문자열로 변환
+	std::stringstream ss;
+	for (unsigned int i = 0; i < hashLength; i++) {
+		ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+	}
+	return ss.str();
+}
+
+// 인코딩 중 할당한 libav 객체를 한 번에 해제
+struct EncoderContext {
+	AVFormatContext* format = nullptr;
+	AVIOContext* io = nullptr;
+	AVCodecContext* codec = nullptr;
+	AVStream* stream = nullptr;
+	AVFrame* frame = nullptr;
+	AVPacket* packet = nullptr;
+	SwsContext* sws = nullptr;
+	EVP_MD_CTX* digest = nullptr;
 
-	// 현재 폴더 안의 이미지 파일만 정렬해서 수집
-	for (const auto& entry : std::filesystem::directory_iterator(path)) {
-		if (entry.path().extension() == ".jpg" || entry.path().extension() == ".png") {
-			framePaths.push_back(entry.path().string());
+	~EncoderContext() {
+		EVP_MD_CTX_free(digest);
+		sws_freeContext(sws);
+		av_packet_free(&packet);
+		av_frame_free(&frame);
+		avcodec_free_context(&codec);
+		if (io) {
+			av_freep(&io->buffer);
+			avio_context_free(&io);
 		}
+		avformat_free_context(format);
 	}
+};
 
-	if (framePaths.empty()) {
-		std::cerr << "선택된 폴더에 이미지가 없음" << std::endl;
+AVCodecContext* openEncoder(const AVFormatContext* format, int width, int height, int frameRate,
+														int bitRate) {
+	for (const char* name : ENCODER_CANDIDATES) {
+		const AVCodec* codec = avcodec_find_encoder_by_name(name);
+		if (!codec) {
+			continue;
+		}
+
+		AVCodecContext* context = avcodec_alloc_context3(codec);
+		if (!context) {
+			continue;
+		}
+		context->width = width;
+		context->height = height;
+		// 처리 모드/프레임 드롭으로 간격이 일정하지 않으므로 캡처 시각(밀리초) 을 그대로 PTS 로 사용
+		context->time_base = AVRational{1, 1000};
+		context->framerate = AVRational{frameRate, 1};	// 평균 프레임률 (비트레이트 제어용)
+		context->pix_fmt = AV_PIX_FMT_YUV420P;
+		context->bit_rate = bitRate;
+		context->gop_size = frameRate;	// 1초마다 키프레임 (프래그먼트 단위)
+		context->max_b_frames = 0;
+		if (format->oformat->flags & AVFMT_GLOBALHEADER) {
+			context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+		}
+		if (std::string(name) == "libx264") {
+			av_opt_set(context->priv_data, "preset", "veryfast", 0);
+			av_opt_set(context->priv_data, "tune", "zerolatency", 0);
+		}
+
+		int result = avcodec_open2(context, codec, nullptr);
+		if (result == 0) {
+			return context;
+		}
+		std::cerr << "인코더 열기 실패 (" << name << "): " << avErrorString(result) << std::endl;
+		avcodec_free_context(&context);
+	}
+	return nullptr;
+}
+
+// 인코더에서 나온 패킷을 모두 먹서로 전달
+bool drainPackets(EncoderContext& ctx) {
+	while (true) {
+		int result = avcodec_receive_packet(ctx.codec, ctx.packet);
+		if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
+			return true;
+		}
+		if (result < 0) {
+			std::cerr << "패킷 수신 실패: " << avErrorString(result) << std::endl;
+			return false;
+		}
+
+		av_packet_rescale_ts(ctx.packet, ctx.codec->time_base, ctx.stream->time_base);
+		ctx.packet->stream_index = ctx.stream->index;
+		result = av_interleaved_write_frame(ctx.format, ctx.packet);
+		av_packet_unref(ctx.packet);
+		if (result < 0) {
+			std::cerr << "패킷 기록 실패: " << avErrorString(result) << std::endl;
+			return false;
+		}
+	}
+}
+}	 // namespace
+
+std::vector<uchar> VideoEncoder::encodeToMP4(const std::vector<BufferedFrame>& frames) {
+	auto start = std::chrono::steady_clock::now();
+	std::vector<uchar> videoBuffer;
+	lastChecksum.clear();
+
+	if (frames.empty()) {
+		std::cerr << "인코딩할 프레임이 없음" << std::endl;
 		return videoBuffer;
 	}
 
-	// 파일 이름을 기준으로 정렬
-	std::sort(framePaths.begin(), framePaths.end());
-
-	const cv::Size frameSize(1280, 720);
-	auto tmp = std::filesystem::temp_directory_path() /
-						 ("video_" +
-							std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".mp4");
-	std::string tempVideoPath = tmp.string();
-	std::string fixedVideoPath = tempVideoPath + "_fixed.mp4";
-
-	// OpenCV로 MP4 생성
-	cv::VideoWriter writer(tempVideoPath, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), frameRate,
-												 frameSize);
-	for (const auto& frame : framePaths) {
-		cv::Mat img = cv::imread(frame);
-		if (img.empty()) continue;
-		cv::resize(img, img, frameSize);
-		writer.write(img);
-	}
-	writer.release();
-
-	// ffmpeg 후처리: moov atom 앞으로 이동
-	std::string command =
-			"ffmpeg -y -i \"" + tempVideoPath + "\" -movflags faststart \"" + fixedVideoPath + "\"";
-	int result = std::system(command.c_str());
-	if (result != 0) {
-		std::cerr << "ffmpeg 실행 실패" << std::endl;
-		std::filesystem::remove(tempVideoPath);
+	// 2~5초 분량 720p H.264 기준으로 미리 확보
+	videoBuffer.reserve(static_cast<size_t>(bitRate / 8) * 5);
+
+	EncoderContext ctx;
+	if (avformat_alloc_output_context2(&ctx.format, nullptr, "mp4", nullptr) < 0 || !ctx.format) {
+		std::cerr << "MP4 먹서 생성 실패" << std::endl;
 		return videoBuffer;
 	}
 
-	// fixed mp4 파일을 메모리로 읽기
-	std::ifstream fixedVideoFile(fixedVideoPath, std::ios::binary | std::ios::ate);
-	if (!fixedVideoFile) {
-		std::cerr << "fixed 비디오 파일을 읽을 수 없음" << std::endl;
-		std::filesystem::remove(tempVideoPath);
-		std::filesystem::remove(fixedVideoPath);
+	ctx.codec = openEncoder(ctx.format, resolution.width, resolution.height, frameRate, bitRate);
+	if (!ctx.codec) {
+		std::cerr << "사용 가능한 영상 인코더가 없음" << std::endl;
 		return videoBuffer;
 	}
+	lastCodecName = ctx.codec->codec->name;
 
-	std::streamsize size = fixedVideoFile.tellg();
-	fixedVideoFile.seekg(0, std::ios::beg);
+	ctx.stream = avformat_new_stream(ctx.format, nullptr);
+	if (!ctx.stream || avcodec_parameters_from_context(ctx.stream->codecpar, ctx.codec) < 0) {
+		std::cerr << "영상 스트림 생성 실패" << std::endl;
+		return videoBuffer;
+	}
+	ctx.stream->time_base = ctx.codec->time_base;
+
+	// 체크섬은 먹서가 바이트를 내보낼 때마다 갱신 (전송 재시도마다 다시 계산하지 않음)
+	ctx.digest = EVP_MD_CTX_new();
+	if (!ctx.digest || EVP_DigestInit_ex(ctx.digest, EVP_sha256(), nullptr) != 1) {
+		std::cerr << "SHA256 초기화 실패" << std::endl;
+		return videoBuffer;
+	}
+	OutputSink sink{&videoBuffer, ctx.digest};
+
+	// 출력 버퍼로 바로 기록하는 AVIO (쓰기 전용, seek 불가)
+	auto* ioBuffer = static_cast<unsigned char*>(av_malloc(AVIO_BUFFER_SIZE));
+	if (!ioBuffer) {
+		std::cerr << "AVIO 버퍼 할당 실패" << std::endl;
+		return videoBuffer;
+	}
+	ctx.io = avio_alloc_context(ioBuffer, AVIO_BUFFER_SIZE, 1, &sink, nullptr, writePacket,
+															nullptr);
+	if (!ctx.io) {
+		av_free(ioBuffer);
+		std::cerr << "AVIO 컨텍스트 생성 실패" << std::endl;
+		return videoBuffer;
+	}
+	ctx.format->pb = ctx.io;
+	ctx.format->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+	// moov 를 맨 앞에 두고 키프레임마다 프래그먼트를 끊어 한 번에 순차 기록
+	AVDictionary* muxerOptions = nullptr;
+	av_dict_set(&muxerOptions, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0);
+	int result = avformat_write_header(ctx.format, &muxerOptions);
+	av_dict_free(&muxerOptions);
+	if (result < 0) {
+		std::cerr << "MP4 헤더 기록 실패: " << avErrorString(result) << std::endl;
+		videoBuffer.clear();
+		return videoBuffer;
+	}
+
+	ctx.frame = av_frame_alloc();
+	ctx.packet = av_packet_alloc();
+	ctx.sws = sws_getContext(resolution.width, resolution.height, AV_PIX_FMT_BGR24, resolution.width,
+													 resolution.height, AV_PIX_FMT_YUV420P, SWS_BILINEAR, nullptr, nullptr,
+													 nullptr);
+	if (!ctx.frame || !ctx.packet || !ctx.sws) {
+		std::cerr << "프레임 변환 컨텍스트 생성 실패" << std::endl;
+		videoBuffer.clear();
+		return videoBuffer;
+	}
+	ctx.frame->format = AV_PIX_FMT_YUV420P;
+	ctx.frame->width = resolution.width;
+	ctx.frame->height = resolution.height;
+	if (av_frame_get_buffer(ctx.frame, 0) < 0) {
+		std::cerr << "프레임 버퍼 할당 실패" << std::endl;
+		videoBuffer.clear();
+		return videoBuffer;
+	}
+
+	cv::Mat decoded;
+	int64_t encodedFrames = 0;
+	int64_t lastPts = -1;
+	const int64_t firstTimestampMs = frames.front().timestampMs;
+	for (const auto& bufferedFrame : frames) {
+		// 링 버퍼에 보관된 JPEG 바이트를 바로 디코딩 (파일 읽기 없음)
+		cv::imdecode(bufferedFrame.jpeg, cv::IMREAD_COLOR, &decoded);
+		if (decoded.empty()) {
+			std::cerr << "프레임 디코딩 실패: " << bufferedFrame.name << std::endl;
+			continue;
+		}
+		if (decoded.size() != resolution) {
+			cv::resize(decoded, decoded, resolution);
+		}
+
+		if (av_frame_make_writable(ctx.frame) < 0) {
+			std::cerr << "프레임 버퍼 재사용 실패" << std::endl;
+			break;
+		}
+		const uint8_t* sourceData[1] = {decoded.data};
+		const int sourceStride[1] = {static_cast<int>(decoded.step)};
+		sws_scale(ctx.sws, sourceData, sourceStride, 0, resolution.height, ctx.frame->data,
+							ctx.frame->linesize);
+		// 캡처 간격대로 재생되도록 첫 프레임 기준 경과 시간 사용 (같거나 되돌아간 시각은 1ms 뒤로)
+		int64_t pts = std::max(bufferedFrame.timestampMs - firstTimestampMs, lastPts + 1);
+		ctx.frame->pts = pts;
+		lastPts = pts;
+		encodedFrames++;
+
+		result = avcodec_send_frame(ctx.codec, ctx.frame);
+		if (result < 0) {
+			std::cerr << "프레임 인코딩 실패: " << avErrorString(result) << std::endl;
+			break;
+		}
+		if (!drainPackets(ctx)) {
+			break;
+		}
+	}
+
+	// 인코더에 남은 패킷을 비우고 마지막 프래그먼트 기록
+	avcodec_send_frame(ctx.codec, nullptr);
+	bool flushed = drainPackets(ctx);
+	result = av_write_trailer(ctx.format);
+	avio_flush(ctx.io);
+
+	if (encodedFrames == 0 || !flushed || result < 0) {
+		std::cerr << "영상 인코딩 실패" << std::endl;
+		videoBuffer.clear();
+		return videoBuffer;
+	}
 
-	videoBuffer.resize(size);
-	if (!fixedVideoFile.read(reinterpret_cast<char*>(videoBuffer.data()), size)) {
-		std::cerr << "fixed 비디오 파일을 메모리에 로드하는 데 실패" << std::endl;
-		fixedVideoFile.close();
-		std::filesystem::remove(tempVideoPath);
-		std::filesystem::remove(fixedVideoPath);
+	lastChecksum = sink.digestFailed ? "" : finalizeDigest(ctx.digest);
+	if (lastChecksum.empty()) {
+		std::cerr << "체크섬 계산 실패" << std::endl;
+		videoBuffer.clear();
 		return videoBuffer;
 	}
 
-	fixedVideoFile.close();
-	std::filesystem::remove(tempVideoPath);
-	std::filesystem::remove(fixedVideoPath);
+	lastEncodeMs =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "영상 인코딩 완료: " << encodedFrames << " 프레임, " << videoBuffer.size() << " bytes, "
+						<< lastEncodeMs << "ms (" << lastCodecName << ")" << std::endl;
 
 	return videoBuffer;
-}
\ No newline at end of file
+}
@@ -1,26 +1,34 @@
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <thread>
 
 #include "../include/AccelerationSensor.h"
 
-void testRealAccelerationSensor() {
-	std::cout << "========== Testing RealAccelerationSensor ==========" << std::endl;
+void testAdxl345Sensor() {
+	std::cout << "========== Testing Adxl345Sensor ==========" << std::endl;
 
-	// Create a real acceleration sensor
-	RealAccelerationSensor sensor;
+	// Create a native I2C acceleration sensor
+	Adxl345Sensor sensor;
+	if (!sensor.open()) {
+		std::cout << "ADXL345 not connected, skipped." << std::endl;
+		return;
+	}
 
 	// Test isMoving and getAcceleration every second for 10 seconds
 	for (int i = 0; i < 10; i++) {
 		// Get acceleration data
-		std::vector<float> accel = sensor.getAcceleration();
+		AccelerationSample accel = sensor.getAcceleration();
 
 		// Check if moving
 		bool moving = sensor.isMoving();
 
 		// Print results
 		std::cout << "Test #" << (i + 1) << ":" << std::endl;
-		std::cout << "  Acceleration: X=" << accel[0] << ", Y=" << accel[1] << ", Z=" << accel[2]
+		std::cout << "  Acceleration: X=" << accel.x << ", Y=" << accel.y << ", Z=" << accel.z
 							<< std::endl;
 		std::cout << "  Moving: " << (moving ? "YES" : "NO") << std::endl;
 
@@ -31,6 +39,53 @@ void testRealAccelerationSensor() {
 	std::cout << "Test completed." << std::endl;
 }
 
+void testReplayAccelerationSensor() {
+	std::cout << "========== Testing ReplayAccelerationSensor ==========" << std::endl;
+
+	// 정차 -> 출발 충격 -> 주행 순서의 짧은 궤적 (moving 열이 없는 줄은 activity 임계값으로 판정)
+	const std::string path = "/tmp/accel_replay_test.csv";
+	{
+		std::ofstream trace(path);
+		trace << "# timestamp_ms,x,y,z,moving\n";
+		trace << "timestamp_ms,x,y,z,moving\n";
+		trace << "0,0.0,0.0,9.8,0\n";
+		trace << "10,0.0,0.0,9.8,0\n";
+		trace << "20,12.5,0.0,9.8\n";
+		trace << "30,0.5,0.3,9.8,1\n";
+	}
+
+	ReplayAccelerationSensor sensor(path, false, true);
+	if (!sensor.open() || sensor.getTraceLength() != 4) {
+		throw std::runtime_error("replay trace not loaded");
+	}
+
+	AccelerationSample samples[8];
+	if (sensor.readSamples(samples, 2) != 2 || sensor.isMoving()) {
+		throw std::runtime_error("stationary samples reported as moving");
+	}
+	if (samples[1].timestampUs - samples[0].timestampUs != 10000) {
+		throw std::runtime_error("replay timestamps not preserved");
+	}
+
+	AccelerationSample bump = sensor.getAcceleration();
+	if (!bump.activity || std::fabs(bump.x - 12.5f) > 1e-4f || !sensor.isMoving()) {
+		throw std::runtime_error("activity threshold not applied");
+	}
+	if (sensor.isMoving()) {
+		throw std::runtime_error("activity not cleared after read");
+	}
+
+	// 반복 재생 시 타임스탬프는 계속 증가
+	size_t count = sensor.readSamples(samples, 3);
+	if (count != 3 || samples[1].timestampUs <= samples[0].timestampUs ||
+			samples[1].timestampUs - samples[0].timestampUs != 10000) {
+		throw std::runtime_error("loop playback timestamps not monotonic");
+	}
+
+	std::remove(path.c_str());
+	std::cout << "Test completed." << std::endl;
+}
+
 void testMockAccelerationSensor() {
 	std::cout << "========== Testing MockAccelerationSensor ==========" << std::endl;
 
@@ -41,10 +96,10 @@ void testMockAccelerationSensor() {
 	std::cout << "Testing stationary state:" << std::endl;
 	sensor.setMoving(false);
 
-	std::vector<float> accel = sensor.getAcceleration();
+	AccelerationSample accel = sensor.getAcceleration();
 	bool moving = sensor.isMoving();
 
-	std::cout << "  Acceleration: X=" << accel[0] << ", Y=" << accel[1] << ", Z=" << accel[2]
+	std::cout << "  Acceleration: X=" << accel.x << ", Y=" << accel.y << ", Z=" << accel.z
 						<< std::endl;
 	std::cout << "  Moving: " << (moving ? "YES" : "NO") << std::endl;
 
@@ -54,7 +109,7 @@ void testMockAccelerationSensor() {
 	accel = sensor.getAcceleration();
 	moving = sensor.isMoving();
 
-	std::cout << "  Acceleration: X=" << accel[0] << ", Y=" << accel[1] << ", Z=" << accel[2]
+	std::cout << "  Acceleration: X=" << accel.x << ", Y=" << accel.y << ", Z=" << accel.z
 						<< std::endl;
 	std::cout << "  Moving: " << (moving ? "YES" : "NO") << std::endl;
 
@@ -64,15 +119,15 @@ void testMockAccelerationSensor() {
 void testAccelerationSensor() {
 	std::cout << "========== Testing AccelerationSensor ==========" << std::endl;
 
-	// Test with real sensor
+	// Test with real sensor (ACCEL_SOURCE 에 따라 ADXL345 또는 궤적 재생)
 	std::cout << "Using real sensor:" << std::endl;
 	AccelerationSensor realSensor(false);
 	realSensor.initialize();
 
-	std::vector<float> accel = realSensor.getAcceleration();
+	AccelerationSample accel = realSensor.getAcceleration();
 	bool moving = realSensor.isMoving();
 
-	std::cout << "  Acceleration: X=" << accel[0] << ", Y=" << accel[1] << ", Z=" << accel[2]
+	std::cout << "  Acceleration: X=" << accel.x << ", Y=" << accel.y << ", Z=" << accel.z
 						<< std::endl;
 	std::cout << "  Moving: " << (moving ? "YES" : "NO") << std::endl;
 
@@ -84,7 +139,7 @@ void testAccelerationSensor() {
 	accel = mockSensor.getAcceleration();
 	moving = mockSensor.isMoving();
 
-	std::cout << "  Acceleration: X=" << accel[0] << ", Y=" << accel[1] << ", Z=" << accel[2]
+	std::cout << "  Acceleration: X=" << accel.x << ", Y=" << accel.y << ", Z=" << accel.z
 						<< std::endl;
 	std::cout << "  Moving: " << (moving ? "YES" : "NO") << std::endl;
 
@@ -96,8 +151,11 @@ int runTests() {
 	std::cout << "Starting acceleration sensor tests..." << std::endl;
 
 	try {
-		// Test RealAccelerationSensor directly
-		testRealAccelerationSensor();
+		// Test Adxl345Sensor directly
+		testAdxl345Sensor();
+
+		// Test ReplayAccelerationSensor with a recorded trace
+		testReplayAccelerationSensor();
 
 		// Test MockAccelerationSensor
 		testMockAccelerationSensor();
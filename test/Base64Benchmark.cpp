@@ -0,0 +1,121 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/Base64.h"
+#include "../include/SleepinessDetector.h"
+
+namespace {
+// 기존 구현 (push_back 누적) - 결과 비교 및 속도 기준
+std::string legacyBase64Encode(const std::string& input) {
+	const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string encoded;
+	int val = 0;
+	int valb = -6;
+
+	for (unsigned char c : input) {
+		val = (val << 8) + c;
+		valb += 8;
+		while (valb >= 0) {
+			encoded.push_back(chars[(val >> valb) & 0x3F]);
+			valb -= 6;
+		}
+	}
+
+	if (valb > -6) {
+		encoded.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+	}
+
+	while (encoded.size() % 4) {
+		encoded.push_back('=');
+	}
+
+	return encoded;
+}
+
+// 기존 sendDriverFrame 의 본문 생성 경로 (string 복사 -> base64 -> json -> dump)
+std::string legacyFramePayload(const std::string& deviceUid, int frameIdx,
+															 const std::vector<uchar>& jpeg) {
+	std::string base64Image = legacyBase64Encode(std::string(jpeg.begin(), jpeg.end()));
+	nlohmann::json jsonData = {
+			{"deviceUid", deviceUid}, {"frameIdx", frameIdx}, {"driverFrame", base64Image}};
+	return jsonData.dump();
+}
+
+template <typename Func>
+double measureAverageUs(Func func, int iterations) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		func();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+}	 // namespace
+
+int runBase64Benchmark() {
+	std::cout << "===== Base64 / 프레임 본문 생성 벤치마크 (" << base64Implementation() << ") ====="
+						<< std::endl;
+
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+
+	// 경계 길이(0~200바이트)에서 기존 구현과 결과 비교
+	for (size_t size = 0; size <= 200; ++size) {
+		std::vector<uchar> data(size);
+		for (auto& b : data) {
+			b = static_cast<uchar>(byteDist(rng));
+		}
+		std::string encoded;
+		base64Append(data.data(), data.size(), encoded);
+		if (encoded != legacyBase64Encode(std::string(data.begin(), data.end()))) {
+			std::cerr << "인코딩 결과 불일치 (길이 " << size << ")" << std::endl;
+			return 1;
+		}
+	}
+
+	// 실제 업링크 JPEG 크기 구간 (50~300KB)
+	const std::string deviceUid = "benchmark-device";
+	const int iterations = 50;
+	std::cout << std::fixed << std::setprecision(1);
+	for (size_t kb : {50, 100, 200, 300}) {
+		std::vector<uchar> jpeg(kb * 1024);
+		for (auto& b : jpeg) {
+			b = static_cast<uchar>(byteDist(rng));
+		}
+
+		std::string payload;
+		SleepinessDetector::buildFramePayload(deviceUid, 7, jpeg, payload);
+		if (nlohmann::json::parse(payload) != nlohmann::json::parse(legacyFramePayload(deviceUid, 7, jpeg))) {
+			std::cerr << "본문 불일치 (" << kb << "KB)" << std::endl;
+			return 1;
+		}
+
+		std::string encoded;
+		double legacyEncodeUs = measureAverageUs(
+				[&] { encoded = legacyBase64Encode(std::string(jpeg.begin(), jpeg.end())); }, iterations);
+		double encodeUs = measureAverageUs(
+				[&] {
+					encoded.clear();
+					base64Append(jpeg.data(), jpeg.size(), encoded);
+				},
+				iterations);
+		double legacyPayloadUs =
+				measureAverageUs([&] { payload = legacyFramePayload(deviceUid, 7, jpeg); }, iterations);
+		double payloadUs = measureAverageUs(
+				[&] { SleepinessDetector::buildFramePayload(deviceUid, 7, jpeg, payload); }, iterations);
+
+		double mb = static_cast<double>(jpeg.size()) / (1024.0 * 1024.0);
+		std::cout << std::setw(4) << kb << "KB | base64 기존 " << legacyEncodeUs << "us ("
+							<< mb / (legacyEncodeUs / 1e6) << "MB/s), 신규 " << encodeUs << "us ("
+							<< mb / (encodeUs / 1e6) << "MB/s) | 본문 기존 " << legacyPayloadUs << "us, 신규 "
+							<< payloadUs << "us (x" << legacyPayloadUs / payloadUs << ")" << std::endl;
+	}
+
+	std::cout << "Base64 벤치마크 완료" << std::endl;
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+#include "../include/CaptureSource.h"
+
+namespace {
+// 프레임 번호를 밝기로 기록한 합성 영상 파일 생성 (카메라 대신 반복 재생용)
+bool writeSyntheticVideo(const std::string& path, int frameCount, const cv::Size& size) {
+	cv::VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 24, size);
+	if (!writer.isOpened()) {
+		return false;
+	}
+	for (int i = 0; i < frameCount; ++i) {
+		cv::Mat frame(size, CV_8UC3, cv::Scalar::all(20 + i * 20));
+		writer.write(frame);
+	}
+	return true;
+}
+}	 // namespace
+
+int runCaptureSourceTest() {
+	std::cout << "CaptureSource 테스트 시작..." << std::endl;
+
+	// 1. 파일 반복 재생: 파일 끝에서 처음 프레임으로 돌아와야 함
+	const std::string videoPath = "/tmp/nosleep_capture_test.avi";
+	const int frameCount = 5;
+	if (!writeSyntheticVideo(videoPath, frameCount, cv::Size(320, 240))) {
+		std::cerr << "합성 영상 생성 실패" << std::endl;
+		return 1;
+	}
+
+	VideoCaptureSource fileSource(videoPath, cv::CAP_ANY, true);
+	if (!fileSource.open()) {
+		std::cerr << "파일 소스 열기 실패" << std::endl;
+		return 1;
+	}
+
+	std::vector<double> brightness;
+	for (int i = 0; i < frameCount * 2; ++i) {
+		CapturedFrame frame;
+		if (!fileSource.read(frame) || frame.image.size() != cv::Size(320, 240)) {
+			std::cerr << "파일 소스 읽기 실패 (" << i << ")" << std::endl;
+			return 1;
+		}
+		brightness.push_back(cv::mean(frame.image)[0]);
+	}
+	if (std::abs(brightness[0] - brightness[frameCount]) > 4.0) {
+		std::cerr << "반복 재생 시 첫 프레임으로 돌아오지 않음" << std::endl;
+		return 1;
+	}
+	std::cout << "파일 반복 재생 " << brightness.size() << "프레임 확인" << std::endl;
+
+#ifdef USE_GSTREAMER
+	// 2. 루프백 파이프라인: 버퍼를 붙잡고 있는 동안은 복사 없이, 한도를 넘으면 복사로 전환
+	GstCaptureSource gstSource(
+			"videotestsrc num-buffers=30 pattern=gradient ! "
+			"video/x-raw,format=NV12,width=640,height=360,framerate=30/1 ! "
+			"appsink name=sink max-buffers=2 sync=false",
+			2);
+	if (!gstSource.open()) {
+		std::cerr << "GStreamer 루프백 파이프라인 열기 실패" << std::endl;
+		return 1;
+	}
+
+	std::vector<CapturedFrame> held(4);
+	for (auto& frame : held) {
+		if (!gstSource.read(frame) || frame.image.size() != cv::Size(640, 360) ||
+				frame.evidence.rows != 540) {
+			std::cerr << "GStreamer 프레임 읽기 실패" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "zero-copy " << gstSource.getZeroCopyFrames() << ", copied "
+						<< gstSource.getCopiedFrames() << std::endl;
+	if (gstSource.getZeroCopyFrames() != 2 || gstSource.getCopiedFrames() != 2 || !held[0].owner ||
+			held[3].owner) {
+		std::cerr << "버퍼 보유 한도 처리 오류" << std::endl;
+		return 1;
+	}
+
+	// 버퍼를 돌려주면 다시 복사 없이 받음
+	held.clear();
+	CapturedFrame frame;
+	if (!gstSource.read(frame) || !frame.owner) {
+		std::cerr << "버퍼 반환 후 zero-copy 로 돌아오지 않음" << std::endl;
+		return 1;
+	}
+	gstSource.close();
+
+	// 3. 2-스트림 루프백: 같은 타임스탬프의 720p 근거 프레임이 짝지어져야 함
+	GstCaptureSource dualSource(
+			"videotestsrc num-buffers=30 ! video/x-raw,format=NV12,width=1280,height=720,framerate=30/1 ! "
+			"tee name=t t. ! queue ! videoscale ! video/x-raw,width=640,height=360 ! "
+			"appsink name=sink max-buffers=2 sync=false "
+			"t. ! queue ! appsink name=evidence max-buffers=2 sync=false",
+			2);
+	if (!dualSource.open()) {
+		std::cerr << "GStreamer 2-스트림 파이프라인 열기 실패" << std::endl;
+		return 1;
+	}
+	for (int i = 0; i < 10; ++i) {
+		CapturedFrame dualFrame;
+		if (!dualSource.read(dualFrame) || dualFrame.image.size() != cv::Size(640, 360)) {
+			std::cerr << "GStreamer 2-스트림 프레임 읽기 실패" << std::endl;
+			return 1;
+		}
+		if (dualFrame.evidence.size() != cv::Size(1280, 1080)) {
+			std::cerr << "근거 프레임 짝 맞춤 실패 (" << i << ")" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "2-스트림 unmatched " << dualSource.getUnmatchedFrames() << std::endl;
+	dualSource.close();
+#endif
+
+	std::cout << "CaptureSource 테스트 완료" << std::endl;
+	return 0;
+}
@@ -0,0 +1,143 @@
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+#include "../include/EarCalibrator.h"
+
+int runEarCalibratorTest() {
+	std::cout << "EarCalibrator 테스트 시작..." << std::endl;
+
+	const std::string directory = "/tmp/nosleep_ear_profile_test";
+	std::filesystem::remove_all(directory);
+
+	// 뜬 눈 EAR 0.32, 감은 눈(깜빡임) 0.12 인 운전자, 10% 가 감긴 프레임
+	std::mt19937 engine(7);
+	std::normal_distribution<float> openDist(0.32f, 0.02f);
+	std::normal_distribution<float> closedDist(0.12f, 0.02f);
+	auto sampleEar = [&](int i) { return i % 10 == 0 ? closedDist(engine) : openDist(engine); };
+
+	// 1. 보정 구간 전에는 기본 임계값, 이후 두 중심의 중간값
+	EarCalibrator calibrator("driver-a", directory, 10000, 200);
+	int64_t now = 0;
+	for (int i = 0; i < 200; ++i, now += 42) {
+		calibrator.addSample(now, sampleEar(i), true);
+		calibrator.addSample(now, 0.05f, false);	// 얼굴 미검출 프레임은 무시
+	}
+	if (calibrator.isCalibrated() || calibrator.getThreshold() != 0.25f) {
+		std::cerr << "보정 구간 이전 임계값 오류" << std::endl;
+		return 1;
+	}
+	for (int i = 200; i < 480; ++i, now += 42) {
+		calibrator.addSample(now, sampleEar(i), true);
+	}
+	EarProfile profile = calibrator.getProfile();
+	std::cout << "보정 임계값 " << profile.threshold << " (뜬 눈 " << profile.openEar << ", 감은 눈 "
+						<< profile.closedEar << ")" << std::endl;
+	if (!calibrator.isCalibrated() || std::fabs(profile.threshold - 0.22f) > 0.02f) {
+		std::cerr << "보정 임계값 오류" << std::endl;
+		return 1;
+	}
+
+	// 2. 주행 중 EAR 이 서서히 내려가도 (피로 추세) 임계값은 내려가지 않음
+	const float calibratedThreshold = profile.threshold;
+	const int FRAMES_PER_MINUTE = 24 * 60;
+	for (int i = 0; i < 20 * FRAMES_PER_MINUTE; ++i, now += 42) {
+		float open = 0.32f - 0.08f * i / (20 * FRAMES_PER_MINUTE) + openDist(engine) - 0.32f;
+		calibrator.addSample(now, i % 10 == 0 ? closedDist(engine) : open, true);
+		if (i % FRAMES_PER_MINUTE == 0 && calibrator.getThreshold() != calibratedThreshold) {
+			std::cerr << "주행 중 임계값이 바뀜" << std::endl;
+			return 1;
+		}
+	}
+	calibrator.endTrip();
+	if (calibrator.getThreshold() != calibratedThreshold) {
+		std::cerr << "하강 추세를 학습함: " << calibrator.getThreshold() << std::endl;
+		return 1;
+	}
+
+	// 졸음 신호(긴 감김/PERCLOS/졸음 상태) 가 있던 구간은 반영하지 않음
+	std::normal_distribution<float> narrowDist(0.26f, 0.02f);
+	for (int i = 0; i < 10 * FRAMES_PER_MINUTE; ++i, now += 42) {
+		calibrator.addSample(now, i % 10 == 0 ? closedDist(engine) : narrowDist(engine), true, true);
+	}
+	calibrator.endTrip();
+	if (calibrator.getThreshold() != calibratedThreshold) {
+		std::cerr << "졸음 구간을 학습함: " << calibrator.getThreshold() << std::endl;
+		return 1;
+	}
+
+	// 3. 주행 내내 일정하게 작아진 눈(0.26) 은 주행마다 조금씩, 최초 보정값 ± MAX_DRIFT 안에서만 반영
+	float previous = calibratedThreshold;
+	for (int trip = 0; trip < 20; ++trip) {
+		for (int i = 0; i < 10 * FRAMES_PER_MINUTE; ++i, now += 42) {
+			calibrator.addSample(now, i % 10 == 0 ? closedDist(engine) : narrowDist(engine), true);
+		}
+		calibrator.endTrip();
+		float threshold = calibrator.getThreshold();
+		if (std::fabs(threshold - previous) > 0.01f) {
+			std::cerr << "주행 간 적응 폭 오류: " << previous << " -> " << threshold << std::endl;
+			return 1;
+		}
+		previous = threshold;
+	}
+	profile = calibrator.getProfile();
+	std::cout << "주행 간 적응 임계값 " << profile.threshold << " (뜬 눈 " << profile.openEar
+						<< ", 기준 " << profile.baselineOpenEar << ")" << std::endl;
+	if (profile.threshold >= calibratedThreshold ||
+			std::fabs(profile.openEar - profile.baselineOpenEar) > 0.03f + 1e-4f ||
+			std::fabs(profile.closedEar - profile.baselineClosedEar) > 0.03f + 1e-4f) {
+		std::cerr << "적응 한계 오류" << std::endl;
+		return 1;
+	}
+	float adapted = profile.threshold;
+
+	// 절약 모드(8fps) 로 캡처해도 구간이 채워져 주행 간 적응이 동작
+	EarCalibrator economy("driver-d", directory, 10000, 200);
+	int64_t economyNow = 0;
+	for (int i = 0; i < 480; ++i, economyNow += 42) {
+		economy.addSample(economyNow, sampleEar(i), true);
+	}
+	float economyCalibrated = economy.getThreshold();
+	for (int i = 0; i < 10 * 8 * 60; ++i, economyNow += 125) {
+		economy.addSample(economyNow, i % 10 == 0 ? closedDist(engine) : narrowDist(engine), true);
+	}
+	economy.endTrip();
+	if (!economy.isCalibrated() || economy.getThreshold() >= economyCalibrated) {
+		std::cerr << "8fps 주행 적응 오류: " << economyCalibrated << " -> " << economy.getThreshold()
+							<< std::endl;
+		return 1;
+	}
+
+	// 4. 저장한 프로필을 다음 주행에서 복원 (적응 한계 기준 포함)
+	if (!calibrator.save()) {
+		std::cerr << "프로필 저장 실패" << std::endl;
+		return 1;
+	}
+	EarCalibrator restored("driver-a", directory);
+	if (!restored.load() || !restored.isCalibrated() ||
+			std::fabs(restored.getThreshold() - adapted) > 1e-4f ||
+			std::fabs(restored.getProfile().baselineOpenEar - profile.baselineOpenEar) > 1e-4f) {
+		std::cerr << "프로필 복원 실패" << std::endl;
+		return 1;
+	}
+	EarCalibrator other("driver-b", directory);
+	if (other.load()) {
+		std::cerr << "다른 운전자 프로필을 복원함" << std::endl;
+		return 1;
+	}
+
+	// 5. 분포가 구분되지 않으면 기본 임계값 유지
+	EarCalibrator flat("driver-c", directory, 1000, 50);
+	for (int i = 0; i < 100; ++i) {
+		flat.addSample(i * 42, openDist(engine), true);
+	}
+	if (flat.isCalibrated() || flat.getThreshold() != 0.25f) {
+		std::cerr << "구분되지 않는 분포 처리 오류" << std::endl;
+		return 1;
+	}
+
+	std::filesystem::remove_all(directory);
+	std::cout << "EarCalibrator 테스트 완료" << std::endl;
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "../include/EyeClosureQueueManagement.h"
+
+namespace {
+EyeStateSample makeSample(int64_t timestampMs, bool closed, float ear = 0.3f) {
+	EyeStateSample sample;
+	sample.timestampMs = timestampMs;
+	sample.ear = ear;
+	sample.confidence = 1.0f;
+	sample.faceFound = true;
+	sample.eyesClosed = closed;
+	return sample;
+}
+}	 // namespace
+
+int runEyeClosureQueueTest() {
+	std::cout << "EyeClosureQueueManagement 테스트 시작..." << std::endl;
+
+	SleepinessWindowConfig config;
+	config.closedDurationMs = 2000;
+	config.perclosWindowMs = 4000;
+	config.blinkWindowMs = 2000;
+	config.maxBlinkMs = 200;
+	config.historyCapacity = 256;
+	EyeClosureQueueManagement queue(config);
+
+	// 1. 40ms 간격, 10프레임마다 2프레임 깜빡임: 2초 구간에 깜빡임 5회 = 분당 150회, PERCLOS 20%
+	int64_t now = 0;
+	for (int i = 0; i < 200; ++i, now += 40) {
+		bool closed = i % 10 >= 8;
+		queue.saveEyeClosureStatus(makeSample(now, closed, closed ? 0.1f : 0.3f));
+	}
+	EyeClosureStats stats = queue.getStats();
+	std::cout << "PERCLOS " << stats.perclos << ", blinks/min " << stats.blinksPerMinute
+						<< ", mean EAR " << stats.meanEar << std::endl;
+	if (std::fabs(stats.perclos - 0.2) > 0.01 || std::fabs(stats.blinksPerMinute - 150.0) > 1.0 ||
+			std::fabs(stats.meanEar - 0.26f) > 0.005f || queue.detectSleepiness()) {
+		std::cerr << "깜빡임 구간 지표 오류" << std::endl;
+		return 1;
+	}
+
+	// 2. 프레임률이 절반(80ms)으로 떨어져도 연속 감김 2초에서 졸음으로 판별
+	queue.saveEyeClosureStatus(makeSample(now, false));
+	now += 80;
+	for (int i = 0; i < 24; ++i, now += 80) {
+		queue.saveEyeClosureStatus(makeSample(now, true, 0.1f));
+	}
+	if (queue.detectSleepiness()) {
+		std::cerr << "연속 감김 기준 이전에 졸음으로 판별" << std::endl;
+		return 1;
+	}
+	queue.saveEyeClosureStatus(makeSample(now, true, 0.1f));
+	now += 80;
+	if (!queue.detectSleepiness() || queue.getStats().closedRunMs != 2000) {
+		std::cerr << "연속 감김 졸음 판별 실패" << std::endl;
+		return 1;
+	}
+
+	// 3. 구간 질의: 최근 1초는 모두 감김, 평균 EAR 은 감긴 값
+	if (queue.getClosedDurationMs(1000) != 1000 || std::fabs(queue.getMeanEar(1000) - 0.1f) > 1e-4f) {
+		std::cerr << "구간 질의 오류: " << queue.getClosedDurationMs(1000) << "ms" << std::endl;
+		return 1;
+	}
+
+	// 4. 프레임 드롭(긴 공백)은 maxSampleGapMs 만큼만 반영되고, 긴 감김은 깜빡임이 아님
+	queue.saveEyeClosureStatus(makeSample(now + 5000, false));
+	if (queue.getStats().blinksPerMinute != 0.0 || queue.getClosedDurationMs(100000) > 4000) {
+		std::cerr << "공백/긴 감김 처리 오류" << std::endl;
+		return 1;
+	}
+	std::vector<EyeStateSample> history = queue.getEyeClosureHistory(100);
+	if (history.size() != 1 || history.front().eyesClosed) {
+		std::cerr << "이력 조회 오류" << std::endl;
+		return 1;
+	}
+
+	// 5. 기록 중 다른 스레드에서 조회 (링 크기를 넘겨 덮어쓰는 경우 포함)
+	now += 5000;
+	std::thread reader([&queue] {
+		for (int i = 0; i < 10000; ++i) {
+			queue.getStats();
+			queue.getClosedDurationMs(1000);
+		}
+	});
+	for (int i = 0; i < 10000; ++i) {
+		queue.saveEyeClosureStatus(makeSample(now + i * 10, i % 3 == 0));
+	}
+	reader.join();
+	stats = queue.getStats();
+	if (stats.samples != 10227 || std::fabs(stats.perclos - 1.0 / 3.0) > 0.01) {
+		std::cerr << "동시 기록 지표 오류: " << stats.samples << ", " << stats.perclos << std::endl;
+		return 1;
+	}
+
+	std::cout << "EyeClosureQueueManagement 테스트 완료" << std::endl;
+	return 0;
+}
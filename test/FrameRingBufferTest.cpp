@@ -0,0 +1,54 @@
+#include <chrono>
+#include <iostream>
+
+#include "../include/FrameRingBuffer.h"
+
+int runFrameRingBufferTest() {
+	std::cout << "FrameRingBuffer 테스트 시작..." << std::endl;
+
+	const size_t capacity = 72;
+	FrameRingBuffer buffer(capacity, 64 * 1024);
+
+	// 24fps 간격(약 42ms)으로 용량의 두 배만큼 프레임 추가 (오래된 프레임은 덮어써짐)
+	std::vector<uchar> jpeg;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < static_cast<int>(capacity * 2); ++i) {
+		jpeg.assign(50 * 1024, static_cast<uchar>(i));
+		buffer.push(static_cast<int64_t>(i) * 42, std::to_string(i) + ".jpg", jpeg);
+	}
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+										 std::chrono::steady_clock::now() - start)
+										 .count();
+	std::cout << "프레임 " << capacity * 2 << "개 추가: " << elapsed << "us, 보관 중: " << buffer.size()
+						<< std::endl;
+	if (buffer.size() != capacity) {
+		std::cerr << "보관 프레임 수 오류" << std::endl;
+		return 1;
+	}
+
+	// 마지막 프레임 기준 2.5초 구간 조회 (최대 60개)
+	int64_t lastMs = static_cast<int64_t>(capacity * 2 - 1) * 42;
+	std::vector<BufferedFrame> frames = buffer.snapshot(lastMs - 2500, lastMs, 60);
+	std::cout << "2.5초 구간 프레임 수: " << frames.size() << std::endl;
+	if (frames.empty() || frames.back().timestampMs != lastMs) {
+		std::cerr << "구간 조회 오류" << std::endl;
+		return 1;
+	}
+	for (size_t i = 1; i < frames.size(); ++i) {
+		if (frames[i - 1].timestampMs >= frames[i].timestampMs) {
+			std::cerr << "시간순 정렬 오류" << std::endl;
+			return 1;
+		}
+	}
+	if (frames.front().timestampMs < lastMs - 2500 ||
+			frames.back().jpeg[0] != static_cast<uchar>(capacity * 2 - 1)) {
+		std::cerr << "프레임 내용 오류" << std::endl;
+		return 1;
+	}
+
+	buffer.clear();
+	std::cout << "clear 후 보관 프레임 수: " << buffer.size() << std::endl;
+
+	std::cout << "FrameRingBuffer 테스트 종료" << std::endl;
+	return buffer.size() == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "../include/FrameScheduler.h"
+
+int runFrameSchedulerTest() {
+	std::cout << "FrameScheduler 테스트 시작..." << std::endl;
+
+	// 1. 처리 시간이 주기 안에 들어오면 슬롯이 연속되고 전체 시간이 밀리지 않아야 함
+	const auto interval = std::chrono::milliseconds(20);
+	FrameScheduler scheduler(interval);
+	auto start = std::chrono::steady_clock::now();
+	uint64_t slot = 0;
+	for (int i = 0; i < 50; ++i) {
+		slot = scheduler.waitNextSlot();
+		if (slot != static_cast<uint64_t>(i)) {
+			std::cerr << "슬롯 번호 오류: " << slot << " (기대값 " << i << ")" << std::endl;
+			return 1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(12));	 // 프레임 처리
+	}
+	auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+											 std::chrono::steady_clock::now() - start)
+											 .count();
+	// 마지막 슬롯(49) 예정 시각 980ms + 처리 12ms
+	std::cout << "50 슬롯 경과: " << elapsedMs << "ms" << std::endl;
+	if (elapsedMs > 1040) {
+		std::cerr << "주기 누적 지연 발생" << std::endl;
+		return 1;
+	}
+
+	// 2. 한 프레임이 2.5 주기 걸리면 지난 슬롯은 건너뛴 것으로 기록
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	uint64_t afterOverrun = scheduler.waitNextSlot();
+	FrameSchedulerStats stats = scheduler.getStats();
+	std::cout << "지연 후 슬롯 " << afterOverrun << ", skipped " << stats.skippedSlots
+						<< ", jitter p50/p99/max " << stats.jitterP50Us << "/" << stats.jitterP99Us << "/"
+						<< stats.jitterMaxUs << "us" << std::endl;
+	if (afterOverrun != slot + 1 + stats.skippedSlots || stats.skippedSlots < 2 ||
+			stats.overruns != 1) {
+		std::cerr << "건너뛴 슬롯 계산 오류" << std::endl;
+		return 1;
+	}
+
+	// 3. 재개 시 격자를 다시 맞추면 건너뛴 수는 늘지 않고 슬롯 번호는 이어짐
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	scheduler.reset();
+	if (scheduler.waitNextSlot() != afterOverrun + 1 ||
+			scheduler.getStats().skippedSlots != stats.skippedSlots) {
+		std::cerr << "재개 후 슬롯 처리 오류" << std::endl;
+		return 1;
+	}
+
+	// 4. 도착 기반 슬롯: 주기 근처로 흔들리며 도착하면 연속 슬롯, 3 주기 공백은 2 슬롯을 건너뜀
+	FrameScheduler arrivals(interval);
+	uint64_t first = arrivals.frameArrived();
+	std::this_thread::sleep_for(std::chrono::milliseconds(17));
+	uint64_t early = arrivals.frameArrived();
+	std::this_thread::sleep_for(std::chrono::milliseconds(23));
+	uint64_t late = arrivals.frameArrived();
+	std::this_thread::sleep_for(std::chrono::milliseconds(60));
+	uint64_t afterGap = arrivals.frameArrived();
+	FrameSchedulerStats arrivalStats = arrivals.getStats();
+	if (early != first + 1 || late != first + 2 || afterGap != first + 5 ||
+			arrivalStats.skippedSlots != 2 || arrivalStats.ticks != 4) {
+		std::cerr << "도착 기반 슬롯 계산 오류: " << early << "/" << late << "/" << afterGap
+							<< " (skipped " << arrivalStats.skippedSlots << ")" << std::endl;
+		return 1;
+	}
+
+	std::cout << "FrameScheduler 테스트 완료" << std::endl;
+	return 0;
+}
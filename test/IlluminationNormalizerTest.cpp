@@ -0,0 +1,125 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+#include "../include/IlluminationNormalizer.h"
+
+// 얼굴 크기의 타원과 한쪽에서 들어오는 강한 조명을 흉내 낸 합성 프레임
+cv::Mat createSyntheticFrame(const cv::Size& size) {
+	cv::Mat frame(size, CV_8UC3);
+	cv::RNG rng(1234);
+
+	for (int y = 0; y < size.height; ++y) {
+		cv::Vec3b* row = frame.ptr<cv::Vec3b>(y);
+		for (int x = 0; x < size.width; ++x) {
+			double light = 60.0 + 160.0 * x / size.width;	 // 좌->우 조명 그라디언트
+			row[x] = cv::Vec3b(cv::saturate_cast<uchar>(light * 0.8), cv::saturate_cast<uchar>(light * 0.9),
+												 cv::saturate_cast<uchar>(light));
+		}
+	}
+
+	cv::Point center(size.width / 2, size.height / 2);
+	cv::Size axes(size.width / 8, size.height / 4);
+	cv::ellipse(frame, center, axes, 0, 0, 360, cv::Scalar(120, 150, 190), cv::FILLED);
+	cv::circle(frame, center + cv::Point(-axes.width / 3, -axes.height / 4), axes.width / 8,
+						 cv::Scalar(30, 30, 30), cv::FILLED);
+	cv::circle(frame, center + cv::Point(axes.width / 3, -axes.height / 4), axes.width / 8,
+						 cv::Scalar(30, 30, 30), cv::FILLED);
+
+	cv::Mat noise(size, CV_8UC3);
+	rng.fill(noise, cv::RNG::NORMAL, 0, 6);
+	frame += noise;
+	return frame;
+}
+
+// 반복 실행 평균 시간 (ms)
+template <typename Func>
+double measureAverageMs(Func func, int iterations) {
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		func();
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int runIlluminationNormalizerTest(int argc, char** argv) {
+	std::cout << "===== IlluminationNormalizer Quality / Benchmark Test =====" << std::endl;
+
+	// 실제 프레임 경로를 인자로 받으면 해당 이미지를 각 해상도로 리사이즈하여 사용
+	cv::Mat source;
+	if (argc > 1) {
+		source = cv::imread(argv[1]);
+		if (source.empty()) {
+			std::cerr << "Cannot read image: " << argv[1] << ", using synthetic frame" << std::endl;
+		}
+	}
+
+	int iterations = 5;
+	if (argc > 2) {
+		iterations = std::stoi(argv[2]);
+	}
+
+	const std::vector<cv::Size> resolutions = {{640, 360}, {1280, 720}, {1920, 1080}};
+	IlluminationNormalizer normalizer;
+	bool passed = true;
+
+	// 커널은 1080p 기준 99 를 프레임 높이에 비례해 줄임
+	if (IlluminationNormalizer::kernelSizeForHeight(1080) != 99 ||
+			IlluminationNormalizer::kernelSizeForHeight(360) != 33) {
+		std::cerr << "Kernel scaling failed: 360p -> " << IlluminationNormalizer::kernelSizeForHeight(360)
+							<< std::endl;
+		passed = false;
+	}
+
+	std::cout << std::left << std::setw(12) << "resolution" << std::setw(16) << "reference(ms)"
+						<< std::setw(12) << "fast(ms)" << std::setw(10) << "speedup" << std::setw(12)
+						<< "mean|diff|" << std::setw(10) << "max|diff|" << "PSNR(dB)" << std::endl;
+
+	for (const auto& size : resolutions) {
+		cv::Mat frame;
+		if (source.empty()) {
+			frame = createSyntheticFrame(size);
+		} else {
+			cv::resize(source, frame, size, 0, 0, cv::INTER_AREA);
+		}
+
+		// 기존 방식과 같은 커널 크기로 비교
+		int kernel = IlluminationNormalizer::kernelSizeForHeight(size.height);
+		normalizer.setMedianKernelSize(kernel);
+		cv::Mat reference, fast;
+		IlluminationNormalizer::normalizeReference(frame, reference, kernel);
+		normalizer.normalize(frame, fast);
+
+		// 품질 비교: 기존 전처리 결과 대비 차이
+		cv::Mat diff;
+		cv::absdiff(reference, fast, diff);
+		double meanDiff = cv::mean(diff)[0];
+		double maxDiff = 0.0;
+		cv::minMaxLoc(diff, nullptr, &maxDiff);
+		double psnr = cv::PSNR(reference, fast);
+
+		// 해상도별 처리 시간
+		double referenceMs = measureAverageMs(
+				[&] { IlluminationNormalizer::normalizeReference(frame, reference, kernel); }, iterations);
+		double fastMs = measureAverageMs([&] { normalizer.normalize(frame, fast); }, iterations);
+
+		std::cout << std::left << std::setw(12)
+							<< (std::to_string(size.width) + "x" + std::to_string(size.height)) << std::fixed
+							<< std::setprecision(2) << std::setw(16) << referenceMs << std::setw(12) << fastMs
+							<< std::setw(10) << referenceMs / fastMs << std::setw(12) << meanDiff << std::setw(10)
+							<< maxDiff << psnr << std::endl;
+
+		// 배경 성분은 출력의 25% 만 차지하므로 평균 오차는 작아야 함
+		if (meanDiff > 3.0 || psnr < 30.0) {
+			std::cerr << "Quality check failed at " << size << std::endl;
+			passed = false;
+		}
+	}
+
+	std::cout << (passed ? "All quality checks passed" : "Quality checks FAILED") << std::endl;
+	return passed ? 0 : 1;
+}
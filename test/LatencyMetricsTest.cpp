@@ -0,0 +1,145 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/LatencyMetrics.h"
+#include "../include/MetricsExporter.h"
+
+namespace {
+// 루프백 포트로 GET 요청을 보내 응답 전체를 받음
+std::string httpGet(int port, const std::string& path) {
+	int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	std::string response;
+	if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+		std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+		::send(fd, request.data(), request.size(), 0);
+		char buffer[4096];
+		ssize_t n;
+		while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+			response.append(buffer, static_cast<size_t>(n));
+		}
+	}
+	::close(fd);
+	return response;
+}
+
+bool near(double actual, double expected, double ratio) {
+	return std::fabs(actual - expected) <= expected * ratio;
+}
+}	 // namespace
+
+int runLatencyMetricsTest() {
+	std::cout << "LatencyMetrics 테스트 시작..." << std::endl;
+	LatencyMetrics& metrics = LatencyMetrics::getInstance();
+	metrics.reset();
+
+	// 1. 버킷 경계: 하한이 단조 증가하고, 값은 자기 버킷 범위 안에 들어감
+	for (uint64_t value : {0ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 41999ull, 1234567ull}) {
+		int index = LatencyMetrics::bucketIndex(value);
+		if (LatencyMetrics::bucketLowerUs(index) > value ||
+				(index + 1 < LatencyMetrics::BUCKET_COUNT && LatencyMetrics::bucketLowerUs(index + 1) <= value)) {
+			std::cerr << "버킷 경계 오류: " << value << "us -> " << index << std::endl;
+			return 1;
+		}
+	}
+
+	// 2. 여러 스레드가 동시에 기록: 1~1000ms 균등 분포 (스레드당 1000 개)
+	const int threadCount = 4;
+	std::vector<std::thread> writers;
+	for (int t = 0; t < threadCount; ++t) {
+		writers.emplace_back([&metrics] {
+			for (int ms = 1; ms <= 1000; ++ms) {
+				metrics.record(LatencyStage::Detection, ms * 1000);
+			}
+		});
+	}
+	// 기록 중에도 합산 조회가 가능해야 함
+	for (int i = 0; i < 20; ++i) {
+		metrics.getSummary(LatencyStage::Detection);
+	}
+	for (auto& writer : writers) {
+		writer.join();
+	}
+
+	LatencySummary summary = metrics.getSummary(LatencyStage::Detection);
+	std::cout << "detection p50/p90/p99/max " << summary.p50Ms << "/" << summary.p90Ms << "/"
+						<< summary.p99Ms << "/" << summary.maxMs << "ms" << std::endl;
+	if (summary.count != 4000 || !near(summary.meanMs, 500.5, 0.001) ||
+			!near(summary.p50Ms, 500.0, 0.07) || !near(summary.p90Ms, 900.0, 0.07) ||
+			!near(summary.p99Ms, 990.0, 0.07) || summary.maxMs != 1000.0) {
+		std::cerr << "백분위 추정 오류" << std::endl;
+		return 1;
+	}
+
+	// 3. 스코프 타이머
+	{
+		ScopedLatency timer(LatencyStage::Encode);
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	LatencySummary encode = metrics.getSummary(LatencyStage::Encode);
+	if (encode.count != 1 || encode.maxMs < 5.0) {
+		std::cerr << "스코프 타이머 기록 오류" << std::endl;
+		return 1;
+	}
+
+	// 4. Prometheus 텍스트: 누적 버킷과 count 일치
+	std::string text = metrics.renderPrometheus();
+	if (text.find("nosleep_stage_latency_seconds_count{stage=\"detection\"} 4000") == std::string::npos ||
+			text.find("nosleep_stage_latency_seconds_bucket{stage=\"detection\",le=\"+Inf\"} 4000") ==
+					std::string::npos ||
+			text.find("nosleep_stage_latency_seconds_bucket{stage=\"detection\",le=\"0.524288\"} 2096") ==
+					std::string::npos ||
+			text.find("nosleep_stage_latency_quantile_seconds{stage=\"encode\",quantile=\"0.99\"}") ==
+					std::string::npos) {
+		std::cerr << "Prometheus 출력 오류" << std::endl;
+		std::cerr << text.substr(0, 2000) << std::endl;
+		return 1;
+	}
+
+	// 5. 파일 / HTTP 내보내기
+	std::string filePath = "/tmp/nosleep_latency_test.prom";
+	const int port = 19464;
+	MetricsExporter exporter(port, filePath);
+	if (!exporter.start()) {
+		std::cerr << "지표 포트 열기 실패" << std::endl;
+		return 1;
+	}
+	std::string response = httpGet(port, "/metrics");
+	std::string missing = httpGet(port, "/other");
+	exporter.stop();
+
+	std::ifstream file(filePath);
+	std::stringstream written;
+	written << file.rdbuf();
+	std::remove(filePath.c_str());
+	if (response.rfind("HTTP/1.1 200 OK", 0) != 0 ||
+			response.find("nosleep_stage_latency_seconds_count{stage=\"detection\"} 4000") ==
+					std::string::npos ||
+			missing.rfind("HTTP/1.1 404", 0) != 0 || exporter.getServedRequests() != 1) {
+		std::cerr << "HTTP 지표 응답 오류" << std::endl;
+		return 1;
+	}
+	if (written.str().find("stage=\"detection\"") == std::string::npos || exporter.getFileWrites() < 1) {
+		std::cerr << "지표 파일 기록 오류" << std::endl;
+		return 1;
+	}
+
+	metrics.logStats();
+	std::cout << "LatencyMetrics 테스트 완료" << std::endl;
+	return 0;
+}
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "../include/MotionStateMonitor.h"
+
+namespace {
+// 주행 중 진동(±0.5m/s^2) 또는 정차 중 잡음(±0.02m/s^2) 을 내는 결정적 센서
+class SyntheticAccelerationSensor : public IAccelerationSensor {
+private:
+	std::atomic<bool> vibrating{true};
+	uint64_t step = 0;
+
+public:
+	void setVibrating(bool value) { vibrating.store(value); }
+
+	AccelerationSample getAcceleration() override {
+		float amplitude = vibrating.load() ? 0.5f : 0.02f;
+		AccelerationSample sample;
+		sample.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+														 std::chrono::steady_clock::now().time_since_epoch())
+														 .count();
+		sample.z = 9.8f + ((step++ % 2) ? amplitude : -amplitude);
+		return sample;
+	}
+
+	bool isMoving() override { return vibrating.load(); }
+};
+
+// ADXL345 레지스터를 흉내 내는 센서: 진동 중이면 INT_SOURCE 에 activity 비트가 켜지고 읽으면 해제,
+// FIFO 에는 읽을 때마다 샘플 1개가 쌓여 있음
+class LatchingAdxl345Sensor : public Adxl345Sensor {
+private:
+	std::atomic<bool> vibrating{true};
+	uint64_t step = 0;
+
+protected:
+	bool isConnected() const override { return true; }
+
+	bool readRegisters(uint8_t reg, uint8_t* data, size_t length) override {
+		std::fill(data, data + length, 0);
+		if (reg == 0x30) {	// INT_SOURCE
+			data[0] = vibrating.load() ? 0x10 : 0x00;
+		} else if (reg == 0x39) {	 // FIFO_STATUS
+			data[0] = 1;
+		}
+		return true;
+	}
+
+	int readFifoEntries(AccelerationSample* samples, int count) override {
+		float amplitude = vibrating.load() ? 0.5f : 0.02f;
+		for (int i = 0; i < count; ++i) {
+			samples[i] = AccelerationSample{};
+			samples[i].z = 9.8f + ((step++ % 2) ? amplitude : -amplitude);
+		}
+		return count;
+	}
+
+public:
+	LatchingAdxl345Sensor() : Adxl345Sensor("/dev/null", 0x53, 200) {}
+
+	void setVibrating(bool value) { vibrating.store(value); }
+};
+
+AccelerationSample makeSample(int64_t timestampMs, float amplitude, int64_t index,
+															bool activity = false) {
+	AccelerationSample sample;
+	sample.timestampUs = timestampMs * 1000;
+	sample.z = 9.8f + ((index % 2) ? amplitude : -amplitude);
+	sample.activity = activity;
+	return sample;
+}
+}	 // namespace
+
+int runMotionStateMonitorTest() {
+	std::cout << "MotionStateMonitor 테스트 시작..." << std::endl;
+
+	// 1. 주행 중 진동이 멈춰도 stoppedHoldMs 동안 조용해야 정차로 전환
+	MotionFilterConfig config;
+	MotionStateFilter filter(config);
+	int64_t t = 0;
+	for (int i = 0; i < 300; ++i, t += 10) {
+		filter.update(makeSample(t, 0.5f, i));
+	}
+	if (!filter.isMoving() || filter.getVariance() < config.movingVariance) {
+		std::cerr << "주행 진동 판정 오류 (분산 " << filter.getVariance() << ")" << std::endl;
+		return 1;
+	}
+
+	int64_t quietStart = t;
+	int64_t stoppedAt = -1;
+	for (int i = 0; i < 1000 && stoppedAt < 0; ++i, t += 10) {
+		if (!filter.update(makeSample(t, 0.01f, i))) {
+			stoppedAt = t;
+		}
+	}
+	// 분산이 stoppedVariance 아래로 떨어진 뒤 5초 유지
+	std::cout << "정차 전환까지 " << (stoppedAt - quietStart) << "ms" << std::endl;
+	if (stoppedAt < 0 || stoppedAt - quietStart < config.stoppedHoldMs) {
+		std::cerr << "정차 전환 히스테리시스 오류" << std::endl;
+		return 1;
+	}
+
+	// 2. 정차 중 튀는 샘플 하나(activity 포함) 로는 주행으로 바뀌지 않음
+	filter.update(makeSample(t, 3.0f, 1, true));
+	t += 10;
+	for (int i = 0; i < 50; ++i, t += 10) {
+		filter.update(makeSample(t, 0.01f, i));
+	}
+	if (filter.isMoving() || filter.getTransitions() != 1) {
+		std::cerr << "단일 충격으로 상태 전환됨" << std::endl;
+		return 1;
+	}
+
+	// 3. 진동이 movingHoldMs 동안 이어지면 주행으로 전환
+	int64_t vibrationStart = t;
+	int64_t movingAt = -1;
+	for (int i = 0; i < 200 && movingAt < 0; ++i, t += 10) {
+		if (filter.update(makeSample(t, 0.5f, i))) {
+			movingAt = t;
+		}
+	}
+	std::cout << "주행 전환까지 " << (movingAt - vibrationStart) << "ms" << std::endl;
+	if (movingAt < 0 || movingAt - vibrationStart < config.movingHoldMs ||
+			movingAt - vibrationStart > 1000) {
+		std::cerr << "주행 전환 오류" << std::endl;
+		return 1;
+	}
+
+	// 4. 샘플링 스레드: 상태 공개 및 최근 샘플 링을 다른 스레드에서 동시에 읽음
+	auto synthetic = std::make_unique<SyntheticAccelerationSensor>();
+	SyntheticAccelerationSensor* source = synthetic.get();
+	AccelerationSensor sensor(std::move(synthetic));
+
+	MotionFilterConfig fast;
+	fast.sampleRateHz = 200;
+	fast.movingHoldMs = 50;
+	fast.stoppedHoldMs = 300;
+	fast.varianceTauMs = 50.0f;
+	MotionStateMonitor monitor(sensor, fast);
+	monitor.start();
+
+	std::atomic<bool> readerDone{false};
+	std::atomic<uint64_t> readerSamples{0};
+	std::atomic<bool> readerError{false};
+	std::thread reader([&] {
+		AccelerationSample recent[256];
+		while (!readerDone.load()) {
+			size_t count = monitor.getRecentSamples(recent, 256);
+			for (size_t i = 1; i < count; ++i) {
+				if (recent[i].timestampUs < recent[i - 1].timestampUs) {
+					readerError.store(true);
+				}
+			}
+			readerSamples.fetch_add(count);
+			monitor.isMoving();
+		}
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	bool movingWhileVibrating = monitor.isMoving();
+	source->setVibrating(false);
+	std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+	bool movingWhenQuiet = monitor.isMoving();
+	source->setVibrating(true);
+	std::this_thread::sleep_for(std::chrono::milliseconds(400));
+	bool movingAgain = monitor.isMoving();
+
+	readerDone.store(true);
+	reader.join();
+	monitor.stop();
+	monitor.logStats();
+
+	MotionStats stats = monitor.getStats();
+	if (!movingWhileVibrating || movingWhenQuiet || !movingAgain || stats.transitions != 2) {
+		std::cerr << "샘플링 스레드 상태 공개 오류" << std::endl;
+		return 1;
+	}
+	if (readerError.load() || readerSamples.load() == 0 || stats.samples < 200) {
+		std::cerr << "최근 샘플 링 읽기 오류" << std::endl;
+		return 1;
+	}
+
+	// 5. ADXL345 activity 인터럽트는 읽은 샘플에만 한 번 붙고, 진동이 멈추면 정차로 전환
+	LatchingAdxl345Sensor latching;
+	AccelerationSample read[4];
+	bool firstActivity = latching.readSamples(read, 4) == 1 && read[0].activity;
+	latching.setVibrating(false);
+	bool secondActivity = latching.readSamples(read, 4) == 1 && read[0].activity;
+	// 샘플 읽기에서 확인된 activity 도 isMoving() 에 한 번 남음
+	bool polledMoving = latching.isMoving();
+	bool polledAgain = latching.isMoving();
+	if (!firstActivity || secondActivity || !polledMoving || polledAgain) {
+		std::cerr << "activity 인터럽트 소비 오류" << std::endl;
+		return 1;
+	}
+
+	auto adxl = std::make_unique<LatchingAdxl345Sensor>();
+	LatchingAdxl345Sensor* latchingSource = adxl.get();
+	latchingSource->setVibrating(true);
+	AccelerationSensor adxlSensor(std::move(adxl));
+	MotionStateMonitor adxlMonitor(adxlSensor, fast);
+	adxlMonitor.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	bool adxlMoving = adxlMonitor.isMoving();
+	latchingSource->setVibrating(false);
+	std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+	bool adxlStopped = !adxlMonitor.isMoving();
+	adxlMonitor.stop();
+	if (!adxlMoving || !adxlStopped) {
+		std::cerr << "ADXL345 activity 래치로 정차 전환 안 됨" << std::endl;
+		return 1;
+	}
+
+	std::cout << "MotionStateMonitor 테스트 완료" << std::endl;
+	return 0;
+}
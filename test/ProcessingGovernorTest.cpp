@@ -0,0 +1,111 @@
+#include <iostream>
+
+#include "../include/ProcessingGovernor.h"
+
+namespace {
+// 눈을 뜬 상태 (EAR 0.34, 임계값 0.25 대비 36% 위)
+GovernorInputs openEyes(int64_t nowMs) {
+	GovernorInputs inputs;
+	inputs.nowMs = nowMs;
+	inputs.recentEar = 0.34f;
+	inputs.earThreshold = 0.25f;
+	inputs.motionVariance = 0.05f;
+	inputs.cpuTemperatureC = 55.0f;
+	inputs.cpuLoad = 0.4f;
+	return inputs;
+}
+}	 // namespace
+
+int runProcessingGovernorTest() {
+	std::cout << "ProcessingGovernor 테스트 시작..." << std::endl;
+	GovernorConfig config;
+	ProcessingGovernor governor(config);
+
+	// 1. 시작은 Normal, 눈을 뜬 상태가 economyAfterMs 이어지면 Economy
+	int64_t t = 1000;
+	if (governor.evaluate(openEyes(t)) != ProcessingMode::Normal) {
+		std::cerr << "초기 모드 오류" << std::endl;
+		return 1;
+	}
+	for (; t <= 1000 + config.economyAfterMs - 500; t += 500) {
+		governor.evaluate(openEyes(t));
+	}
+	if (governor.getMode() != ProcessingMode::Normal) {
+		std::cerr << "안정 구간 전에 Economy 로 전환됨" << std::endl;
+		return 1;
+	}
+	governor.evaluate(openEyes(1000 + config.economyAfterMs));
+	if (governor.getMode() != ProcessingMode::Economy || governor.shouldCapture(1) ||
+			!governor.shouldCapture(3) || governor.getProfile().detectionWidth != 320) {
+		std::cerr << "Economy 전환 오류" << std::endl;
+		return 1;
+	}
+	t = 1000 + config.economyAfterMs;
+
+	// 2. 깜빡임(감김 200ms) 으로는 모드가 오르지 않지만, 감김이 길어지면 즉시 Alert
+	GovernorInputs blink = openEyes(t += 100);
+	blink.closedRunMs = 200;
+	governor.evaluate(blink);
+	GovernorInputs closing = openEyes(t += 300);
+	closing.closedRunMs = 500;
+	if (governor.getMode() != ProcessingMode::Economy ||
+			governor.evaluate(closing) != ProcessingMode::Alert || !governor.shouldCapture(1) ||
+			!governor.shouldUplink(7)) {
+		std::cerr << "눈 감김 시 Alert 전환 오류" << std::endl;
+		return 1;
+	}
+
+	// 3. EAR 이 임계값에 가까워지는 추세도 Alert, 신호가 사라져도 alertHoldMs 동안 유지
+	int64_t lastSignal = t += 1000;
+	GovernorInputs drowsyTrend = openEyes(lastSignal);
+	drowsyTrend.recentEar = 0.27f;
+	governor.evaluate(drowsyTrend);
+	governor.evaluate(openEyes(lastSignal + config.alertHoldMs - 100));
+	if (governor.getMode() != ProcessingMode::Alert) {
+		std::cerr << "Alert 유지 오류" << std::endl;
+		return 1;
+	}
+	if (governor.evaluate(openEyes(lastSignal + config.alertHoldMs)) != ProcessingMode::Normal) {
+		std::cerr << "Alert 해제 오류" << std::endl;
+		return 1;
+	}
+
+	// 4. 발열 시 Economy, 단 눈 감김 신호가 있으면 Alert 우선
+	t = lastSignal + config.alertHoldMs + 500;
+	GovernorInputs hot = openEyes(t);
+	hot.cpuTemperatureC = 78.0f;
+	if (governor.evaluate(hot) != ProcessingMode::Economy) {
+		std::cerr << "발열 시 Economy 전환 오류" << std::endl;
+		return 1;
+	}
+	hot.nowMs = t + 500;
+	hot.perclos = 0.1;
+	if (governor.evaluate(hot) != ProcessingMode::Alert) {
+		std::cerr << "발열 중 졸음 신호 우선 처리 오류" << std::endl;
+		return 1;
+	}
+
+	// 5. 노면 진동이 크면 눈을 뜨고 있어도 Economy 로 내리지 않음
+	ProcessingGovernor rough(config);
+	for (int64_t now = 0; now <= config.economyAfterMs + 1000; now += 500) {
+		GovernorInputs inputs = openEyes(now);
+		inputs.motionVariance = 0.8f;
+		rough.evaluate(inputs);
+	}
+	if (rough.getMode() != ProcessingMode::Normal) {
+		std::cerr << "진동 구간 Economy 전환됨" << std::endl;
+		return 1;
+	}
+
+	// 6. 비활성화하면 항상 모든 프레임 처리
+	ProcessingGovernor disabled(config, false);
+	disabled.evaluate(openEyes(config.economyAfterMs * 2));
+	if (disabled.getMode() != ProcessingMode::Alert || !disabled.shouldCapture(1)) {
+		std::cerr << "비활성화 모드 오류" << std::endl;
+		return 1;
+	}
+
+	governor.logStats();
+	std::cout << "ProcessingGovernor 테스트 완료" << std::endl;
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "../include/PyBridge.h"
+
+// 단독 실행 시 NumPy C API 를 이 파일에서 초기화 (펌웨어에서는 FirmwareManager.cpp 에서 수행)
+#define PY_ARRAY_UNIQUE_SYMBOL NOSLEEP_ARRAY_API
+#define NPY_NO_DEPRECATED_API	 NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+namespace {
+// 판별 함수 자체의 비용을 빼고 호출 경로만 비교하기 위한 가벼운 모듈
+const char* BENCH_MODULE_SOURCE =
+		"import sys, types\n"
+		"m = types.ModuleType('pybridge_bench')\n"
+		"exec('def is_eye_closed(frame, threshold):\\n"
+		"    return int(frame[0, 0]) < threshold * 255\\n', m.__dict__)\n"
+		"sys.modules['pybridge_bench'] = m\n";
+
+// 기존 경로: 프레임마다 import, 함수 조회, float/튜플 생성
+bool legacyCall(const cv::Mat& frame, float threshold) {
+	bool closed = false;
+	PyGILState_STATE gstate = PyGILState_Ensure();
+	PyObject* pModule = PyImport_ImportModule("pybridge_bench");
+	if (pModule != nullptr) {
+		PyObject* pFunc = PyObject_GetAttrString(pModule, "is_eye_closed");
+		if (pFunc != nullptr && PyCallable_Check(pFunc)) {
+			npy_intp dims[2] = {frame.rows, frame.cols};
+			PyObject* pArray = PyArray_SimpleNewFromData(2, dims, NPY_UINT8, frame.data);
+			PyObject* pArgs = PyTuple_New(2);
+			PyTuple_SetItem(pArgs, 0, pArray);
+			PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(threshold));
+			PyObject* pValue = PyObject_CallObject(pFunc, pArgs);
+			Py_DECREF(pArgs);
+			if (pValue != nullptr) {
+				closed = PyObject_IsTrue(pValue);
+				Py_DECREF(pValue);
+			} else {
+				PyErr_Print();
+			}
+		}
+		Py_XDECREF(pFunc);
+		Py_DECREF(pModule);
+	}
+	PyGILState_Release(gstate);
+	return closed;
+}
+
+// PyBridge 경로 (GIL 은 호출자가 잡음)
+bool bridgeCall(PyCallable& callable, const cv::Mat& frame) {
+	callable.setArg(0, wrapMatAsNumpy(frame));
+	PyObject* pValue = callable.call();
+	callable.clearArg(0);
+	bool closed = pValue != nullptr && PyObject_IsTrue(pValue);
+	Py_XDECREF(pValue);
+	return closed;
+}
+
+template <typename Func>
+double measureAverageUs(Func func, int iterations) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		func();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+}	 // namespace
+
+int runPyBridgeBenchmark() {
+	std::cout << "===== PyBridge 호출 오버헤드 벤치마크 =====" << std::endl;
+
+	bool ownsInterpreter = !Py_IsInitialized();
+	if (ownsInterpreter) {
+		Py_Initialize();
+		if (_import_array() < 0) {
+			PyErr_Print();
+			std::cerr << "NumPy 초기화 실패" << std::endl;
+			return 1;
+		}
+		PyRun_SimpleString(BENCH_MODULE_SOURCE);
+		PyEval_SaveThread();	// 파이프라인 스레드처럼 GIL 을 놓은 상태에서 측정
+	} else {
+		PyGilGuard gil;
+		PyRun_SimpleString(BENCH_MODULE_SOURCE);
+	}
+
+	const int iterations = 20000;
+	const int batchSize = 8;
+	const float threshold = 0.25f;
+	cv::Mat frame(360, 640, CV_8UC1, cv::Scalar(40));
+	cv::Mat roi = frame(cv::Rect(100, 50, 320, 240));	// 행 간격이 있는 ROI (기존 경로는 복사 필요)
+
+	PyCallable callable;
+	{
+		PyGilGuard gil;
+		if (!callable.resolve("pybridge_bench", "is_eye_closed", 2)) {
+			return 1;
+		}
+		callable.setArg(1, PyFloat_FromDouble(threshold));
+	}
+
+	// 결과 일치 확인
+	bool legacyResult = legacyCall(frame, threshold);
+	bool bridgeResult;
+	{
+		PyGilGuard gil;
+		bridgeResult = bridgeCall(callable, roi);
+	}
+	if (legacyResult != bridgeResult) {
+		std::cerr << "결과 불일치" << std::endl;
+		return 1;
+	}
+
+	double legacyUs = measureAverageUs([&] { legacyCall(frame, threshold); }, iterations);
+	double legacyRoiUs =
+			measureAverageUs([&] { legacyCall(roi.clone(), threshold); }, iterations);
+	double cachedUs = measureAverageUs(
+			[&] {
+				PyGilGuard gil;
+				bridgeCall(callable, roi);
+			},
+			iterations);
+	double batchedUs = measureAverageUs(
+												 [&] {
+													 PyGilGuard gil;
+													 for (int i = 0; i < batchSize; ++i) {
+														 bridgeCall(callable, roi);
+													 }
+												 },
+												 iterations / batchSize) /
+										 batchSize;
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "기존 (import/조회/튜플 생성)        : " << legacyUs << " us/call" << std::endl;
+	std::cout << "기존 + ROI 복사                     : " << legacyRoiUs << " us/call" << std::endl;
+	std::cout << "PyBridge (캐시 핸들, zero-copy ROI) : " << cachedUs << " us/call" << std::endl;
+	std::cout << "PyBridge 배치 " << batchSize << "장/GIL            : " << batchedUs << " us/call"
+						<< std::endl;
+
+	{
+		PyGilGuard gil;
+		callable.reset();
+	}
+	if (ownsInterpreter) {
+		PyGILState_Ensure();
+		Py_Finalize();
+	}
+	return 0;
+}
@@ -0,0 +1,159 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../include/ThermalMonitor.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+// 장치와 같은 구조의 sysfs/procfs 시뮬레이션 디렉터리
+class SimulatedSysfs {
+private:
+	fs::path root;
+	uint64_t busy = 0;
+	uint64_t idle = 0;
+
+	static void write(const fs::path& path, const std::string& value) {
+		fs::create_directories(path.parent_path());
+		std::ofstream(path) << value << "\n";
+	}
+
+public:
+	explicit SimulatedSysfs(const std::string& name)
+			: root(fs::temp_directory_path() / ("nosleep_thermal_" + name)) {
+		fs::remove_all(root);
+		write(root / "sys/class/thermal/thermal_zone0/type", "cpu-thermal");
+		write(root / "sys/class/thermal/thermal_zone0/trip_point_0_type", "critical");
+		write(root / "sys/class/thermal/thermal_zone0/trip_point_0_temp", "110000");
+		write(root / "sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", "1800000");
+		setFrequencyKhz(1800000);
+		setTemperature(55.0f);
+		addCpuTime(0, 100);
+	}
+	~SimulatedSysfs() { fs::remove_all(root); }
+
+	std::string path() const { return root.string(); }
+
+	void setTemperature(float celsius) {
+		write(root / "sys/class/thermal/thermal_zone0/temp",
+					std::to_string(static_cast<long>(celsius * 1000)));
+	}
+	void setFrequencyKhz(long khz) {
+		write(root / "sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", std::to_string(khz));
+	}
+	void setPassiveTrip(float celsius) {
+		write(root / "sys/class/thermal/thermal_zone0/trip_point_1_type", "passive");
+		write(root / "sys/class/thermal/thermal_zone0/trip_point_1_temp",
+					std::to_string(static_cast<long>(celsius * 1000)));
+	}
+	// user 에 busyTicks, idle 에 idleTicks 누적
+	void addCpuTime(uint64_t busyTicks, uint64_t idleTicks) {
+		busy += busyTicks;
+		idle += idleTicks;
+		write(root / "proc/stat", "cpu  " + std::to_string(busy) + " 0 0 " + std::to_string(idle) +
+																	" 0 0 0 0 0 0\ncpu0 0 0 0 0 0 0 0 0 0 0");
+	}
+};
+}	 // namespace
+
+int runThermalMonitorTest() {
+	std::cout << "ThermalMonitor 테스트 시작..." << std::endl;
+	SimulatedSysfs sysfs("drive");
+	ThermalConfig config;
+	ThermalMonitor monitor(sysfs.path(), config);
+
+	// 1. 안정된 온도에서는 Normal, 사용률은 /proc/stat 차이로 계산
+	int64_t t = 0;
+	for (int i = 0; i < 10; ++i, t += 1000) {
+		sysfs.addCpuTime(50, 50);
+		monitor.sample(t);
+	}
+	ThermalStats stats = monitor.getStats();
+	if (monitor.getLevel() != ThermalLevel::Normal || stats.temperatureC != 55.0f ||
+			stats.cpuUtilization < 0.49f || stats.cpuUtilization > 0.51f || stats.throttleC != 80.0f) {
+		std::cerr << "안정 구간 판정 오류 (" << stats.temperatureC << "C, cpu " << stats.cpuUtilization
+							<< ")" << std::endl;
+		return 1;
+	}
+
+	// 2. 온도가 빠르게 오르면 스로틀 온도에 닿기 전에 단계를 올림
+	float temperature = 55.0f;
+	int64_t elevatedAt = -1;
+	int64_t criticalAt = -1;
+	float criticalTemperature = 0.0f;
+	while (temperature < 80.0f && criticalAt < 0) {
+		temperature += 0.25f;	 // 15도/분
+		sysfs.setTemperature(temperature);
+		sysfs.addCpuTime(95, 5);
+		ThermalLevel level = monitor.sample(t);
+		if (level >= ThermalLevel::Elevated && elevatedAt < 0) {
+			elevatedAt = t;
+		}
+		if (level == ThermalLevel::Critical) {
+			criticalAt = t;
+			criticalTemperature = temperature;
+		}
+		t += 1000;
+	}
+	std::cout << "Critical 전환 온도 " << criticalTemperature << "C" << std::endl;
+	if (elevatedAt < 0 || criticalAt < 0 || criticalTemperature >= 80.0f - config.criticalMarginC ||
+			!monitor.getDegradation().skipUplink || monitor.getDegradation().jpegQuality <= 0) {
+		std::cerr << "추세 기반 스로틀 예측 오류" << std::endl;
+		return 1;
+	}
+
+	// 3. 식어도 히스테리시스 + releaseHoldMs 가 지나야 단계를 내림
+	temperature = 72.0f;
+	for (int i = 0; i < 90; ++i, t += 1000) {
+		sysfs.setTemperature(temperature);
+		sysfs.addCpuTime(50, 50);
+		monitor.sample(t);
+	}
+	if (monitor.getLevel() != ThermalLevel::Elevated) {
+		std::cerr << "Critical 해제 오류: " << ThermalMonitor::levelName(monitor.getLevel())
+							<< std::endl;
+		return 1;
+	}
+	sysfs.setTemperature(60.0f);
+	int64_t cooledAt = t;
+	while (monitor.getLevel() != ThermalLevel::Normal && t - cooledAt < 120000) {
+		sysfs.addCpuTime(50, 50);
+		monitor.sample(t);
+		t += 1000;
+	}
+	if (monitor.getLevel() != ThermalLevel::Normal || t - cooledAt < config.releaseHoldMs) {
+		std::cerr << "Elevated 해제 히스테리시스 오류" << std::endl;
+		return 1;
+	}
+
+	// 4. 바쁜데 클럭이 최대보다 낮으면 이미 스로틀 중이므로 즉시 Critical
+	sysfs.setFrequencyKhz(1200000);
+	sysfs.addCpuTime(98, 2);
+	if (monitor.sample(t += 1000) != ThermalLevel::Critical || !monitor.getStats().frequencyCapped) {
+		std::cerr << "클럭 제한 감지 오류" << std::endl;
+		return 1;
+	}
+	monitor.logStats();
+
+	// 5. passive 트립 포인트가 있으면 그 온도를 스로틀 기준으로 사용
+	SimulatedSysfs trip("trip");
+	trip.setPassiveTrip(70.0f);
+	trip.setTemperature(64.0f);
+	ThermalMonitor tripMonitor(trip.path(), config);
+	if (tripMonitor.sample(0) != ThermalLevel::Elevated || tripMonitor.getStats().throttleC != 70.0f) {
+		std::cerr << "passive 트립 포인트 반영 오류" << std::endl;
+		return 1;
+	}
+
+	// 6. 루트가 없으면 온도를 알 수 없으므로 처리 축소 없음
+	ThermalMonitor missing("/nonexistent-thermal-root", config);
+	if (missing.sample(0) != ThermalLevel::Normal || missing.getTemperatureC() >= 0.0f) {
+		std::cerr << "센서 없음 처리 오류" << std::endl;
+		return 1;
+	}
+
+	std::cout << "ThermalMonitor 테스트 완료" << std::endl;
+	return 0;
+}
@@ -9,95 +9,40 @@
 
 #include "../include/Camera.h"
 #include "../include/EyeClosureQueueManagement.h"
+#include "../include/IlluminationNormalizer.h"
 
 bool removeLight(const cv::Mat& input, cv::Mat& lChannel, cv::Mat& composed) {
+	// 버퍼 재사용을 위해 테스트 동안 하나의 정규화기 유지
+	static IlluminationNormalizer normalizer;
+
 	std::cout << "\n----- Image Preprocessing Started -----" << std::endl;
 	auto startTime = std::chrono::high_resolution_clock::now();
-	auto totalStartTime = startTime;
 
-	try {
-		// Print input image information
-		std::cout << "Input image size: " << input.cols << "x" << input.rows << std::endl;
-		std::cout << "Input image channels: " << input.channels() << std::endl;
-
-		// 1. Convert to grayscale
-		std::cout << "1. Starting grayscale conversion..." << std::endl;
-		cv::Mat gray;
-		cv::cvtColor(input, gray, cv::COLOR_BGR2GRAY);
-
-		auto stepTime = std::chrono::high_resolution_clock::now();
-		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-		startTime = stepTime;
-
-		// 2. Convert BGR to LAB color space
-		std::cout << "2. Starting LAB color space conversion..." << std::endl;
-		cv::Mat lab;
-		cv::cvtColor(input, lab, cv::COLOR_BGR2Lab);
-
-		stepTime = std::chrono::high_resolution_clock::now();
-		duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-		startTime = stepTime;
-
-		// 3. Extract L channel (brightness channel)
-		std::cout << "3. Starting L channel extraction..." << std::endl;
-		std::vector<cv::Mat> labChannels(3);
-		cv::split(lab, labChannels);
-		lChannel = labChannels[0].clone();	// L channel
-
-		stepTime = std::chrono::high_resolution_clock::now();
-		duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-		startTime = stepTime;
-
-		// 4. Apply median filter (noise reduction) - Python code uses 99
-		std::cout << "4. Starting median filter application (kernel size: 99)..." << std::endl;
-		cv::Mat medianL;
-		cv::medianBlur(lChannel, medianL, 99);
-
-		stepTime = std::chrono::high_resolution_clock::now();
-		duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-		startTime = stepTime;
-
-		// 5. Invert L channel
-		std::cout << "5. Starting L channel inversion..." << std::endl;
-		cv::Mat invertedL;
-		cv::bitwise_not(medianL, invertedL);
-
-		stepTime = std::chrono::high_resolution_clock::now();
-		duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-		startTime = stepTime;
-
-		// 6. Composite grayscale with inverted L channel (weights 0.75:0.25)
-		std::cout << "6. Starting image composition (gray:0.75, inverted:0.25)..." << std::endl;
-		cv::addWeighted(gray, 0.75, invertedL, 0.25, 0, composed);
-
-		stepTime = std::chrono::high_resolution_clock::now();
-		duration = std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - startTime);
-		std::cout << "   Completed! (Time taken: " << duration.count() << "ms)" << std::endl;
-
-		// Output image information and total processing time
-		auto totalDuration =
-				std::chrono::duration_cast<std::chrono::milliseconds>(stepTime - totalStartTime);
-		std::cout << "Output image size: " << composed.cols << "x" << composed.rows << std::endl;
-		std::cout << "Output image channels: " << composed.channels() << std::endl;
-		std::cout << "Complete preprocessing completed! (Total time: " << totalDuration.count() << "ms)"
-							<< std::endl;
-		std::cout << "----- Image Preprocessing Completed -----\n" << std::endl;
-
-		return true;
-	} catch (const cv::Exception& e) {
-		std::cerr << "OpenCV Error during preprocessing: " << e.what() << std::endl;
-		return false;
-	} catch (const std::exception& e) {
-		std::cerr << "Standard Error during preprocessing: " << e.what() << std::endl;
+	// Print input image information
+	std::cout << "Input image size: " << input.cols << "x" << input.rows << std::endl;
+	std::cout << "Input image channels: " << input.channels() << std::endl;
+
+	// Background estimate on a downscaled L channel, then fused gray/invert/blend pass
+	std::cout << "Starting illumination normalization (downscaled median background)..." << std::endl;
+	if (!normalizer.normalize(input, composed)) {
+		std::cerr << "Error during preprocessing" << std::endl;
 		return false;
 	}
 
-	return false;
+	// Estimated background lightness (full resolution) for display
+	lChannel = normalizer.getBackground();
+
+	auto endTime = std::chrono::high_resolution_clock::now();
+	auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+	// Output image information and total processing time
+	std::cout << "Output image size: " << composed.cols << "x" << composed.rows << std::endl;
+	std::cout << "Output image channels: " << composed.channels() << std::endl;
+	std::cout << "Complete preprocessing completed! (Total time: " << totalDuration.count() << "ms)"
+						<< std::endl;
+	std::cout << "----- Image Preprocessing Completed -----\n" << std::endl;
+
+	return true;
 }
 
 /**
@@ -332,7 +277,7 @@ int runEyeDetectionTest(int argc, char** argv) {
 		queueManager.saveEyeClosureStatus(eyesClosed);
 
 		cv::imshow("Original Image with Eye Status", displayFrame);
-		cv::imshow("L Channel", lChannel);
+		cv::imshow("Background Lightness", lChannel);
 		cv::imshow("Processed Image", processed);
 
 		// Wait for 1 second (terminate if ESC key is pressed)
@@ -345,9 +290,10 @@ int runEyeDetectionTest(int argc, char** argv) {
 
 	// Print eye closure history
 	std::cout << "\nEye Closure History: ";
-	std::deque<bool> history = queueManager.getEyeClosureHistory();
-	for (const auto& status : history) {
-		std::cout << (status ? "EYES CLOSED" : "EYES OPEN") << " ";
+	std::vector<EyeStateSample> history =
+			queueManager.getEyeClosureHistory(iterations * 1000 + 1000);
+	for (const auto& sample : history) {
+		std::cout << (sample.eyesClosed ? "EYES CLOSED" : "EYES OPEN") << " ";
 	}
 	std::cout << std::endl;
 